@@ -0,0 +1,54 @@
+#include "Assets/CustomAssetArena.h"
+
+FCustomAssetArena::FCustomAssetArena(SIZE_T InitialBytes)
+    : BlockSize(FMath::Max<SIZE_T>(InitialBytes, 256))
+{
+}
+
+FCustomAssetArena::~FCustomAssetArena()
+{
+    Reset();
+}
+
+void* FCustomAssetArena::Alloc(SIZE_T Size, uint32 Alignment)
+{
+    uint8* Aligned = Align(Cursor, Alignment);
+    if (!Cursor || Aligned + Size > End)
+    {
+        AddBlock(Size + Alignment);
+        Aligned = Align(Cursor, Alignment);
+    }
+
+    Cursor = Aligned + Size;
+    UsedBytes += Size;
+    return Aligned;
+}
+
+void FCustomAssetArena::AddBlock(SIZE_T MinBytes)
+{
+    // Later blocks double in size so a bundle that outgrows its estimate still needs few allocations
+    const SIZE_T Bytes = FMath::Max(BlockSize, MinBytes) + sizeof(FBlock);
+    FBlock* Block = static_cast<FBlock*>(FMemory::Malloc(Bytes));
+    Block->Next = Head;
+    Head = Block;
+
+    Cursor = reinterpret_cast<uint8*>(Block + 1);
+    End = reinterpret_cast<uint8*>(Block) + Bytes;
+    ReservedBytes += Bytes;
+    BlockSize *= 2;
+}
+
+void FCustomAssetArena::Reset()
+{
+    while (Head)
+    {
+        FBlock* Next = Head->Next;
+        FMemory::Free(Head);
+        Head = Next;
+    }
+
+    Cursor = nullptr;
+    End = nullptr;
+    ReservedBytes = 0;
+    UsedBytes = 0;
+}
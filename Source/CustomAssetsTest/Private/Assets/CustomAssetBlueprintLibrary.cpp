@@ -1,6 +1,7 @@
 #include "Assets/CustomAssetBlueprintLibrary.h"
 #include "Assets/CustomAssetManager.h"
 #include "Assets/CustomAssetMemoryTracker.h"
+#include "Assets/CustomAssetLLM.h"
 #include "Misc/Paths.h"
 
 UCustomAssetManager* UCustomAssetBlueprintLibrary::GetCustomAssetManager()
@@ -483,32 +484,28 @@ TArray<FName> UCustomAssetBlueprintLibrary::GetAbilitiesUnlockedAtLevel(UCustomC
 
 UStaticMesh* UCustomAssetBlueprintLibrary::GetItemLODMesh(UCustomItemAsset* ItemAsset, float Distance)
 {
+    LLM_SCOPE_BYTAG(CustomAssets_StreamedResources);
+    
     if (!ItemAsset)
     {
         return nullptr;
     }
     
-    if (ItemAsset->bUseLOD && Distance >= ItemAsset->LODSwitchDistance && ItemAsset->LowDetailMesh.LoadSynchronous())
-    {
-        return ItemAsset->LowDetailMesh.Get();
-    }
-    
-    return ItemAsset->ItemMesh.LoadSynchronous();
+    // The manager picks the variant from distance and the presentation memory budget
+    return Cast<UStaticMesh>(UCustomAssetManager::Get().ResolvePresentationMesh(ItemAsset, Distance));
 }
 
 USkeletalMesh* UCustomAssetBlueprintLibrary::GetCharacterLODMesh(UCustomCharacterAsset* CharacterAsset, float Distance)
 {
+    LLM_SCOPE_BYTAG(CustomAssets_StreamedResources);
+    
     if (!CharacterAsset)
     {
         return nullptr;
     }
     
-    if (CharacterAsset->bUseLOD && Distance >= CharacterAsset->LODSwitchDistance && CharacterAsset->LowDetailMesh.LoadSynchronous())
-    {
-        return CharacterAsset->LowDetailMesh.Get();
-    }
-    
-    return CharacterAsset->CharacterMesh.LoadSynchronous();
+    // The manager picks the variant from distance and the presentation memory budget
+    return Cast<USkeletalMesh>(UCustomAssetManager::Get().ResolvePresentationMesh(CharacterAsset, Distance));
 }
 
 // Asset Tags Functions
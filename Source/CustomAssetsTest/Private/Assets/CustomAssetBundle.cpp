@@ -1,5 +1,22 @@
 #include "Assets/CustomAssetBundle.h"
 #include "Assets/CustomAssetManager.h"
+#include "Assets/CustomAssetLLM.h"
+#include "UObject/UObjectArray.h"
+#include "UObject/GarbageCollection.h"
+#include "UObject/ObjectSaveContext.h"
+#include "UObject/UnrealType.h"
+#include "Engine/Engine.h"
+
+uint32 FCustomAssetBundleManifest::HashAssetIds(const TArray<FName>& AssetIds)
+{
+    uint32 Hash = 0;
+    for (const FName& AssetId : AssetIds)
+    {
+        // Hash the string so the result is stable across sessions and cooks
+        Hash = FCrc::StrCrc32(*AssetId.ToString().ToLower(), Hash);
+    }
+    return Hash;
+}
 
 UCustomAssetBundle::UCustomAssetBundle()
 {
@@ -7,6 +24,7 @@ UCustomAssetBundle::UCustomAssetBundle()
     Priority = 50;
     bPreloadAtStartup = false;
     bKeepInMemory = false;
+    bCreateGCCluster = false;
     
     // CRITICAL FIX: Explicitly initialize the AssetIds array to ensure it starts empty
     AssetIds.Empty();
@@ -26,197 +44,257 @@ void UCustomAssetBundle::AddAsset(const FName& AssetId)
         return;
     }
 
-    // Log the operation
-    UE_LOG(LogTemp, Warning, TEXT("[CRITICAL] AddAsset: Adding asset ID %s to bundle %s (DisplayName: %s)"), 
-        *AssetId.ToString(), *BundleId.ToString(), *DisplayName.ToString());
-    
-    // CRITICAL FIX: Make sure AssetIds is directly accessed to ensure property is marked as modified for serialization
-    if (AssetIds.Num() == 0)
+    const bool bOwnsBatch = !IsBatchEditing();
+    if (bOwnsBatch)
     {
-        UE_LOG(LogTemp, Warning, TEXT("[CRITICAL] AddAsset: AssetIds array was empty, initializing it"));
-        // Explicitly modify the property (this helps with serialization)
-        AssetIds = TArray<FName>();
+        BeginBatchEdit();
     }
-    
-    // Check if the asset ID is already in the bundle
-    if (!AssetIds.Contains(AssetId))
+
+    PendingBatchEdits.Emplace(AssetId, true);
+
+    if (bOwnsBatch)
     {
-        // Add the asset ID to the AssetIds array - directly modify the property
-        AssetIds.Add(AssetId);
-        UE_LOG(LogTemp, Warning, TEXT("[CRITICAL] AddAsset: Added asset ID %s to bundle's AssetIds array, now contains %d assets"), 
-            *AssetId.ToString(), AssetIds.Num());
-        
-        // CRITICAL: Mark the object as modified to ensure serialization
-        Modify();
-        
-        // Log all assets in the bundle for debugging
-        UE_LOG(LogTemp, Warning, TEXT("[CRITICAL] AddAsset: Bundle now contains the following assets:"));
-        for (const FName& Id : AssetIds)
-        {
-            UE_LOG(LogTemp, Warning, TEXT("      Asset ID: %s"), *Id.ToString());
-        }
-        
-        // If the asset is loaded, also add it to the Assets array
-        UCustomAssetManager& AssetManager = UCustomAssetManager::Get();
-        UCustomAssetBase* Asset = AssetManager.GetAssetById(AssetId);
-        if (Asset && !Assets.Contains(Asset))
-        {
-            Assets.Add(Asset);
-            UE_LOG(LogTemp, Warning, TEXT("[CRITICAL] AddAsset: Asset %s is loaded, also added to Assets array"), *AssetId.ToString());
-        }
-        else
-        {
-            UE_LOG(LogTemp, Warning, TEXT("[CRITICAL] AddAsset: Asset %s is not loaded or already in Assets array"), *AssetId.ToString());
-        }
+        CommitBatchEdit(false);
     }
-    else
+}
+
+void UCustomAssetBundle::RemoveAsset(const FName& AssetId)
+{
+    if (AssetId.IsNone())
     {
-        // Even if the ID is already in AssetIds, make sure it's also in the Assets array if loaded
-        UE_LOG(LogTemp, Warning, TEXT("[CRITICAL] AddAsset: Asset ID %s is already in AssetIds array"), *AssetId.ToString());
-        
-        UCustomAssetManager& AssetManager = UCustomAssetManager::Get();
-        UCustomAssetBase* Asset = AssetManager.GetAssetById(AssetId);
-        if (Asset && !Assets.Contains(Asset))
+        UE_LOG(LogTemp, Warning, TEXT("Cannot remove None asset ID from bundle %s"), *BundleId.ToString());
+        return;
+    }
+
+    const bool bOwnsBatch = !IsBatchEditing();
+    if (bOwnsBatch)
+    {
+        BeginBatchEdit();
+    }
+
+    PendingBatchEdits.Emplace(AssetId, false);
+
+    if (bOwnsBatch)
+    {
+        CommitBatchEdit(true);
+    }
+}
+
+bool UCustomAssetBundle::AddAssets(const TArray<FName>& AssetIdsToAdd, bool bSave)
+{
+    BeginBatchEdit();
+    for (const FName& AssetId : AssetIdsToAdd)
+    {
+        if (!AssetId.IsNone())
         {
-            Assets.Add(Asset);
-            UE_LOG(LogTemp, Warning, TEXT("[CRITICAL] AddAsset: Asset ID %s was already in bundle but asset was loaded, adding to Assets array"), *AssetId.ToString());
+            PendingBatchEdits.Emplace(AssetId, true);
         }
-        else
+    }
+    return CommitBatchEdit(bSave);
+}
+
+bool UCustomAssetBundle::RemoveAssets(const TArray<FName>& AssetIdsToRemove, bool bSave)
+{
+    BeginBatchEdit();
+    for (const FName& AssetId : AssetIdsToRemove)
+    {
+        if (!AssetId.IsNone())
         {
-            UE_LOG(LogTemp, Warning, TEXT("[CRITICAL] AddAsset: Asset ID %s is already in bundle %s"), *AssetId.ToString(), *BundleId.ToString());
+            PendingBatchEdits.Emplace(AssetId, false);
         }
     }
+    return CommitBatchEdit(bSave);
 }
 
-void UCustomAssetBundle::RemoveAsset(const FName& AssetId)
+void UCustomAssetBundle::BeginBatchEdit()
 {
-    if (AssetId.IsNone())
+    ++BatchEditDepth;
+}
+
+bool UCustomAssetBundle::CommitBatchEdit(bool bSave)
+{
+    if (BatchEditDepth == 0)
     {
-        UE_LOG(LogTemp, Warning, TEXT("[CRITICAL] RemoveAsset: Cannot remove None asset ID from bundle %s"), 
-            *BundleId.ToString());
-        return;
+        UE_LOG(LogTemp, Warning, TEXT("CommitBatchEdit called on bundle %s without a matching BeginBatchEdit"), *BundleId.ToString());
+        return false;
     }
-    
-    // Log the operation
-    UE_LOG(LogTemp, Warning, TEXT("[CRITICAL] RemoveAsset: Removing asset ID %s from bundle %s (DisplayName: %s)"), 
-        *AssetId.ToString(), *BundleId.ToString(), *DisplayName.ToString());
-    
-    // CRITICAL FIX: Mark the object as modified before making changes to ensure serialization
-    Modify();
-    
-    // Debug current state before removal
-    UE_LOG(LogTemp, Warning, TEXT("[CRITICAL] RemoveAsset: Before removal - AssetIds count: %d, Assets count: %d"), 
-        AssetIds.Num(), Assets.Num());
-    
-    // CRITICAL FIX: Verify the asset is actually in the bundle before removing
-    if (!AssetIds.Contains(AssetId))
+
+    bBatchSaveRequested |= bSave;
+    if (--BatchEditDepth > 0)
     {
-        UE_LOG(LogTemp, Warning, TEXT("[CRITICAL] RemoveAsset: Asset ID %s is not in this bundle's AssetIds array"), 
-            *AssetId.ToString());
-        
-        // Try to check if it might be in the Assets array instead
-        UCustomAssetManager& AssetManager = UCustomAssetManager::Get();
-        UCustomAssetBase* Asset = AssetManager.GetAssetById(AssetId);
-        if (Asset && Assets.Contains(Asset))
+        return true;
+    }
+
+    LLM_SCOPE_BYTAG(CustomAssets_Bundles);
+
+    const bool bShouldSave = bBatchSaveRequested;
+    bBatchSaveRequested = false;
+    TArray<TPair<FName, bool>> Edits = MoveTemp(PendingBatchEdits);
+    PendingBatchEdits.Reset();
+
+    // The last edit of an asset decides whether it ends up in the bundle
+    TMap<FName, bool> FinalEdits;
+    FinalEdits.Reserve(Edits.Num());
+    for (const TPair<FName, bool>& Edit : Edits)
+    {
+        FinalEdits.Add(Edit.Key, Edit.Value);
+    }
+
+    // Keep the call order of the first edit per asset so additions stay in the order they were made
+    TArray<FName> Added;
+    TArray<FName> Removed;
+    for (const TPair<FName, bool>& Edit : Edits)
+    {
+        bool bAdd = false;
+        if (!FinalEdits.RemoveAndCopyValue(Edit.Key, bAdd))
         {
-            UE_LOG(LogTemp, Warning, TEXT("[CRITICAL] RemoveAsset: Asset %s found in Assets array but not in AssetIds, removing it"), 
-                *AssetId.ToString());
-            Assets.Remove(Asset);
-            // No need to continue since the asset ID wasn't in AssetIds
-            return;
+            continue;
+        }
+
+        const bool bContained = ContainsAsset(Edit.Key);
+        if (bAdd && !bContained)
+        {
+            Added.Add(Edit.Key);
+        }
+        else if (!bAdd && bContained)
+        {
+            Removed.Add(Edit.Key);
         }
-        
-        UE_LOG(LogTemp, Warning, TEXT("[CRITICAL] RemoveAsset: Asset ID %s not found in either AssetIds or Assets arrays"), 
-            *AssetId.ToString());
-        return;
     }
-    
-    // Remove from AssetIds array with verification
-    int32 RemovedCount = AssetIds.Remove(AssetId);
-    
-    UE_LOG(LogTemp, Warning, TEXT("[CRITICAL] RemoveAsset: Removed %d instances of AssetId %s from AssetIds array"), 
-        RemovedCount, *AssetId.ToString());
-    
-    // Also remove from Assets array if it's loaded
-    UCustomAssetManager& AssetManager = UCustomAssetManager::Get();
-    UCustomAssetBase* Asset = AssetManager.GetAssetById(AssetId);
-    int32 RemovedAssetsCount = 0;
-    
-    if (Asset)
+
+    if (Added.Num() == 0 && Removed.Num() == 0)
     {
-        RemovedAssetsCount = Assets.Remove(Asset);
-        UE_LOG(LogTemp, Warning, TEXT("[CRITICAL] RemoveAsset: Removed %d instances of loaded Asset from Assets array"), 
-            RemovedAssetsCount);
+        return true;
     }
-    
-    // Debug current state after removal
-    UE_LOG(LogTemp, Warning, TEXT("[CRITICAL] RemoveAsset: After removal - AssetIds count: %d, Assets count: %d"), 
-        AssetIds.Num(), Assets.Num());
-    
-    if (RemovedCount > 0 || RemovedAssetsCount > 0)
+
+    // A cluster only knows the references it had when it was created
+    DissolveGCCluster();
+    Modify();
+
+    UCustomAssetManager& AssetManager = UCustomAssetManager::Get();
+
+    if (Removed.Num() > 0)
     {
-        UE_LOG(LogTemp, Warning, TEXT("[CRITICAL] RemoveAsset: Successfully removed asset ID %s from bundle %s"), 
-            *AssetId.ToString(), *BundleId.ToString());
-            
-        // CRITICAL FIX: Save the bundle after removing assets
-        Save();
+        const TSet<FName> RemovedSet(Removed);
+        AssetIds.RemoveAll([&RemovedSet](const FName& AssetId) { return RemovedSet.Contains(AssetId); });
+        Assets.RemoveAll([&RemovedSet](const UCustomAssetBase* Asset) { return IsValid(Asset) && RemovedSet.Contains(Asset->AssetId); });
     }
-    else
+
+    if (Added.Num() > 0)
     {
-        UE_LOG(LogTemp, Warning, TEXT("[CRITICAL] RemoveAsset: Asset ID %s was not found in bundle %s or failed to remove"), 
-            *AssetId.ToString(), *BundleId.ToString());
+        AssetIds.Append(Added);
+
+        // Loaded assets also go into the Assets array
+        TSet<UCustomAssetBase*> LoadedMembers(Assets);
+        for (const FName& AssetId : Added)
+        {
+            UCustomAssetBase* Asset = AssetManager.GetAssetById(AssetId);
+            if (Asset && !LoadedMembers.Contains(Asset))
+            {
+                Assets.Add(Asset);
+                LoadedMembers.Add(Asset);
+            }
+        }
     }
+
+    bAssetIdSetBuilt = false;
+    EnsureMembershipSet();
+    AssetManager.NotifyBundleAssetsChanged(this, Added, Removed);
+    MarkPackageDirty();
+
+    UE_LOG(LogTemp, Log, TEXT("Bundle %s: added %d and removed %d assets, now contains %d"),
+        *BundleId.ToString(), Added.Num(), Removed.Num(), AssetIds.Num());
+
+    return bShouldSave ? Save() : true;
+}
+
+void UCustomAssetBundle::CancelBatchEdit()
+{
+    BatchEditDepth = 0;
+    bBatchSaveRequested = false;
+    PendingBatchEdits.Reset();
 }
 
 bool UCustomAssetBundle::ContainsAsset(const FName& AssetId) const
 {
     if (AssetId.IsNone())
     {
-        UE_LOG(LogTemp, Warning, TEXT("[CRITICAL] ContainsAsset: Checking for 'None' AssetId in bundle %s, returning false"), 
-            *BundleId.ToString());
         return false;
     }
     
-    // Log the state of the arrays
-    UE_LOG(LogTemp, Verbose, TEXT("[CRITICAL] ContainsAsset: Checking if bundle %s contains asset %s (AssetIds: %d, Assets: %d)"), 
-        *BundleId.ToString(), *AssetId.ToString(), AssetIds.Num(), Assets.Num());
-    
-    // Always check the AssetIds array first - use direct Contains for better performance
-    if (AssetIds.Contains(AssetId))
-    {
-        UE_LOG(LogTemp, Verbose, TEXT("[CRITICAL] ContainsAsset: Bundle %s contains asset %s in AssetIds array"), 
-            *BundleId.ToString(), *AssetId.ToString());
-        return true;
-    }
-    
-    // For backward compatibility, also check the loaded Assets array
-    // Use a more efficient range-based for loop with a reference to avoid copying
+    EnsureMembershipSet();
+    return AssetIdSet.Contains(AssetId);
+}
+
+void UCustomAssetBundle::RebuildMembershipSet()
+{
+    // Recover loaded assets whose IDs never made it into AssetIds
     for (const UCustomAssetBase* Asset : Assets)
     {
-        if (IsValid(Asset) && Asset->AssetId == AssetId)
+        if (IsValid(Asset) && !Asset->AssetId.IsNone() && !AssetIds.Contains(Asset->AssetId))
         {
-            // CRITICAL FIX: If we find an asset in the Assets array but not in AssetIds, add it to AssetIds
-            UE_LOG(LogTemp, Warning, TEXT("[CRITICAL] ContainsAsset: Bundle %s contains asset %s in Assets array but not in AssetIds! Adding to AssetIds."), 
-                *BundleId.ToString(), *AssetId.ToString());
-                
-            // Need to cast away constness for this recovery feature
-            UCustomAssetBundle* MutableThis = const_cast<UCustomAssetBundle*>(this);
-            if (MutableThis)
-            {
-                MutableThis->AssetIds.AddUnique(AssetId);
-                UE_LOG(LogTemp, Warning, TEXT("[CRITICAL] ContainsAsset: Added missing asset ID %s to AssetIds array"), *AssetId.ToString());
-            }
-            
-            return true;
+            UE_LOG(LogTemp, Warning, TEXT("Bundle %s contains asset %s in Assets array but not in AssetIds, adding it"), 
+                *BundleId.ToString(), *Asset->AssetId.ToString());
+            AssetIds.Add(Asset->AssetId);
         }
     }
     
-    // If we got here, the asset is not in this bundle
-    UE_LOG(LogTemp, Verbose, TEXT("[CRITICAL] ContainsAsset: Bundle %s does NOT contain asset %s"), 
-        *BundleId.ToString(), *AssetId.ToString());
+    bAssetIdSetBuilt = false;
+    EnsureMembershipSet();
+}
+
+void UCustomAssetBundle::EnsureMembershipSet() const
+{
+    if (bAssetIdSetBuilt)
+    {
+        return;
+    }
     
-    return false;
+    AssetIdSet.Reset();
+    AssetIdSet.Append(AssetIds);
+    bAssetIdSetBuilt = true;
+}
+
+#if WITH_EDITOR
+void UCustomAssetBundle::PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent)
+{
+    Super::PostEditChangeProperty(PropertyChangedEvent);
+
+    if (PropertyChangedEvent.GetMemberPropertyName() == GET_MEMBER_NAME_CHECKED(UCustomAssetBundle, AssetIds))
+    {
+        SyncMembershipAfterDirectEdit();
+    }
+}
+
+void UCustomAssetBundle::PostEditUndo()
+{
+    Super::PostEditUndo();
+
+    SyncMembershipAfterDirectEdit();
+}
+
+void UCustomAssetBundle::SyncMembershipAfterDirectEdit()
+{
+    // The set still holds the membership from before the edit
+    EnsureMembershipSet();
+    const TSet<FName> PreviousAssetIds = AssetIdSet;
+
+    RebuildMembershipSet();
+
+    TArray<FName> Added = AssetIdSet.Difference(PreviousAssetIds).Array();
+    TArray<FName> Removed = PreviousAssetIds.Difference(AssetIdSet).Array();
+    Added.Remove(NAME_None);
+    if (Added.Num() == 0 && Removed.Num() == 0)
+    {
+        return;
+    }
+
+    if (UCustomAssetManager* AssetManager = GEngine ? Cast<UCustomAssetManager>(GEngine->AssetManager) : nullptr)
+    {
+        AssetManager->NotifyBundleAssetsChanged(this, Added, Removed);
+    }
 }
+#endif
 
 // Implementation of the Save method
 bool UCustomAssetBundle::Save()
@@ -244,6 +322,38 @@ bool UCustomAssetBundle::Save()
     return AssetManager.SaveBundle(this, TEXT("/Game/Bundles"));
 }
 
+uint32 UCustomAssetBundle::ComputeContentHash() const
+{
+    uint32 Hash = 0;
+    FString ValueText;
+    
+    for (TFieldIterator<FProperty> It(GetClass()); It; ++It)
+    {
+        const FProperty* Property = *It;
+        
+        // Derived and runtime state is not content
+        if (Property->HasAnyPropertyFlags(CPF_Transient)
+            || Property->GetFName() == GET_MEMBER_NAME_CHECKED(UCustomAssetBundle, SavedContentHash)
+            || Property->GetFName() == GET_MEMBER_NAME_CHECKED(UCustomAssetBundle, Manifest)
+            || Property->GetFName() == GET_MEMBER_NAME_CHECKED(UCustomAssetBundle, bIsLoaded))
+        {
+            continue;
+        }
+        
+        ValueText.Reset();
+        Property->ExportText_InContainer(0, ValueText, this, nullptr, nullptr, PPF_None);
+        Hash = FCrc::StrCrc32(*Property->GetName(), Hash);
+        Hash = FCrc::StrCrc32(*ValueText, Hash);
+    }
+    
+    return Hash;
+}
+
+bool UCustomAssetBundle::HasUnsavedChanges() const
+{
+    return SavedContentHash == 0 || !Manifest.IsUpToDate(AssetIds) || ComputeContentHash() != SavedContentHash;
+}
+
 void UCustomAssetBundle::DebugPrintContents(const FString& Context) const
 {
     FString ContextStr = Context.IsEmpty() ? TEXT("DebugPrintContents") : Context;
@@ -293,4 +403,75 @@ void UCustomAssetBundle::DebugPrintContents(const FString& Context) const
     
     // Log memory address for debugging references
     UE_LOG(LogTemp, Warning, TEXT("[CRITICAL] %s: Bundle memory address: 0x%p"), *ContextStr, this);
-} 
\ No newline at end of file
+}
+
+bool UCustomAssetBundle::CanBeClusterRoot() const
+{
+    return bClusterCreationRequested;
+}
+
+void UCustomAssetBundle::PreSave(FObjectPreSaveContext SaveContext)
+{
+    Super::PreSave(SaveContext);
+
+    if (HasAnyFlags(RF_ClassDefaultObject))
+    {
+        return;
+    }
+
+    // Only rebuild when the contents changed since the last build
+    if (Manifest.IsUpToDate(AssetIds))
+    {
+        return;
+    }
+
+    // Cooks and procedural saves must not load member assets, they build from what is already resident
+    UCustomAssetManager* AssetManager = GEngine ? Cast<UCustomAssetManager>(GEngine->AssetManager) : nullptr;
+    if (AssetManager)
+    {
+        const bool bLoadMissingAssets = !SaveContext.IsCooking() && !SaveContext.IsProceduralSave();
+        AssetManager->RefreshBundleManifest(this, bLoadMissingAssets);
+    }
+}
+
+void UCustomAssetBundle::PostLoad()
+{
+    Super::PostLoad();
+
+    RebuildMembershipSet();
+}
+
+bool UCustomAssetBundle::CreateGCCluster(const TArray<UCustomAssetBase*>& LoadedMembers, bool bForce)
+{
+    // Clusters are a runtime GC optimization; the editor keeps mutating bundle contents
+    if ((!bCreateGCCluster && !bForce) || !GCreateGCClusters || GIsEditor || IsGCClusterRoot())
+    {
+        return false;
+    }
+
+    // The cluster captures the root's references at creation time, so the member list must be complete first
+    Assets = LoadedMembers;
+
+    TGuardValue<bool> CreationGuard(bClusterCreationRequested, true);
+    CreateCluster();
+
+    UE_LOG(LogTemp, Log, TEXT("Bundle %s %s a GC cluster with %d assets"), *BundleId.ToString(),
+        IsGCClusterRoot() ? TEXT("formed") : TEXT("failed to form"), Assets.Num());
+
+    return IsGCClusterRoot();
+}
+
+void UCustomAssetBundle::DissolveGCCluster()
+{
+    if (IsGCClusterRoot())
+    {
+        GUObjectClusters.DissolveCluster(this);
+        UE_LOG(LogTemp, Log, TEXT("Dissolved GC cluster of bundle %s"), *BundleId.ToString());
+    }
+}
+
+bool UCustomAssetBundle::IsGCClusterRoot() const
+{
+    const FUObjectItem* ObjectItem = GUObjectArray.ObjectToObjectItem(this);
+    return ObjectItem && ObjectItem->HasAnyFlags(EInternalObjectFlags::ClusterRoot);
+}
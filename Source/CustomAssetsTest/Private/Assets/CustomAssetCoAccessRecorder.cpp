@@ -0,0 +1,213 @@
+#include "Assets/CustomAssetCoAccessRecorder.h"
+#include "Assets/CustomAssetManager.h"
+#include "Assets/CustomAssetLLM.h"
+#include "Engine/Engine.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+#include "Dom/JsonObject.h"
+
+void UCustomAssetCoAccessRecorder::RecordAccess(const FName& AssetId, const FName& LevelName)
+{
+    LLM_SCOPE_BYTAG(CustomAssets_Manager);
+
+    if (AssetId.IsNone())
+    {
+        return;
+    }
+
+    // Accesses in different levels are never paired
+    if (LevelName != RecentLevel)
+    {
+        RecentAccesses.Reset();
+        RecentLevel = LevelName;
+    }
+
+    // Drop accesses that fell out of the window
+    const double Now = FPlatformTime::Seconds();
+    int32 NumExpired = 0;
+    while (NumExpired < RecentAccesses.Num() && Now - RecentAccesses[NumExpired].Value > WindowSeconds)
+    {
+        ++NumExpired;
+    }
+    RecentAccesses.RemoveAt(0, NumExpired, EAllowShrinking::No);
+
+    // Repeated requests inside the window add no new co-access
+    if (RecentAccesses.ContainsByPredicate([&AssetId](const TPair<FName, double>& Access) { return Access.Key == AssetId; }))
+    {
+        return;
+    }
+
+    FAssetCoAccessLevelStats& Stats = LevelStats.FindOrAdd(LevelName);
+    Stats.AccessCounts.FindOrAdd(AssetId)++;
+
+    for (const TPair<FName, double>& Access : RecentAccesses)
+    {
+        const bool bIsLower = AssetId.Compare(Access.Key) < 0;
+        Stats.PairCounts.FindOrAdd(bIsLower ? MakeTuple(AssetId, Access.Key) : MakeTuple(Access.Key, AssetId))++;
+    }
+
+    RecentAccesses.Emplace(AssetId, Now);
+    if (RecentAccesses.Num() > MaxWindowEntries)
+    {
+        RecentAccesses.RemoveAt(0);
+    }
+
+    ++RecordedAccessCount;
+}
+
+void UCustomAssetCoAccessRecorder::Reset()
+{
+    LevelStats.Empty();
+    RecentAccesses.Empty();
+    RecentLevel = NAME_None;
+    RecordedAccessCount = 0;
+}
+
+bool UCustomAssetCoAccessRecorder::SaveTrace(const FString& FilePath) const
+{
+    TSharedRef<FJsonObject> Root = MakeShared<FJsonObject>();
+    Root->SetNumberField(TEXT("Version"), 1);
+    Root->SetNumberField(TEXT("WindowSeconds"), WindowSeconds);
+    Root->SetNumberField(TEXT("RecordedAccesses"), RecordedAccessCount);
+
+    TArray<TSharedPtr<FJsonValue>> LevelValues;
+    for (const auto& LevelPair : LevelStats)
+    {
+        TSharedRef<FJsonObject> LevelObject = MakeShared<FJsonObject>();
+        LevelObject->SetStringField(TEXT("Level"), LevelPair.Key.ToString());
+
+        TArray<TSharedPtr<FJsonValue>> AssetValues;
+        for (const auto& AssetPair : LevelPair.Value.AccessCounts)
+        {
+            TSharedRef<FJsonObject> AssetObject = MakeShared<FJsonObject>();
+            AssetObject->SetStringField(TEXT("Id"), AssetPair.Key.ToString());
+            AssetObject->SetNumberField(TEXT("Count"), AssetPair.Value);
+            AssetValues.Add(MakeShared<FJsonValueObject>(AssetObject));
+        }
+        LevelObject->SetArrayField(TEXT("Assets"), AssetValues);
+
+        TArray<TSharedPtr<FJsonValue>> PairValues;
+        for (const auto& CoAccessPair : LevelPair.Value.PairCounts)
+        {
+            TSharedRef<FJsonObject> PairObject = MakeShared<FJsonObject>();
+            PairObject->SetStringField(TEXT("A"), CoAccessPair.Key.Key.ToString());
+            PairObject->SetStringField(TEXT("B"), CoAccessPair.Key.Value.ToString());
+            PairObject->SetNumberField(TEXT("Count"), CoAccessPair.Value);
+            PairValues.Add(MakeShared<FJsonValueObject>(PairObject));
+        }
+        LevelObject->SetArrayField(TEXT("Pairs"), PairValues);
+
+        LevelValues.Add(MakeShared<FJsonValueObject>(LevelObject));
+    }
+    Root->SetArrayField(TEXT("Levels"), LevelValues);
+
+    FString Output;
+    TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&Output);
+    if (!FJsonSerializer::Serialize(Root, Writer) || !FFileHelper::SaveStringToFile(Output, *FilePath))
+    {
+        UE_LOG(LogTemp, Error, TEXT("Failed to write co-access trace to %s"), *FilePath);
+        return false;
+    }
+
+    UE_LOG(LogTemp, Log, TEXT("Wrote co-access trace for %d levels to %s"), LevelStats.Num(), *FilePath);
+    return true;
+}
+
+bool UCustomAssetCoAccessRecorder::LoadTrace(const FString& FilePath)
+{
+    FString Input;
+    if (!FFileHelper::LoadFileToString(Input, *FilePath))
+    {
+        UE_LOG(LogTemp, Warning, TEXT("Co-access trace %s not found"), *FilePath);
+        return false;
+    }
+
+    TSharedPtr<FJsonObject> Root;
+    TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(Input);
+    if (!FJsonSerializer::Deserialize(Reader, Root) || !Root.IsValid())
+    {
+        UE_LOG(LogTemp, Error, TEXT("Co-access trace %s is not valid JSON"), *FilePath);
+        return false;
+    }
+
+    RecordedAccessCount += static_cast<int32>(Root->GetNumberField(TEXT("RecordedAccesses")));
+
+    const TArray<TSharedPtr<FJsonValue>>* LevelValues = nullptr;
+    if (!Root->TryGetArrayField(TEXT("Levels"), LevelValues))
+    {
+        return true;
+    }
+
+    // Traces from several sessions add up
+    for (const TSharedPtr<FJsonValue>& LevelValue : *LevelValues)
+    {
+        const TSharedPtr<FJsonObject> LevelObject = LevelValue->AsObject();
+        if (!LevelObject.IsValid())
+        {
+            continue;
+        }
+
+        FAssetCoAccessLevelStats& Stats = LevelStats.FindOrAdd(FName(*LevelObject->GetStringField(TEXT("Level"))));
+
+        const TArray<TSharedPtr<FJsonValue>>* AssetValues = nullptr;
+        if (LevelObject->TryGetArrayField(TEXT("Assets"), AssetValues))
+        {
+            for (const TSharedPtr<FJsonValue>& AssetValue : *AssetValues)
+            {
+                const TSharedPtr<FJsonObject> AssetObject = AssetValue->AsObject();
+                if (AssetObject.IsValid())
+                {
+                    Stats.AccessCounts.FindOrAdd(FName(*AssetObject->GetStringField(TEXT("Id")))) += static_cast<int32>(AssetObject->GetNumberField(TEXT("Count")));
+                }
+            }
+        }
+
+        const TArray<TSharedPtr<FJsonValue>>* PairValues = nullptr;
+        if (LevelObject->TryGetArrayField(TEXT("Pairs"), PairValues))
+        {
+            for (const TSharedPtr<FJsonValue>& PairValue : *PairValues)
+            {
+                const TSharedPtr<FJsonObject> PairObject = PairValue->AsObject();
+                if (!PairObject.IsValid())
+                {
+                    continue;
+                }
+
+                const FName A(*PairObject->GetStringField(TEXT("A")));
+                const FName B(*PairObject->GetStringField(TEXT("B")));
+                const bool bIsLower = A.Compare(B) < 0;
+                Stats.PairCounts.FindOrAdd(bIsLower ? MakeTuple(A, B) : MakeTuple(B, A)) += static_cast<int32>(PairObject->GetNumberField(TEXT("Count")));
+            }
+        }
+    }
+
+    return true;
+}
+
+FString UCustomAssetCoAccessRecorder::GetDefaultTracePath()
+{
+    return FPaths::ProjectSavedDir() / TEXT("CustomAssets") / TEXT("CoAccessTrace.json");
+}
+
+//=================================================================
+// CONSOLE COMMAND
+//=================================================================
+
+static FAutoConsoleCommand GSaveCoAccessTraceCommand(
+    TEXT("CustomAssets.SaveCoAccessTrace"),
+    TEXT("Write the co-access statistics recorded by the custom asset manager to a JSON trace (default Saved/CustomAssets/CoAccessTrace.json)."),
+    FConsoleCommandWithArgsDelegate::CreateLambda([](const TArray<FString>& Args)
+    {
+        UCustomAssetManager* Manager = GEngine ? Cast<UCustomAssetManager>(GEngine->AssetManager) : nullptr;
+        if (!Manager)
+        {
+            UE_LOG(LogTemp, Warning, TEXT("CustomAssets.SaveCoAccessTrace: custom asset manager is not active"));
+            return;
+        }
+
+        Manager->SaveCoAccessTrace(Args.Num() > 0 ? Args[0] : FString());
+    })
+);
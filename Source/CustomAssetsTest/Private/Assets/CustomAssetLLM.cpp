@@ -0,0 +1,8 @@
+#include "Assets/CustomAssetLLM.h"
+
+LLM_DEFINE_TAG(CustomAssets);
+LLM_DEFINE_TAG(CustomAssets_Manager);
+LLM_DEFINE_TAG(CustomAssets_MemoryTracker);
+LLM_DEFINE_TAG(CustomAssets_Bundles);
+LLM_DEFINE_TAG(CustomAssets_LoadedAssets);
+LLM_DEFINE_TAG(CustomAssets_StreamedResources);
@@ -0,0 +1,236 @@
+#include "Assets/CustomAssetLevelTransitionModel.h"
+#include "Assets/CustomAssetManager.h"
+#include "Assets/CustomAssetLLM.h"
+#include "Engine/Engine.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+#include "Dom/JsonObject.h"
+
+void UCustomAssetLevelTransitionModel::RecordTransition(const FName& FromLevel, const FName& ToLevel, double SecondsInFromLevel)
+{
+    LLM_SCOPE_BYTAG(CustomAssets_Manager);
+
+    if (FromLevel.IsNone() || ToLevel.IsNone() || FromLevel == ToLevel)
+    {
+        return;
+    }
+
+    FLevelTransitionStats& Stats = Transitions.FindOrAdd(FromLevel).FindOrAdd(ToLevel);
+    ++Stats.Count;
+    Stats.TotalSeconds += FMath::Max(SecondsInFromLevel, 0.0);
+
+    DepartureCounts.FindOrAdd(FromLevel)++;
+    ++SessionTransitionCount;
+}
+
+TArray<TPair<FName, float>> UCustomAssetLevelTransitionModel::PredictNextLevels(const FName& FromLevel, int32 MaxLevels, float MinProbability) const
+{
+    TArray<TPair<FName, float>> Predictions;
+
+    const TMap<FName, FLevelTransitionStats>* Destinations = Transitions.Find(FromLevel);
+    const int32* DepartureCount = DepartureCounts.Find(FromLevel);
+    if (!Destinations || !DepartureCount || *DepartureCount <= 0 || MaxLevels <= 0)
+    {
+        return Predictions;
+    }
+
+    for (const auto& Pair : *Destinations)
+    {
+        const float Probability = static_cast<float>(Pair.Value.Count) / *DepartureCount;
+        if (Probability >= MinProbability)
+        {
+            Predictions.Emplace(Pair.Key, Probability);
+        }
+    }
+
+    // Equally likely levels that usually come sooner go first
+    Predictions.Sort([Destinations](const TPair<FName, float>& A, const TPair<FName, float>& B)
+    {
+        if (A.Value != B.Value)
+        {
+            return A.Value > B.Value;
+        }
+
+        const FLevelTransitionStats& StatsA = Destinations->FindChecked(A.Key);
+        const FLevelTransitionStats& StatsB = Destinations->FindChecked(B.Key);
+        return StatsA.TotalSeconds / StatsA.Count < StatsB.TotalSeconds / StatsB.Count;
+    });
+
+    if (Predictions.Num() > MaxLevels)
+    {
+        Predictions.SetNum(MaxLevels);
+    }
+
+    return Predictions;
+}
+
+float UCustomAssetLevelTransitionModel::GetTransitionProbability(FName FromLevel, FName ToLevel) const
+{
+    const TMap<FName, FLevelTransitionStats>* Destinations = Transitions.Find(FromLevel);
+    const FLevelTransitionStats* Stats = Destinations ? Destinations->Find(ToLevel) : nullptr;
+    const int32* DepartureCount = DepartureCounts.Find(FromLevel);
+    if (!Stats || !DepartureCount || *DepartureCount <= 0)
+    {
+        return 0.0f;
+    }
+
+    return static_cast<float>(Stats->Count) / *DepartureCount;
+}
+
+float UCustomAssetLevelTransitionModel::GetExpectedTransitionSeconds(FName FromLevel, FName ToLevel) const
+{
+    const TMap<FName, FLevelTransitionStats>* Destinations = Transitions.Find(FromLevel);
+    const FLevelTransitionStats* Stats = Destinations ? Destinations->Find(ToLevel) : nullptr;
+    if (!Stats || Stats->Count <= 0)
+    {
+        return 0.0f;
+    }
+
+    return static_cast<float>(Stats->TotalSeconds / Stats->Count);
+}
+
+void UCustomAssetLevelTransitionModel::RecordPredictionOutcome(bool bHit)
+{
+    if (bHit)
+    {
+        ++PredictionHits;
+    }
+    else
+    {
+        ++PredictionMisses;
+    }
+}
+
+float UCustomAssetLevelTransitionModel::GetPredictionHitRate() const
+{
+    const int32 PredictionCount = GetPredictionCount();
+    return PredictionCount > 0 ? static_cast<float>(PredictionHits) / PredictionCount : 0.0f;
+}
+
+void UCustomAssetLevelTransitionModel::Reset()
+{
+    Transitions.Empty();
+    DepartureCounts.Empty();
+    PredictionHits = 0;
+    PredictionMisses = 0;
+    SessionTransitionCount = 0;
+}
+
+bool UCustomAssetLevelTransitionModel::SaveModel(const FString& FilePath) const
+{
+    TSharedRef<FJsonObject> Root = MakeShared<FJsonObject>();
+    Root->SetNumberField(TEXT("Version"), 1);
+    Root->SetNumberField(TEXT("PredictionHits"), PredictionHits);
+    Root->SetNumberField(TEXT("PredictionMisses"), PredictionMisses);
+
+    TArray<TSharedPtr<FJsonValue>> TransitionValues;
+    for (const auto& FromPair : Transitions)
+    {
+        for (const auto& ToPair : FromPair.Value)
+        {
+            TSharedRef<FJsonObject> TransitionObject = MakeShared<FJsonObject>();
+            TransitionObject->SetStringField(TEXT("From"), FromPair.Key.ToString());
+            TransitionObject->SetStringField(TEXT("To"), ToPair.Key.ToString());
+            TransitionObject->SetNumberField(TEXT("Count"), ToPair.Value.Count);
+            TransitionObject->SetNumberField(TEXT("TotalSeconds"), ToPair.Value.TotalSeconds);
+            TransitionValues.Add(MakeShared<FJsonValueObject>(TransitionObject));
+        }
+    }
+    Root->SetArrayField(TEXT("Transitions"), TransitionValues);
+
+    FString Output;
+    TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&Output);
+    if (!FJsonSerializer::Serialize(Root, Writer) || !FFileHelper::SaveStringToFile(Output, *FilePath))
+    {
+        UE_LOG(LogTemp, Error, TEXT("Failed to write level transition model to %s"), *FilePath);
+        return false;
+    }
+
+    UE_LOG(LogTemp, Log, TEXT("Wrote level transition model with %d transitions to %s"), TransitionValues.Num(), *FilePath);
+    return true;
+}
+
+bool UCustomAssetLevelTransitionModel::LoadModel(const FString& FilePath)
+{
+    FString Input;
+    if (!FFileHelper::LoadFileToString(Input, *FilePath))
+    {
+        // Nothing has been learned yet on a first run
+        UE_LOG(LogTemp, Log, TEXT("Level transition model %s not found"), *FilePath);
+        return false;
+    }
+
+    TSharedPtr<FJsonObject> Root;
+    TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(Input);
+    if (!FJsonSerializer::Deserialize(Reader, Root) || !Root.IsValid())
+    {
+        UE_LOG(LogTemp, Error, TEXT("Level transition model %s is not valid JSON"), *FilePath);
+        return false;
+    }
+
+    PredictionHits += static_cast<int32>(Root->GetNumberField(TEXT("PredictionHits")));
+    PredictionMisses += static_cast<int32>(Root->GetNumberField(TEXT("PredictionMisses")));
+
+    const TArray<TSharedPtr<FJsonValue>>* TransitionValues = nullptr;
+    if (!Root->TryGetArrayField(TEXT("Transitions"), TransitionValues))
+    {
+        return true;
+    }
+
+    // Models from several sessions add up
+    for (const TSharedPtr<FJsonValue>& TransitionValue : *TransitionValues)
+    {
+        const TSharedPtr<FJsonObject> TransitionObject = TransitionValue->AsObject();
+        if (!TransitionObject.IsValid())
+        {
+            continue;
+        }
+
+        const FName FromLevel(*TransitionObject->GetStringField(TEXT("From")));
+        const FName ToLevel(*TransitionObject->GetStringField(TEXT("To")));
+        const int32 Count = static_cast<int32>(TransitionObject->GetNumberField(TEXT("Count")));
+        if (FromLevel.IsNone() || ToLevel.IsNone() || Count <= 0)
+        {
+            continue;
+        }
+
+        FLevelTransitionStats& Stats = Transitions.FindOrAdd(FromLevel).FindOrAdd(ToLevel);
+        Stats.Count += Count;
+        Stats.TotalSeconds += TransitionObject->GetNumberField(TEXT("TotalSeconds"));
+        DepartureCounts.FindOrAdd(FromLevel) += Count;
+    }
+
+    return true;
+}
+
+FString UCustomAssetLevelTransitionModel::GetDefaultModelPath()
+{
+    return FPaths::ProjectSavedDir() / TEXT("CustomAssets") / TEXT("LevelTransitions.json");
+}
+
+//=================================================================
+// CONSOLE COMMAND
+//=================================================================
+
+static FAutoConsoleCommand GLevelTransitionsCommand(
+    TEXT("CustomAssets.LevelTransitions"),
+    TEXT("Log the hit rate of level transition predictions and save the transition model (default Saved/CustomAssets/LevelTransitions.json)."),
+    FConsoleCommandWithArgsDelegate::CreateLambda([](const TArray<FString>& Args)
+    {
+        UCustomAssetManager* Manager = GEngine ? Cast<UCustomAssetManager>(GEngine->AssetManager) : nullptr;
+        const UCustomAssetLevelTransitionModel* Model = Manager ? Manager->GetLevelTransitionModel() : nullptr;
+        if (!Model)
+        {
+            UE_LOG(LogTemp, Warning, TEXT("CustomAssets.LevelTransitions: custom asset manager is not active"));
+            return;
+        }
+
+        UE_LOG(LogTemp, Log, TEXT("Level transition predictions: %.1f%% hit rate over %d predictions, %d transitions recorded this session"),
+            Model->GetPredictionHitRate() * 100.0f, Model->GetPredictionCount(), Model->GetSessionTransitionCount());
+
+        Manager->SaveLevelTransitionModel(Args.Num() > 0 ? Args[0] : FString());
+    })
+);
@@ -2,14 +2,28 @@
 #include "Assets/CustomAssetBase.h"
 #include "Assets/CustomAssetBundle.h"
 #include "Assets/CustomAssetMemoryTracker.h"
+#include "Assets/CustomAssetLLM.h"
+#include "Assets/CustomItemAsset.h"
+#include "Assets/CustomCharacterAsset.h"
 #include "AssetRegistry/AssetRegistryModule.h"
 #include "Misc/FileHelper.h"
+#include "Misc/CoreDelegates.h"
 #include "HAL/PlatformFileManager.h"
 #include "Misc/Paths.h"
 #include "Engine/StreamableManager.h"
+#include "Engine/World.h"
+#include "Engine/Level.h"
+#include "Engine/LevelStreaming.h"
+#include "WorldPartition/WorldPartition.h"
+#include "WorldPartition/WorldPartitionSubsystem.h"
+#include "WorldPartition/WorldPartitionRuntimeHash.h"
+#include "WorldPartition/WorldPartitionRuntimeCell.h"
 #include "UObject/Package.h"
 #include "UObject/SavePackage.h"
+#include "Misc/PackageName.h"
 #include "Algo/Reverse.h"
+#include "Algo/BinarySearch.h"
+#include "UObject/UObjectArray.h"
 #if WITH_EDITOR
 #include "ObjectTools.h"
 #include "AssetRegistry/AssetRegistryModule.h"
@@ -17,6 +31,8 @@
 
 UCustomAssetManager::UCustomAssetManager()
 {
+    LLM_SCOPE_BYTAG(CustomAssets_Manager);
+    
     // Initialize default values
     DefaultLoadingStrategy = EAssetLoadingStrategy::OnDemand;
     MemoryPolicy = EMemoryManagementPolicy::KeepAll;
@@ -25,6 +41,11 @@ UCustomAssetManager::UCustomAssetManager()
     // Create the memory tracker
     MemoryTracker = NewObject<UCustomAssetMemoryTracker>();
     MemoryTracker->AddToRoot(); // Prevent garbage collection
+    
+    // Create the residency auditor
+    ResidencyAuditor = CreateDefaultSubobject<UCustomAssetResidencyAuditor>(TEXT("ResidencyAuditor"));
+    CoAccessRecorder = CreateDefaultSubobject<UCustomAssetCoAccessRecorder>(TEXT("CoAccessRecorder"));
+    LevelTransitionModel = CreateDefaultSubobject<UCustomAssetLevelTransitionModel>(TEXT("LevelTransitionModel"));
 }
 
 UCustomAssetManager& UCustomAssetManager::Get()
@@ -36,6 +57,8 @@ UCustomAssetManager& UCustomAssetManager::Get()
 
 void UCustomAssetManager::StartInitialLoading()
 {
+    LLM_SCOPE_BYTAG(CustomAssets_Manager);
+    
     Super::StartInitialLoading();
 
     // Scan for assets when the asset manager initializes
@@ -47,8 +70,56 @@ void UCustomAssetManager::StartInitialLoading()
     // Update dependencies between assets
     UpdateDependencies();
     
+    // Config values are loaded by now
+    if (CoAccessRecorder)
+    {
+        CoAccessRecorder->WindowSeconds = CoAccessWindowSeconds;
+    }
+    
+    // Pick up the level transitions learned in earlier sessions and write them back before shutdown,
+    // while file IO is still safe (BeginDestroy may run on the GC path)
+    if (bPredictLevelTransitions && LevelTransitionModel)
+    {
+        LevelTransitionModel->LoadModel(UCustomAssetLevelTransitionModel::GetDefaultModelPath());
+        FCoreDelegates::OnPreExit.AddUObject(this, &UCustomAssetManager::HandlePreExit);
+    }
+    
     // Preload bundles marked for preloading
     PreloadBundles();
+    
+    // Drive periodic work (reachability collection) from the core ticker
+    if (!TickHandle.IsValid())
+    {
+        TickHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateUObject(this, &UCustomAssetManager::Tick));
+    }
+    
+    // Level bounds are cached as levels stream in and dropped as they stream out
+    FWorldDelegates::LevelAddedToWorld.AddUObject(this, &UCustomAssetManager::HandleLevelAddedToWorld);
+    FWorldDelegates::LevelRemovedFromWorld.AddUObject(this, &UCustomAssetManager::HandleLevelRemovedFromWorld);
+}
+
+void UCustomAssetManager::BeginDestroy()
+{
+    if (TickHandle.IsValid())
+    {
+        FTSTicker::GetCoreTicker().RemoveTicker(TickHandle);
+        TickHandle.Reset();
+    }
+    
+    FWorldDelegates::LevelAddedToWorld.RemoveAll(this);
+    FWorldDelegates::LevelRemovedFromWorld.RemoveAll(this);
+    FCoreDelegates::OnPreExit.RemoveAll(this);
+    TrackLevelBounds(nullptr);
+    
+    Super::BeginDestroy();
+}
+
+void UCustomAssetManager::HandlePreExit()
+{
+    if (LevelTransitionModel && LevelTransitionModel->GetSessionTransitionCount() > 0)
+    {
+        SaveLevelTransitionModel();
+    }
 }
 
 UCustomAssetBase* UCustomAssetManager::LoadAssetById(const FName& AssetId)
@@ -59,6 +130,21 @@ UCustomAssetBase* UCustomAssetManager::LoadAssetById(const FName& AssetId)
 
 UCustomAssetBase* UCustomAssetManager::LoadAssetByIdWithStrategy(const FName& AssetId, EAssetLoadingStrategy Strategy)
 {
+    LLM_SCOPE_BYTAG(CustomAssets_LoadedAssets);
+    
+    // Loads requested directly by callers keep the asset reachable until it is explicitly unloaded
+    if (InternalLoadDepth == 0)
+    {
+        DirectLoadRoots.Add(AssetId);
+        PrefetchedAssets.Remove(AssetId);
+        
+        // Direct requests are the demand signal bundle recommendations are mined from
+        if (bRecordCoAccess && CoAccessRecorder)
+        {
+            CoAccessRecorder->RecordAccess(AssetId, GetActiveLevelName());
+        }
+    }
+    
     // Check if the asset is already loaded - use direct lookup for better performance
     UCustomAssetBase* LoadedAsset = GetAssetById(AssetId);
     if (::IsValid(LoadedAsset))
@@ -82,6 +168,9 @@ UCustomAssetBase* UCustomAssetManager::LoadAssetByIdWithStrategy(const FName& As
 
     UCustomAssetBase* Asset = nullptr;
 
+    // Attribute memory loaded by this request (and its dependencies) to the asset
+    FScopedAssetLoadContext LoadContext(MemoryTracker, AssetId, NAME_None, TEXT("LoadAssetById"));
+
     // Apply the loading strategy
     switch (Strategy)
     {
@@ -102,6 +191,11 @@ UCustomAssetBase* UCustomAssetManager::LoadAssetByIdWithStrategy(const FName& As
             *AssetPath,
             FStreamableDelegate::CreateUObject(this, &UCustomAssetManager::OnAssetLoaded, AssetId, *AssetPath)
         );
+        
+        if (bBundleAffinityPrefetch && InternalLoadDepth == 0)
+        {
+            ScheduleBundleAffinityPrefetch(AssetId);
+        }
         return nullptr;
 
     case EAssetLoadingStrategy::LazyLoad:
@@ -124,6 +218,12 @@ UCustomAssetBase* UCustomAssetManager::LoadAssetByIdWithStrategy(const FName& As
         
         // Manage memory usage
         ManageMemoryUsage();
+        
+        // Bundle siblings of a cold miss are usually needed next
+        if (bBundleAffinityPrefetch && InternalLoadDepth == 0)
+        {
+            ScheduleBundleAffinityPrefetch(AssetId);
+        }
     }
     else
     {
@@ -135,6 +235,14 @@ UCustomAssetBase* UCustomAssetManager::LoadAssetByIdWithStrategy(const FName& As
 
 void UCustomAssetManager::PreloadAssets(const TArray<FName>& AssetIds)
 {
+    LLM_SCOPE_BYTAG(CustomAssets_LoadedAssets);
+    
+    // Preloaded assets are roots when the caller asked for them directly
+    if (InternalLoadDepth == 0)
+    {
+        DirectLoadRoots.Append(AssetIds);
+    }
+    
     // Create an array of asset paths to preload
     TArray<FSoftObjectPath> AssetPaths;
     
@@ -157,9 +265,11 @@ void UCustomAssetManager::PreloadAssets(const TArray<FName>& AssetIds)
         FStreamableManager& LocalStreamableManager = UAssetManager::GetStreamableManager();
         LocalStreamableManager.RequestSyncLoad(AssetPaths);
 
-        // Register all loaded assets
+        // Register all loaded assets; memory is tracked at registration, so each asset is attributed to itself
         for (const FName& AssetId : AssetIds)
         {
+            FScopedAssetLoadContext LoadContext(MemoryTracker, AssetId, NAME_None, TEXT("PreloadAssets"));
+            
             FSoftObjectPath* AssetPath = AssetPathMap.Find(AssetId);
             if (AssetPath && AssetPath->IsValid())
             {
@@ -181,6 +291,8 @@ void UCustomAssetManager::PreloadAssets(const TArray<FName>& AssetIds)
 
 void UCustomAssetManager::StreamAsset(const FName& AssetId, const FOnAssetLoaded& CompletionCallback)
 {
+    LLM_SCOPE_BYTAG(CustomAssets_LoadedAssets);
+    
     // Check if we have a path for this asset ID
     FSoftObjectPath* AssetPath = AssetPathMap.Find(AssetId);
     if (!AssetPath)
@@ -189,6 +301,12 @@ void UCustomAssetManager::StreamAsset(const FName& AssetId, const FOnAssetLoaded
         return;
     }
 
+    // Streamed assets are roots when the caller asked for them directly
+    if (InternalLoadDepth == 0)
+    {
+        DirectLoadRoots.Add(AssetId);
+    }
+    
     // Store the completion callback for later use
     PendingCallbacks.Add(AssetId, CompletionCallback);
     
@@ -205,12 +323,16 @@ void UCustomAssetManager::StreamAsset(const FName& AssetId, const FOnAssetLoaded
 // Helper function to handle streamed asset completion
 void UCustomAssetManager::OnAssetStreamed(FName AssetId)
 {
+    LLM_SCOPE_BYTAG(CustomAssets_LoadedAssets);
+    
     FSoftObjectPath* AssetPath = AssetPathMap.Find(AssetId);
     if (AssetPath && AssetPath->IsValid())
     {
         UCustomAssetBase* Asset = Cast<UCustomAssetBase>(AssetPath->ResolveObject());
         if (Asset)
         {
+            FScopedAssetLoadContext LoadContext(MemoryTracker, AssetId, NAME_None, TEXT("StreamAsset"));
+            
             RegisterAsset(Asset);
             
             // Load hard dependencies
@@ -248,6 +370,13 @@ bool UCustomAssetManager::UnloadAssetById(const FName& AssetId)
         return false;
     }
 
+    // Pinned assets stay loaded until they are unpinned
+    if (PinnedAssets.Contains(AssetId))
+    {
+        UE_LOG(LogTemp, Warning, TEXT("Asset with ID %s cannot be unloaded because it is pinned"), *AssetId.ToString());
+        return false;
+    }
+
     // Check if the asset can be safely unloaded
     if (!CanUnloadAsset(AssetId))
     {
@@ -258,6 +387,11 @@ bool UCustomAssetManager::UnloadAssetById(const FName& AssetId)
     // Unregister the asset
     UnregisterAsset(Asset);
     
+    // The asset is no longer a root, so its hard dependencies may have become unreachable
+    DirectLoadRoots.Remove(AssetId);
+    PrefetchedAssets.Remove(AssetId);
+    bReachabilityDirty = true;
+    
     // Update the memory tracker
     if (MemoryTracker)
     {
@@ -356,6 +490,8 @@ bool UCustomAssetManager::ExportAssetsToCSV(const FString& FilePath) const
 
 void UCustomAssetManager::ScanForAssets()
 {
+    LLM_SCOPE_BYTAG(CustomAssets_Manager);
+    
     // Get the asset registry module
     FAssetRegistryModule& AssetRegistryModule = FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry");
     IAssetRegistry& AssetRegistry = AssetRegistryModule.Get();
@@ -397,6 +533,8 @@ void UCustomAssetManager::ScanForAssets()
 
 void UCustomAssetManager::RegisterAsset(UCustomAssetBase* Asset)
 {
+    LLM_SCOPE_BYTAG(CustomAssets_Manager);
+    
     if (!Asset || Asset->AssetId.IsNone())
     {
         return;
@@ -414,10 +552,29 @@ void UCustomAssetManager::RegisterAsset(UCustomAssetBase* Asset)
         int64 MemoryUsage = EstimateAssetMemoryUsage(Asset);
         MemoryTracker->TrackAsset(Asset->AssetId, MemoryUsage);
     }
+    
+    // Charge the asset to its memory budget pool
+    if (BudgetPools.Num() > 0)
+    {
+        AssetBudgetPoolAssignments.Add(Asset->AssetId, ResolveBudgetPool(Asset));
+    }
+    
+    // Assets registered while a reachability pass is running are treated as reachable for that pass
+    if (ReachabilityPhase != EReachabilityPhase::Idle)
+    {
+        bool bAlreadyReachable = false;
+        ReachableAssets.Add(Asset->AssetId, &bAlreadyReachable);
+        if (!bAlreadyReachable && ReachabilityPhase == EReachabilityPhase::Mark)
+        {
+            ReachabilityMarkStack.Add(Asset->AssetId);
+        }
+    }
 }
 
 void UCustomAssetManager::RegisterAssetPath(const FName& AssetId, const FSoftObjectPath& AssetPath)
 {
+    LLM_SCOPE_BYTAG(CustomAssets_Manager);
+    
     if (AssetId.IsNone() || !AssetPath.IsValid())
     {
         UE_LOG(LogTemp, Warning, TEXT("Cannot register invalid asset path for ID: %s"), 
@@ -460,12 +617,26 @@ void UCustomAssetManager::UnregisterAsset(UCustomAssetBase* Asset)
 
     // Remove from loaded assets map
     LoadedAssets.Remove(Asset->AssetId);
+    
+    // Stop charging the asset to its budget pool
+    AssetBudgetPoolAssignments.Remove(Asset->AssetId);
+    
+    // Its mesh variants are no longer resolved through it
+    ReleasePresentationVariants(Asset->AssetId);
+    
+    // The object stays resident until the next collection, which is expected rather than a leak
+    if (ResidencyAuditor)
+    {
+        ResidencyAuditor->NotifyAssetUnregistered(Asset->AssetId);
+    }
 }
 
 // ASSET BUNDLE FUNCTIONS
 
 void UCustomAssetManager::RegisterBundle(UCustomAssetBundle* Bundle)
 {
+    LLM_SCOPE_BYTAG(CustomAssets_Bundles);
+    
     if (!Bundle)
     {
         UE_LOG(LogTemp, Warning, TEXT("[CRITICAL] RegisterBundle: Cannot register null bundle"));
@@ -517,14 +688,24 @@ void UCustomAssetManager::RegisterBundle(UCustomAssetBundle* Bundle)
             Bundle->Description = ExistingBundle->Description;
             Bundle->bPreloadAtStartup = ExistingBundle->bPreloadAtStartup;
             Bundle->bKeepInMemory = ExistingBundle->bKeepInMemory;
+            Bundle->bCreateGCCluster = ExistingBundle->bCreateGCCluster;
+            Bundle->CriticalAssetIds = ExistingBundle->CriticalAssetIds;
             Bundle->Priority = ExistingBundle->Priority;
             Bundle->Tags = ExistingBundle->Tags;
             
+            // The replaced instance must not keep its members clustered or stay rooted as a permanent bundle
+            ExistingBundle->DissolveGCCluster();
+            if (ExistingBundle->IsRooted() && DisregardForGCReport.BundleIds.Contains(ExistingBundle->BundleId))
+            {
+                ExistingBundle->RemoveFromRoot();
+            }
+            
             // DO NOT COPY ASSETS - this was causing unexpected asset inclusion
             // Let the UI add assets explicitly
             
             // Replace the old bundle reference with the new one
             UE_LOG(LogTemp, Warning, TEXT("[CRITICAL] RegisterBundle: Replacing different bundle instance with same ID"));
+            UnindexBundleAssets(ExistingBundle);
             Bundles.Remove(Bundle->BundleId);
             Bundles.Add(Bundle->BundleId, Bundle);
         }
@@ -539,6 +720,8 @@ void UCustomAssetManager::RegisterBundle(UCustomAssetBundle* Bundle)
         Bundles.Add(Bundle->BundleId, Bundle);
     }
     
+    IndexBundleAssets(Bundle);
+    
     // Debug log bundle assets
     UE_LOG(LogTemp, Warning, TEXT("[CRITICAL] RegisterBundle: Bundle %s contains %d asset IDs:"), 
         *Bundle->BundleId.ToString(), Bundle->AssetIds.Num());
@@ -559,7 +742,10 @@ void UCustomAssetManager::UnregisterBundle(UCustomAssetBundle* Bundle)
     }
 
     // Remove from bundles map
+    UnindexBundleAssets(Bundles.FindRef(Bundle->BundleId));
     Bundles.Remove(Bundle->BundleId);
+    BundleRuntimeData.Remove(Bundle->BundleId);
+    BundleReferences.Remove(Bundle->BundleId);
     UE_LOG(LogTemp, Log, TEXT("Unregistered bundle: %s"), *Bundle->BundleId.ToString());
 }
 
@@ -576,6 +762,8 @@ void UCustomAssetManager::GetAllBundles(TArray<UCustomAssetBundle*>& OutBundles)
 
 void UCustomAssetManager::LoadBundle(const FName& BundleId, EAssetLoadingStrategy Strategy)
 {
+    LLM_SCOPE_BYTAG(CustomAssets_LoadedAssets);
+    
     UCustomAssetBundle* Bundle = GetBundleById(BundleId);
     if (!::IsValid(Bundle))
     {
@@ -583,1701 +771,4576 @@ void UCustomAssetManager::LoadBundle(const FName& BundleId, EAssetLoadingStrateg
         return;
     }
 
-    UE_LOG(LogTemp, Log, TEXT("Loading bundle: %s with %d assets"), *BundleId.ToString(), Bundle->AssetIds.Num());
+    // Checked before the budget, which would otherwise price a bundle that is already resident or streaming in
+    if (Bundle->bIsLoaded)
+    {
+        UE_LOG(LogTemp, Verbose, TEXT("Bundle %s is already loaded"), *BundleId.ToString());
+        return;
+    }
+
+    // A streaming load already in flight reports its own progress
+    if (ActiveBundleLoads.Contains(BundleId))
+    {
+        UE_LOG(LogTemp, Log, TEXT("Bundle %s is already loading"), *BundleId.ToString());
+        return;
+    }
 
-    // For small bundles, load assets individually
-    if (Bundle->AssetIds.Num() < 5)
+    // Lazy bundles load their assets on first use
+    if (Strategy == EAssetLoadingStrategy::LazyLoad)
     {
-        // Load each asset in the bundle
-        for (const FName& AssetId : Bundle->AssetIds)
+        UE_LOG(LogTemp, Log, TEXT("Bundle %s uses lazy loading, assets will load on first use"), *BundleId.ToString());
+        return;
+    }
+
+    // Bundles saved before their contents changed get a fresh manifest, at runtime without loading anything extra
+    if (!Bundle->Manifest.IsUpToDate(Bundle->AssetIds))
+    {
+        RefreshBundleManifest(Bundle, GIsEditor);
+    }
+    const FCustomAssetBundleManifest& Manifest = Bundle->Manifest;
+
+    UE_LOG(LogTemp, Log, TEXT("Loading bundle: %s with %d assets (%d including dependencies, ~%lld KB)"), 
+        *BundleId.ToString(), Bundle->AssetIds.Num(), Manifest.LoadOrder.Num(), Manifest.EstimatedResidentBytes / 1024);
+
+    // Refuse or defer bundles that would push memory usage over the threshold, unless the policy keeps everything
+    const int64 LoadCost = MemoryPolicy != EMemoryManagementPolicy::KeepAll ? GetBundleLoadCost(Bundle) : 0;
+    const int64 CurrentUsage = MemoryTracker ? MemoryTracker->GetLoadedMemoryUsage() : 0;
+    if (LoadCost > 0 && CurrentUsage + LoadCost > MemoryThreshold)
+    {
+        if (LoadCost > MemoryThreshold || !bDeferOverBudgetBundles)
+        {
+            UE_LOG(LogTemp, Warning, TEXT("Refusing to load bundle %s: needs %lld KB, %lld KB of %lld KB in use"), 
+                *BundleId.ToString(), LoadCost / 1024, CurrentUsage / 1024, MemoryThreshold / 1024);
+            return;
+        }
+        
+        if (!IsBundleLoadDeferred(BundleId))
         {
-            LoadAssetByIdWithStrategy(AssetId, Strategy);
+            DeferredBundleLoads.Emplace(BundleId, Strategy);
         }
+        
+        UE_LOG(LogTemp, Log, TEXT("Deferring bundle %s until %lld KB are available"), *BundleId.ToString(), LoadCost / 1024);
+        return;
     }
-    else
+
+    // Bundle members are kept reachable by the bundle, not as direct loads
+    TGuardValue<int32> InternalLoadGuard(InternalLoadDepth, InternalLoadDepth + 1);
+
+    // Attribute memory loaded for the bundle members to the bundle
+    FScopedAssetLoadContext LoadContext(MemoryTracker, NAME_None, BundleId, TEXT("LoadBundle"));
+
+    BeginBundleLoadProgress(Bundle);
+
+    // Issue a single request for the whole closure, dependencies first
+    TArray<FSoftObjectPath> AssetPaths;
+    AssetPaths.Reserve(Manifest.LoadOrder.Num());
+    for (const FName& AssetId : Manifest.LoadOrder)
     {
-        // For larger bundles, use batch loading for better performance
-        TArray<FSoftObjectPath> AssetPaths;
-        AssetPaths.Reserve(Bundle->AssetIds.Num());
+        // Resident assets are registered from memory below
+        if (LoadedAssets.Contains(AssetId))
+        {
+            continue;
+        }
         
-        // Collect all asset paths
-        for (const FName& AssetId : Bundle->AssetIds)
+        const FSoftObjectPath* AssetPath = AssetPathMap.Find(AssetId);
+        if (AssetPath && AssetPath->IsValid())
         {
-            FSoftObjectPath* AssetPath = AssetPathMap.Find(AssetId);
-            if (AssetPath)
-            {
-                AssetPaths.Add(*AssetPath);
-            }
+            AssetPaths.Add(*AssetPath);
         }
+    }
+
+    if (AssetPaths.Num() > 0 && Strategy == EAssetLoadingStrategy::Streaming)
+    {
+        TSharedPtr<FStreamableHandle> Handle = UAssetManager::GetStreamableManager().RequestAsyncLoad(
+            AssetPaths,
+            FStreamableDelegate::CreateUObject(this, &UCustomAssetManager::OnBundleLoaded, BundleId)
+        );
         
-        // Use streamable manager for batch loading
-        if (AssetPaths.Num() > 0)
+        // The request may already have completed if everything was resident
+        if (FBundleLoadState* LoadState = ActiveBundleLoads.Find(BundleId))
         {
-            if (Strategy == EAssetLoadingStrategy::Streaming)
-            {
-                // Async load for streaming strategy
-                FStreamableManager& StreamableMgr = UAssetManager::GetStreamableManager();
-                StreamableMgr.RequestAsyncLoad(
-                    AssetPaths,
-                    FStreamableDelegate::CreateUObject(this, &UCustomAssetManager::OnBundleLoaded, BundleId)
-                );
-            }
-            else
+            LoadState->Handle = Handle;
+            if (Handle.IsValid())
             {
-                // Sync load for other strategies
-                FStreamableManager& StreamableMgr = UAssetManager::GetStreamableManager();
-                StreamableMgr.RequestSyncLoad(AssetPaths);
-                
-                // Register all loaded assets
-                for (const FName& AssetId : Bundle->AssetIds)
-                {
-                    FSoftObjectPath* AssetPath = AssetPathMap.Find(AssetId);
-                    if (AssetPath && AssetPath->IsValid())
-                    {
-                        UCustomAssetBase* Asset = Cast<UCustomAssetBase>(AssetPath->ResolveObject());
-                        if (Asset)
-                        {
-                            RegisterAsset(Asset);
-                        }
-                    }
-                }
-                
-                // Mark the bundle as loaded
-                Bundle->bIsLoaded = true;
+                Handle->BindUpdateDelegate(FStreamableUpdateDelegate::CreateUObject(this, &UCustomAssetManager::OnBundleLoadUpdated, BundleId));
             }
+            
+            // Report the assets that were already resident
+            UpdateBundleLoadProgress(BundleId);
         }
+        return;
+    }
+
+    if (AssetPaths.Num() > 0)
+    {
+        UAssetManager::GetStreamableManager().RequestSyncLoad(AssetPaths);
     }
+
+    RegisterLoadedBundleAssets(Bundle);
+    
+    // Mark the bundle as loaded so it roots its assets
+    Bundle->bIsLoaded = true;
+    BuildBundleRuntimeData(Bundle);
+    CreateBundleGCCluster(Bundle);
+    
+    UpdateBundleLoadProgress(BundleId, true);
 }
 
 // New helper method for bundle loading completion
 void UCustomAssetManager::OnBundleLoaded(FName BundleId)
 {
+    LLM_SCOPE_BYTAG(CustomAssets_LoadedAssets);
+    
     UCustomAssetBundle* Bundle = GetBundleById(BundleId);
     if (!::IsValid(Bundle))
     {
         return;
     }
     
-    // Register all loaded assets in the bundle
-    for (const FName& AssetId : Bundle->AssetIds)
-    {
-        FSoftObjectPath* AssetPath = AssetPathMap.Find(AssetId);
-        if (AssetPath && AssetPath->IsValid())
-        {
-            UCustomAssetBase* Asset = Cast<UCustomAssetBase>(AssetPath->ResolveObject());
-            if (Asset)
-            {
-                RegisterAsset(Asset);
-            }
-        }
-    }
+    FScopedAssetLoadContext LoadContext(MemoryTracker, NAME_None, BundleId, TEXT("LoadBundle (async)"));
+    
+    RegisterLoadedBundleAssets(Bundle);
     
     // Mark the bundle as loaded
     Bundle->bIsLoaded = true;
+    BuildBundleRuntimeData(Bundle);
+    CreateBundleGCCluster(Bundle);
     
     UE_LOG(LogTemp, Log, TEXT("Bundle %s loaded asynchronously"), *BundleId.ToString());
+    
+    UpdateBundleLoadProgress(BundleId, true);
 }
 
-void UCustomAssetManager::UnloadBundle(const FName& BundleId)
+void UCustomAssetManager::OnBundleLoadUpdated(TSharedRef<FStreamableHandle> Handle, FName BundleId)
 {
-    UCustomAssetBundle* Bundle = GetBundleById(BundleId);
-    if (!Bundle)
+    UpdateBundleLoadProgress(BundleId);
+}
+
+void UCustomAssetManager::BeginBundleLoadProgress(UCustomAssetBundle* Bundle)
+{
+    const FCustomAssetBundleManifest& Manifest = Bundle->Manifest;
+    
+    FBundleLoadState& LoadState = ActiveBundleLoads.Add(Bundle->BundleId);
+    LoadState.PendingAssetIds = Manifest.LoadOrder;
+    LoadState.PendingAssetBytes = Manifest.ResidentBytes;
+    LoadState.PendingAssetBytes.SetNumZeroed(LoadState.PendingAssetIds.Num());
+    
+    for (const FName& AssetId : Bundle->CriticalAssetIds)
     {
-        UE_LOG(LogTemp, Warning, TEXT("Bundle with ID %s not found"), *BundleId.ToString());
-        return;
+        if (Manifest.LoadOrder.Contains(AssetId))
+        {
+            LoadState.PendingCriticalAssetIds.Add(AssetId);
+        }
     }
+    LoadState.bHasCriticalSubset = LoadState.PendingCriticalAssetIds.Num() > 0;
+    
+    LoadState.Progress.BundleId = Bundle->BundleId;
+    LoadState.Progress.TotalAssets = Manifest.LoadOrder.Num();
+    LoadState.Progress.TotalBytes = Manifest.EstimatedResidentBytes;
+}
 
-    // Skip unloading if the bundle should be kept in memory
-    if (Bundle->bKeepInMemory)
+void UCustomAssetManager::UpdateBundleLoadProgress(const FName& BundleId, bool bFinished)
+{
+    LLM_SCOPE_BYTAG(CustomAssets_LoadedAssets);
+    
+    FBundleLoadState* LoadState = ActiveBundleLoads.Find(BundleId);
+    if (!LoadState)
     {
-        UE_LOG(LogTemp, Log, TEXT("Bundle %s is marked to keep in memory, skipping unload"), *BundleId.ToString());
         return;
     }
-
-    UE_LOG(LogTemp, Log, TEXT("Unloading bundle: %s"), *BundleId.ToString());
-
-    // Unload each asset in the bundle
-    for (const FName& AssetId : Bundle->AssetIds)
+    
+    // Assets that arrive mid-load are registered right away so they can be used before the bundle completes
+    TGuardValue<int32> InternalLoadGuard(InternalLoadDepth, InternalLoadDepth + 1);
+    FScopedAssetLoadContext LoadContext(MemoryTracker, NAME_None, BundleId, TEXT("LoadBundle (async)"));
+    
+    TArray<FName> ArrivedAssetIds;
+    for (int32 Index = 0; Index < LoadState->PendingAssetIds.Num(); ++Index)
     {
-        UnloadAssetById(AssetId);
+        const FName AssetId = LoadState->PendingAssetIds[Index];
+        
+        UCustomAssetBase* Asset = LoadedAssets.FindRef(AssetId);
+        if (!Asset)
+        {
+            const FSoftObjectPath* AssetPath = AssetPathMap.Find(AssetId);
+            Asset = AssetPath ? Cast<UCustomAssetBase>(AssetPath->ResolveObject()) : nullptr;
+            
+            // Objects can be found while the async loader is still serializing them
+            if (!Asset || Asset->HasAnyFlags(RF_NeedLoad | RF_NeedPostLoad) || Asset->HasAnyInternalFlags(EInternalObjectFlags::AsyncLoading))
+            {
+                continue;
+            }
+            
+            RegisterAsset(Asset);
+        }
+        
+        ArrivedAssetIds.Add(AssetId);
+        LoadState->Progress.LoadedAssets++;
+        LoadState->Progress.LoadedBytes += LoadState->PendingAssetBytes[Index];
+        LoadState->PendingCriticalAssetIds.Remove(AssetId);
+        
+        LoadState->PendingAssetIds.RemoveAt(Index);
+        LoadState->PendingAssetBytes.RemoveAt(Index);
+        --Index;
+    }
+    
+    if (ArrivedAssetIds.Num() == 0 && !bFinished)
+    {
+        return;
+    }
+    
+    // Without a configured subset the critical event fires together with completion
+    bool bCriticalSubsetReady = false;
+    if (!LoadState->Progress.bCriticalSubsetReady && LoadState->PendingCriticalAssetIds.Num() == 0 && (LoadState->bHasCriticalSubset || bFinished))
+    {
+        LoadState->Progress.bCriticalSubsetReady = true;
+        bCriticalSubsetReady = true;
+    }
+    
+    // Copy the progress out before broadcasting, listeners may start or cancel loads
+    LoadState->Progress.bComplete = bFinished;
+    const FBundleLoadProgress Progress = LoadState->Progress;
+    if (bFinished)
+    {
+        ActiveBundleLoads.Remove(BundleId);
     }
+    
+    for (const FName& AssetId : ArrivedAssetIds)
+    {
+        OnBundleAssetAvailable.Broadcast(BundleId, AssetId);
+    }
+    
+    if (bCriticalSubsetReady)
+    {
+        OnBundleCriticalSubsetReady.Broadcast(BundleId);
+    }
+    
+    OnBundleLoadProgress.Broadcast(BundleId, Progress);
 }
 
-void UCustomAssetManager::ScanForBundles()
+bool UCustomAssetManager::GetBundleLoadProgress(const FName& BundleId, FBundleLoadProgress& OutProgress) const
 {
-    // Get the asset registry module
-    FAssetRegistryModule& AssetRegistryModule = FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry");
-    IAssetRegistry& AssetRegistry = AssetRegistryModule.Get();
-
-    // Wait for asset discovery to complete
-    UE_LOG(LogTemp, Warning, TEXT("[CRITICAL] ScanForBundles: Waiting for Asset Registry completion..."));
-    AssetRegistry.WaitForCompletion();
-
-    // Get all assets derived from UCustomAssetBundle
-    TArray<FAssetData> BundleData;
-    FTopLevelAssetPath BundleClassPath = UCustomAssetBundle::StaticClass()->GetClassPathName();
+    if (const FBundleLoadState* LoadState = ActiveBundleLoads.Find(BundleId))
+    {
+        OutProgress = LoadState->Progress;
+        return true;
+    }
     
-    UE_LOG(LogTemp, Warning, TEXT("[CRITICAL] ScanForBundles: Searching for bundles with class path %s..."), *BundleClassPath.ToString());
-    AssetRegistry.GetAssetsByClass(BundleClassPath, BundleData, true);
-
-    UE_LOG(LogTemp, Warning, TEXT("[CRITICAL] ScanForBundles: Found %d asset bundles"), BundleData.Num());
-
-    // Clear existing bundles map
-    Bundles.Empty();
+    const UCustomAssetBundle* Bundle = Bundles.FindRef(BundleId);
+    if (!::IsValid(Bundle) || !Bundle->bIsLoaded)
+    {
+        return false;
+    }
+    
+    OutProgress = FBundleLoadProgress();
+    OutProgress.BundleId = BundleId;
+    OutProgress.LoadedAssets = OutProgress.TotalAssets = Bundle->Manifest.LoadOrder.Num();
+    OutProgress.LoadedBytes = OutProgress.TotalBytes = Bundle->Manifest.EstimatedResidentBytes;
+    OutProgress.bCriticalSubsetReady = true;
+    OutProgress.bComplete = true;
+    return true;
+}
 
-    // Process each bundle
-    int32 LoadedBundleCount = 0;
-    for (const FAssetData& Data : BundleData)
+void UCustomAssetManager::RegisterLoadedBundleAssets(UCustomAssetBundle* Bundle)
+{
+    // Register in manifest order so dependencies are registered before the assets that need them
+    const TArray<FName>& AssetIds = Bundle->Manifest.bIsBuilt ? Bundle->Manifest.LoadOrder : Bundle->AssetIds;
+    for (const FName& AssetId : AssetIds)
     {
-        // Log each bundle found
-        UE_LOG(LogTemp, Warning, TEXT("[CRITICAL] ScanForBundles: Processing bundle asset path: %s"), *Data.PackageName.ToString());
-        
-        // Load the bundle to get its ID
-        UCustomAssetBundle* Bundle = Cast<UCustomAssetBundle>(Data.GetAsset());
-        if (Bundle)
+        const FSoftObjectPath* AssetPath = AssetPathMap.Find(AssetId);
+        if (AssetPath && AssetPath->IsValid())
         {
-            if (!Bundle->BundleId.IsNone())
+            // Assets that arrived during streaming are already registered
+            UCustomAssetBase* Asset = Cast<UCustomAssetBase>(AssetPath->ResolveObject());
+            if (Asset && LoadedAssets.FindRef(AssetId) != Asset)
             {
-                // Log the bundle info
-                UE_LOG(LogTemp, Warning, TEXT("[CRITICAL] ScanForBundles: Loaded bundle with ID %s, name '%s', containing %d assets and %d loaded assets"), 
-                    *Bundle->BundleId.ToString(), 
-                    *Bundle->DisplayName.ToString(),
-                    Bundle->AssetIds.Num(),
-                    Bundle->Assets.Num());
-                
-                for (const FName& AssetId : Bundle->AssetIds)
-                {
-                    UE_LOG(LogTemp, Log, TEXT("      Asset ID in bundle: %s"), *AssetId.ToString());
-                }
-                
-                // Register the bundle
-                if (!Bundles.Contains(Bundle->BundleId))
-                {
-                    RegisterBundle(Bundle);
-                    LoadedBundleCount++;
-                }
-                else
-                {
-                    UE_LOG(LogTemp, Warning, TEXT("[CRITICAL] ScanForBundles: Duplicate bundle ID %s found, skipping"), *Bundle->BundleId.ToString());
-                }
-            }
-            else
-            {
-                UE_LOG(LogTemp, Warning, TEXT("[CRITICAL] ScanForBundles: Bundle %s has no ID assigned, assigning new ID"), *Data.AssetName.ToString());
-                // Generate a new ID
-                FGuid NewGuid = FGuid::NewGuid();
-                Bundle->BundleId = FName(*NewGuid.ToString());
-                
-                // Try to register with new ID
-                RegisterBundle(Bundle);
-                LoadedBundleCount++;
+                RegisterAsset(Asset);
             }
         }
-        else
-        {
-            UE_LOG(LogTemp, Warning, TEXT("[CRITICAL] ScanForBundles: Failed to load bundle asset %s"), *Data.PackageName.ToString());
-        }
-    }
-    
-    UE_LOG(LogTemp, Warning, TEXT("[CRITICAL] ScanForBundles: Successfully registered %d/%d bundles"), LoadedBundleCount, BundleData.Num());
-    
-    // Additional check to see if bundles are really in the map
-    TArray<UCustomAssetBundle*> AllBundles;
-    GetAllBundles(AllBundles);
-    UE_LOG(LogTemp, Warning, TEXT("[CRITICAL] ScanForBundles: Bundles map contains %d bundles after scan"), AllBundles.Num());
-    
-    // Log all bundles now in the map
-    for (UCustomAssetBundle* Bundle : AllBundles)
-    {
-        if (Bundle)
-        {
-            UE_LOG(LogTemp, Warning, TEXT("[CRITICAL] Bundle in map: ID=%s, Name='%s', Assets=%d"), 
-                *Bundle->BundleId.ToString(), 
-                *Bundle->DisplayName.ToString(),
-                Bundle->AssetIds.Num());
-        }
     }
 }
 
-void UCustomAssetManager::PreloadBundles()
+bool UCustomAssetManager::RefreshBundleManifest(UCustomAssetBundle* Bundle, bool bLoadMissingAssets)
 {
-    // Get all bundles
-    TArray<UCustomAssetBundle*> AllBundles;
-    GetAllBundles(AllBundles);
-
-    // Early exit if no bundles
-    if (AllBundles.Num() == 0)
-    {
-        return;
-    }
-
-    // Sort bundles by priority (higher priority first)
-    AllBundles.Sort([](const UCustomAssetBundle& A, const UCustomAssetBundle& B) {
-        return A.Priority > B.Priority;
-    });
-
-    // Collect all bundles marked for preloading
-    TArray<UCustomAssetBundle*> BundlesToPreload;
-    BundlesToPreload.Reserve(AllBundles.Num() / 2); // Estimate half will be preloaded
-    
-    for (UCustomAssetBundle* Bundle : AllBundles)
-    {
-        if (::IsValid(Bundle) && Bundle->bPreloadAtStartup)
-        {
-            BundlesToPreload.Add(Bundle);
-        }
-    }
+    LLM_SCOPE_BYTAG(CustomAssets_Bundles);
     
-    // Early exit if no bundles to preload
-    if (BundlesToPreload.Num() == 0)
+    if (!::IsValid(Bundle))
     {
-        return;
+        return false;
     }
     
-    UE_LOG(LogTemp, Log, TEXT("Preloading %d bundles"), BundlesToPreload.Num());
+    FCustomAssetBundleManifest Manifest;
+    TSet<FName> Visited;
     
-    // For a small number of bundles, load them individually
-    if (BundlesToPreload.Num() < 3)
+    // Post-order walk over hard dependencies puts every dependency before its dependents, cycles are cut at the first revisit
+    TFunction<void(const FName&)> Visit = [&](const FName& AssetId)
     {
-        for (UCustomAssetBundle* Bundle : BundlesToPreload)
+        bool bAlreadyVisited = false;
+        Visited.Add(AssetId, &bAlreadyVisited);
+        if (bAlreadyVisited)
         {
-            UE_LOG(LogTemp, Log, TEXT("Preloading bundle: %s"), *Bundle->BundleId.ToString());
-            LoadBundle(Bundle->BundleId, EAssetLoadingStrategy::Preload);
+            return;
         }
-    }
-    else
-    {
-        // For a larger number of bundles, batch load all assets
-        TArray<FSoftObjectPath> AllAssetPaths;
-        // Estimate average of 10 assets per bundle
-        AllAssetPaths.Reserve(BundlesToPreload.Num() * 10);
         
-        // Collect all asset paths from all bundles to preload
-        for (UCustomAssetBundle* Bundle : BundlesToPreload)
+        UCustomAssetBase* Asset = GetAssetById(AssetId);
+        if (!Asset && bLoadMissingAssets)
         {
-            UE_LOG(LogTemp, Log, TEXT("Adding bundle %s to preload batch"), *Bundle->BundleId.ToString());
-            
-            for (const FName& AssetId : Bundle->AssetIds)
+            if (const FSoftObjectPath* AssetPath = AssetPathMap.Find(AssetId))
             {
-                FSoftObjectPath* AssetPath = AssetPathMap.Find(AssetId);
-                if (AssetPath)
-                {
-                    AllAssetPaths.AddUnique(*AssetPath);
-                }
+                Asset = Cast<UCustomAssetBase>(AssetPath->TryLoad());
             }
         }
         
-        // Batch load all assets
-        if (AllAssetPaths.Num() > 0)
+        if (Asset)
         {
-            UE_LOG(LogTemp, Log, TEXT("Batch preloading %d assets from %d bundles"), 
-                AllAssetPaths.Num(), BundlesToPreload.Num());
-                
-            FStreamableManager& StreamableMgr = UAssetManager::GetStreamableManager();
-            StreamableMgr.RequestSyncLoad(AllAssetPaths);
-            
-            // Register all loaded assets
-            for (const FSoftObjectPath& AssetPath : AllAssetPaths)
+            for (const FCustomAssetDependency& Dependency : Asset->Dependencies)
             {
-                if (AssetPath.IsValid())
+                if (Dependency.bHardDependency && !Dependency.DependentAssetId.IsNone())
                 {
-                    UCustomAssetBase* Asset = Cast<UCustomAssetBase>(AssetPath.ResolveObject());
-                    if (Asset)
-                    {
-                        RegisterAsset(Asset);
-                    }
+                    Visit(Dependency.DependentAssetId);
                 }
             }
-            
-            // Mark all bundles as loaded
-            for (UCustomAssetBundle* Bundle : BundlesToPreload)
-            {
-                Bundle->bIsLoaded = true;
-            }
         }
-    }
-}
-
-// DEPENDENCY FUNCTIONS
-
-void UCustomAssetManager::LoadDependencies(const FName& AssetId, bool bLoadHardDependenciesOnly, EAssetLoadingStrategy Strategy)
-{
-    UCustomAssetBase* Asset = GetAssetById(AssetId);
-    if (!::IsValid(Asset))
-    {
-        UE_LOG(LogTemp, Warning, TEXT("Asset with ID %s not loaded, cannot load dependencies"), *AssetId.ToString());
-        return;
-    }
-
-    // Get dependencies to load
-    TArray<FName> DependenciesToLoad;
+        
+        const int64 ResidentBytes = EstimateManifestAssetBytes(AssetId, Asset);
+        Manifest.LoadOrder.Add(AssetId);
+        Manifest.ResidentBytes.Add(ResidentBytes);
+        Manifest.EstimatedResidentBytes += ResidentBytes;
+    };
     
-    if (bLoadHardDependenciesOnly)
-    {
-        // Only load hard dependencies
-        DependenciesToLoad = Asset->GetHardDependencies();
-    }
-    else
+    for (const FName& AssetId : Bundle->AssetIds)
     {
-        // Load all dependencies
-        DependenciesToLoad.Reserve(Asset->Dependencies.Num());
-        for (const FCustomAssetDependency& Dependency : Asset->Dependencies)
+        if (!AssetId.IsNone())
         {
-            DependenciesToLoad.Add(Dependency.DependentAssetId);
+            Visit(AssetId);
         }
     }
-
-    // Load each dependency - but only if not already loaded
-    for (const FName& DependencyId : DependenciesToLoad)
+    
+    // Disk size comes from the asset registry, counted once per package
+    IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry").Get();
+    TSet<FName> CountedPackages;
+    for (const FName& AssetId : Manifest.LoadOrder)
     {
-        // Skip if already loaded (optimization to avoid redundant loads)
-        if (GetAssetById(DependencyId) != nullptr)
+        const FSoftObjectPath* AssetPath = AssetPathMap.Find(AssetId);
+        if (!AssetPath || !AssetPath->IsValid())
         {
             continue;
         }
         
-        LoadAssetByIdWithStrategy(DependencyId, Strategy);
+        bool bAlreadyCounted = false;
+        const FName PackageName = AssetPath->GetLongPackageFName();
+        CountedPackages.Add(PackageName, &bAlreadyCounted);
+        if (bAlreadyCounted)
+        {
+            continue;
+        }
+        
+        TOptional<FAssetPackageData> PackageData = AssetRegistry.GetAssetPackageDataCopy(PackageName);
+        if (PackageData.IsSet() && PackageData->DiskSize > 0)
+        {
+            Manifest.EstimatedDiskBytes += PackageData->DiskSize;
+        }
     }
+    
+    Manifest.SourceHash = FCustomAssetBundleManifest::HashAssetIds(Bundle->AssetIds);
+    Manifest.bIsBuilt = true;
+    Bundle->Manifest = MoveTemp(Manifest);
+    
+    UE_LOG(LogTemp, Verbose, TEXT("Refreshed manifest for bundle %s: %d assets, ~%lld KB resident, %lld KB on disk"), 
+        *Bundle->BundleId.ToString(), Bundle->Manifest.LoadOrder.Num(), 
+        Bundle->Manifest.EstimatedResidentBytes / 1024, Bundle->Manifest.EstimatedDiskBytes / 1024);
+    
+    return true;
 }
 
-TArray<FName> UCustomAssetManager::GetDependentAssets(const FName& AssetId, bool bHardDependenciesOnly) const
+int64 UCustomAssetManager::EstimateManifestAssetBytes(const FName& AssetId, UCustomAssetBase* Asset) const
 {
-    TArray<FName> DependentAssets;
-    
-    UCustomAssetBase* Asset = GetAssetById(AssetId);
-    if (!Asset)
+    // Prefer what the tracker measured, so the budget check matches the tracker's accounting
+    if (MemoryTracker && MemoryTracker->IsAssetTracked(AssetId))
     {
-        UE_LOG(LogTemp, Warning, TEXT("Asset with ID %s not loaded, cannot get dependent assets"), *AssetId.ToString());
-        return DependentAssets;
+        const int64 TrackedBytes = MemoryTracker->GetAssetMemoryStats(AssetId).MemoryUsage;
+        if (TrackedBytes > 0)
+        {
+            return TrackedBytes;
+        }
     }
+    
+    return ::IsValid(Asset) ? EstimateAssetMemoryUsage(Asset) : EstimateAssetSizeFromMetadata(AssetId);
+}
 
-    // Get dependent assets
-    for (const FCustomAssetDependency& Dependency : Asset->DependentAssets)
+int64 UCustomAssetManager::GetBundleLoadCost(const UCustomAssetBundle* Bundle) const
+{
+    const FCustomAssetBundleManifest& Manifest = Bundle->Manifest;
+    
+    int64 LoadCost = 0;
+    for (int32 Index = 0; Index < Manifest.LoadOrder.Num(); ++Index)
     {
-        if (!bHardDependenciesOnly || Dependency.bHardDependency)
+        // Assets that are already resident cost nothing extra
+        if (!LoadedAssets.Contains(Manifest.LoadOrder[Index]) && Manifest.ResidentBytes.IsValidIndex(Index))
         {
-            DependentAssets.Add(Dependency.DependentAssetId);
+            LoadCost += Manifest.ResidentBytes[Index];
         }
     }
+    return LoadCost;
+}
 
-    return DependentAssets;
+bool UCustomAssetManager::IsBundleLoadDeferred(const FName& BundleId) const
+{
+    return DeferredBundleLoads.ContainsByPredicate([&BundleId](const TPair<FName, EAssetLoadingStrategy>& Entry)
+    {
+        return Entry.Key == BundleId;
+    });
 }
 
-bool UCustomAssetManager::CanUnloadAsset(const FName& AssetId) const
+void UCustomAssetManager::CancelDeferredBundleLoad(const FName& BundleId)
 {
-    UCustomAssetBase* Asset = GetAssetById(AssetId);
-    if (!Asset)
+    DeferredBundleLoads.RemoveAll([&BundleId](const TPair<FName, EAssetLoadingStrategy>& Entry)
     {
-        // Asset not loaded, so it can be "unloaded"
-        return true;
-    }
+        return Entry.Key == BundleId;
+    });
+}
 
-    // Check if any loaded assets have a hard dependency on this asset
-    for (const FCustomAssetDependency& Dependency : Asset->DependentAssets)
+void UCustomAssetManager::CancelBundleLoad(const FName& BundleId)
+{
+    CancelDeferredBundleLoad(BundleId);
+    
+    FBundleLoadState LoadState;
+    if (ActiveBundleLoads.RemoveAndCopyValue(BundleId, LoadState) && LoadState.Handle.IsValid())
     {
-        if (Dependency.bHardDependency && LoadedAssets.Contains(Dependency.DependentAssetId))
-        {
-            // Found a loaded asset with a hard dependency on this asset
-            return false;
-        }
+        LoadState.Handle->CancelHandle();
     }
-
-    // No loaded assets have a hard dependency on this asset
-    return true;
 }
 
-void UCustomAssetManager::UpdateDependencies()
+void UCustomAssetManager::GatherBundleClosure(UCustomAssetBundle* Bundle, TSet<FName>& OutAssetIds)
 {
-    // Clear all dependent assets
-    TArray<UCustomAssetBase*> AllAssets = GetAllLoadedAssets();
-    for (UCustomAssetBase* Asset : AllAssets)
+    if (!Bundle->Manifest.IsUpToDate(Bundle->AssetIds))
     {
-        Asset->DependentAssets.Empty();
+        RefreshBundleManifest(Bundle, GIsEditor);
     }
+    OutAssetIds.Append(Bundle->Manifest.LoadOrder);
+}
 
-    // Register dependencies for all loaded assets
-    for (UCustomAssetBase* Asset : AllAssets)
+void UCustomAssetManager::RetryDeferredBundleLoads()
+{
+    if (DeferredBundleLoads.Num() == 0 || !MemoryTracker)
     {
-        RegisterAssetDependencies(Asset);
+        return;
+    }
+    
+    // Start loads in request order while they fit, later bundles keep waiting behind the first that does not
+    while (DeferredBundleLoads.Num() > 0)
+    {
+        const TPair<FName, EAssetLoadingStrategy> Entry = DeferredBundleLoads[0];
+        UCustomAssetBundle* Bundle = GetBundleById(Entry.Key);
+        if (!::IsValid(Bundle))
+        {
+            DeferredBundleLoads.RemoveAt(0);
+            continue;
+        }
+        
+        if (MemoryTracker->GetLoadedMemoryUsage() + GetBundleLoadCost(Bundle) > MemoryThreshold)
+        {
+            break;
+        }
+        
+        DeferredBundleLoads.RemoveAt(0);
+        LoadBundle(Entry.Key, Entry.Value);
     }
 }
 
-bool UCustomAssetManager::ExportDependencyGraph(const FString& FilePath) const
+void UCustomAssetManager::UnloadBundle(const FName& BundleId)
 {
-    FString DotContent = "digraph AssetDependencies {\n";
-    DotContent += "  rankdir=LR;\n";
-    DotContent += "  node [shape=box, style=filled, fillcolor=lightblue];\n\n";
-
-    // Add nodes for all assets
-    TArray<FName> AssetIds = GetAllAssetIds();
-    for (const FName& AssetId : AssetIds)
+    UCustomAssetBundle* Bundle = GetBundleById(BundleId);
+    if (!Bundle)
     {
-        DotContent += FString::Printf(TEXT("  \"%s\";\n"), *AssetId.ToString());
+        UE_LOG(LogTemp, Warning, TEXT("Bundle with ID %s not found"), *BundleId.ToString());
+        return;
     }
 
-    DotContent += "\n";
-
-    // Add edges for dependencies
-    for (const FName& AssetId : AssetIds)
-    {
-        UCustomAssetBase* Asset = GetAssetById(AssetId);
-        if (Asset)
-        {
-            for (const FCustomAssetDependency& Dependency : Asset->Dependencies)
-            {
-                FString EdgeStyle = Dependency.bHardDependency ? "solid" : "dashed";
-                FString EdgeColor = Dependency.bHardDependency ? "black" : "gray";
-                
-                DotContent += FString::Printf(TEXT("  \"%s\" -> \"%s\" [label=\"%s\", style=%s, color=%s];\n"),
-                    *AssetId.ToString(),
-                    *Dependency.DependentAssetId.ToString(),
-                    *Dependency.DependencyType.ToString(),
-                    *EdgeStyle,
-                    *EdgeColor);
-            }
-        }
-    }
-
-    DotContent += "}\n";
-
-    // Write the DOT file
-    return FFileHelper::SaveStringToFile(DotContent, *FilePath);
-}
-
-void UCustomAssetManager::RegisterAssetDependencies(UCustomAssetBase* Asset)
-{
-    if (!Asset)
-    {
-        return;
-    }
-
-    // Register this asset as a dependent for each of its dependencies
-    for (const FCustomAssetDependency& Dependency : Asset->Dependencies)
-    {
-        UCustomAssetBase* DependentAsset = GetAssetById(Dependency.DependentAssetId);
-        if (DependentAsset)
-        {
-            DependentAsset->AddDependentAsset(Asset->AssetId, Dependency.DependencyType, Dependency.bHardDependency);
-        }
-    }
-}
-
-void UCustomAssetManager::UnregisterAssetDependencies(UCustomAssetBase* Asset)
-{
-    if (!Asset)
+    // Skip unloading if the bundle should be kept in memory
+    if (Bundle->bKeepInMemory)
     {
+        UE_LOG(LogTemp, Log, TEXT("Bundle %s is marked to keep in memory, skipping unload"), *BundleId.ToString());
         return;
     }
 
-    // Unregister this asset as a dependent for each of its dependencies
-    for (const FCustomAssetDependency& Dependency : Asset->Dependencies)
-    {
-        UCustomAssetBase* DependentAsset = GetAssetById(Dependency.DependentAssetId);
-        if (DependentAsset)
-        {
-            DependentAsset->RemoveDependentAsset(Asset->AssetId);
-        }
-    }
-}
-
-// MEMORY MANAGEMENT FUNCTIONS
-
-void UCustomAssetManager::SetMemoryManagementPolicy(EMemoryManagementPolicy Policy)
-{
-    MemoryPolicy = Policy;
-}
+    UE_LOG(LogTemp, Log, TEXT("Unloading bundle: %s"), *BundleId.ToString());
 
-void UCustomAssetManager::SetMemoryUsageThreshold(int32 ThresholdMB)
-{
-    // Convert megabytes to bytes
-    MemoryThreshold = static_cast<int64>(ThresholdMB) * 1024 * 1024;
-}
+    MarkBundleUnloaded(Bundle);
 
-int32 UCustomAssetManager::GetCurrentMemoryUsage() const
-{
-    if (!MemoryTracker)
+    // Unload each asset in the bundle
+    for (const FName& AssetId : Bundle->AssetIds)
     {
-        return 0;
+        UnloadAssetById(AssetId);
     }
-    
-    // Convert bytes to megabytes
-    return static_cast<int32>(MemoryTracker->GetLoadedMemoryUsage() / (1024 * 1024));
 }
 
-int32 UCustomAssetManager::GetMemoryUsageThreshold() const
+void UCustomAssetManager::MarkBundleUnloaded(UCustomAssetBundle* Bundle)
 {
-    // Convert bytes to megabytes
-    return static_cast<int32>(MemoryThreshold / (1024 * 1024));
-}
+    // A load still waiting for memory or streaming in is no longer wanted
+    CancelBundleLoad(Bundle->BundleId);
 
-void UCustomAssetManager::ManageMemoryUsage()
-{
-    if (!MemoryTracker || MemoryPolicy == EMemoryManagementPolicy::KeepAll)
-    {
-        return;
-    }
+    // Release the cluster so its members can be collected individually
+    Bundle->DissolveGCCluster();
     
-    // Get the current memory usage
-    int64 CurrentUsage = MemoryTracker->GetLoadedMemoryUsage();
+    // Derived data goes away with its arena in one step
+    BundleRuntimeData.Remove(Bundle->BundleId);
     
-    // Check if we need to free memory - add a threshold buffer to avoid frequent memory management
-    // Only trigger memory management if we're significantly over the threshold (10% buffer)
-    if (CurrentUsage > (MemoryThreshold * 1.1))
+    // Owners of a bundle unloaded around the reference counts no longer hold it and acquire it again when they need it
+    FBundleReferenceState RemovedReference;
+    if (BundleReferences.RemoveAndCopyValue(Bundle->BundleId, RemovedReference) && RemovedReference.Owners.Num() > 0)
     {
-        // Calculate how much memory to free (target is 80% of threshold)
-        int64 TargetUsage = MemoryThreshold * 0.8;
-        int64 MemoryToFree = CurrentUsage - TargetUsage;
-        
-        // Convert to megabytes for the function call
-        int32 MemoryToFreeMB = static_cast<int32>(MemoryToFree / (1024 * 1024));
-        
-        // Free memory
-        UnloadAssetsToFreeMemory(MemoryToFreeMB);
+        UE_LOG(LogTemp, Verbose, TEXT("Bundle %s unloaded while held by %d owners, dropping them"), 
+            *Bundle->BundleId.ToString(), RemovedReference.Owners.Num());
     }
+    
+    // The bundle no longer roots its assets
+    Bundle->bIsLoaded = false;
+    bReachabilityDirty = true;
 }
 
-void UCustomAssetManager::UnloadAssetsToFreeMemory(int32 MemoryToFreeMB)
+FBundleTransitionResult UCustomAssetManager::TransitionBundles(const TArray<FName>& OutgoingBundleIds, const TArray<FName>& IncomingBundleIds, EAssetLoadingStrategy Strategy)
 {
-    if (!MemoryTracker || MemoryToFreeMB <= 0)
-    {
-        return;
-    }
-    
-    // Convert megabytes to bytes
-    int64 MemoryToFree = static_cast<int64>(MemoryToFreeMB) * 1024 * 1024;
-    int64 MemoryFreed = 0;
-    
-    // Get assets to unload based on the memory policy
-    TArray<FName> AssetsToUnload;
+    LLM_SCOPE_BYTAG(CustomAssets_LoadedAssets);
     
-    // Pre-allocate a reasonable size to avoid reallocations
-    AssetsToUnload.Reserve(50);
+    FBundleTransitionResult Result;
+    const TSet<FName> IncomingSet(IncomingBundleIds);
     
-    switch (MemoryPolicy)
+    TSet<FName> IncomingAssets;
+    for (const FName& BundleId : IncomingBundleIds)
     {
-    case EMemoryManagementPolicy::UnloadLRU:
-        // Get least recently used assets
-        AssetsToUnload = MemoryTracker->GetLeastRecentlyUsedAssets(50);
-        break;
-        
-    case EMemoryManagementPolicy::UnloadLFU:
-        // Get least frequently used assets
-        AssetsToUnload = MemoryTracker->GetMostFrequentlyUsedAssets(50);
-        Algo::Reverse(AssetsToUnload); // Reverse to get least frequently used
-        break;
-        
-    default:
-        return;
+        UCustomAssetBundle* Bundle = GetBundleById(BundleId);
+        if (::IsValid(Bundle))
+        {
+            GatherBundleClosure(Bundle, IncomingAssets);
+        }
+        else
+        {
+            UE_LOG(LogTemp, Warning, TEXT("TransitionBundles: Incoming bundle %s not found"), *BundleId.ToString());
+        }
     }
     
-    // Unload assets until we free enough memory
-    for (const FName& AssetId : AssetsToUnload)
+    // Bundles in both sets stay as they are, owned and keep-in-memory bundles are not released
+    TArray<UCustomAssetBundle*> ReleasedBundles;
+    for (const FName& BundleId : OutgoingBundleIds)
     {
-        // Check if we've freed enough memory
-        if (MemoryFreed >= MemoryToFree)
-        {
-            break;
-        }
-        
-        // Get the asset - use direct lookup for better performance
-        UCustomAssetBase* Asset = GetAssetById(AssetId);
-        if (!::IsValid(Asset))
+        UCustomAssetBundle* Bundle = GetBundleById(BundleId);
+        if (!::IsValid(Bundle) || IncomingSet.Contains(BundleId))
         {
             continue;
         }
         
-        // Check if the asset can be unloaded - skip if not
-        if (!CanUnloadAsset(AssetId))
+        if (Bundle->bKeepInMemory || GetBundleReferenceCount(BundleId) > 0)
         {
+            UE_LOG(LogTemp, Log, TEXT("TransitionBundles: Keeping bundle %s, it is kept in memory or still owned"), *BundleId.ToString());
             continue;
         }
         
-        // Get the memory usage before unloading
-        int64 AssetMemoryUsage = 0;
-        FAssetMemoryStats AssetStats = MemoryTracker->GetAssetMemoryStats(AssetId);
-        
-        // Unload the asset and track memory freed
-        if (UnloadAssetById(AssetId))
-        {
-            AssetMemoryUsage = AssetStats.MemoryUsage;
-            MemoryFreed += AssetMemoryUsage;
-            
-            UE_LOG(LogTemp, Verbose, TEXT("Unloaded asset %s to free memory, freed %lld bytes"), 
-                *AssetId.ToString(), AssetMemoryUsage);
-        }
+        ReleasedBundles.AddUnique(Bundle);
     }
     
-    // Log the total memory freed
-    UE_LOG(LogTemp, Verbose, TEXT("Memory management freed %lld bytes of memory"), MemoryFreed);
-}
-
-bool UCustomAssetManager::ExportMemoryUsageToCSV(const FString& FilePath) const
-{
-    if (!MemoryTracker)
+    // Everything still needed after the switch: the incoming closure plus the closures of the bundles that stay loaded
+    TSet<FName> NeededAssets = IncomingAssets;
+    for (const auto& Pair : Bundles)
     {
-        return false;
+        UCustomAssetBundle* Bundle = Pair.Value;
+        if (::IsValid(Bundle) && (Bundle->bIsLoaded || ActiveBundleLoads.Contains(Pair.Key)) && !ReleasedBundles.Contains(Bundle))
+        {
+            GatherBundleClosure(Bundle, NeededAssets);
+        }
     }
     
-    return MemoryTracker->ExportMemoryStatsToCSV(FilePath);
-}
-
-UCustomAssetMemoryTracker* UCustomAssetManager::GetMemoryTracker() const
-{
-    return MemoryTracker;
-}
-
-int64 UCustomAssetManager::EstimateAssetMemoryUsage(UCustomAssetBase* Asset) const
-{
-    if (!Asset)
+    for (const FName& AssetId : IncomingAssets)
     {
-        return 0;
+        if (LoadedAssets.Contains(AssetId))
+        {
+            Result.AssetsRetained++;
+        }
+        else
+        {
+            Result.AssetsLoaded++;
+            Result.BytesLoaded += EstimateManifestAssetBytes(AssetId, nullptr);
+        }
     }
     
-    // A very basic estimate based on the asset class
-    // In a real implementation, you would want to do more detailed analysis
-    
-    // Start with a base size
-    int64 MemoryUsage = 10 * 1024; // 10 KB base size
-    
-    // Add memory for strings
-    MemoryUsage += Asset->DisplayName.ToString().Len() * sizeof(TCHAR);
-    MemoryUsage += Asset->Description.ToString().Len() * sizeof(TCHAR);
-    
-    // Add memory for arrays
-    MemoryUsage += Asset->Tags.Num() * sizeof(FName);
-    MemoryUsage += Asset->Dependencies.Num() * sizeof(FCustomAssetDependency);
-    MemoryUsage += Asset->VersionHistory.Num() * sizeof(FAssetVersionChange);
-    
-    // Add memory used by dependencies (sub-assets)
-    TSet<FName> ProcessedAssets;
-    ProcessedAssets.Add(Asset->AssetId); // Avoid circular dependencies
-    MemoryUsage += CalculateDependenciesMemoryUsage(Asset, ProcessedAssets);
-    
-    // Add class-specific memory
-    // This would need to be customized for each asset type
-    // For example, for an item asset with textures:
-    /*
-    UCustomItemAsset* ItemAsset = Cast<UCustomItemAsset>(Asset);
-    if (ItemAsset && ItemAsset->Icon.IsValid())
+    // Unload the assets of the outgoing bundles that nothing needs anymore
+    auto ReleaseUnneededAssets = [this, &ReleasedBundles, &IncomingAssets, &Result](const TSet<FName>& StillNeeded)
     {
-        // Estimate texture memory
-        UTexture2D* IconTexture = ItemAsset->Icon.Get();
-        if (IconTexture)
+        for (UCustomAssetBundle* Bundle : ReleasedBundles)
         {
-            FTextureResource* Resource = IconTexture->Resource;
-            if (Resource)
+            for (const FName& AssetId : Bundle->AssetIds)
             {
-                MemoryUsage += Resource->GetResourceBulkDataSize();
+                if (StillNeeded.Contains(AssetId) || !LoadedAssets.Contains(AssetId))
+                {
+                    continue;
+                }
+                
+                const int64 AssetBytes = MemoryTracker ? MemoryTracker->GetAssetMemoryStats(AssetId).MemoryUsage : 0;
+                if (UnloadAssetById(AssetId))
+                {
+                    Result.AssetsReleased++;
+                    Result.BytesReleased += AssetBytes;
+                    if (IncomingAssets.Contains(AssetId))
+                    {
+                        Result.AssetsRetained--;
+                    }
+                }
             }
         }
-    }
-    */
+    };
     
-    return MemoryUsage;
-}
-
-// New helper method to calculate memory used by dependencies recursively
-int64 UCustomAssetManager::CalculateDependenciesMemoryUsage(UCustomAssetBase* Asset, TSet<FName>& ProcessedAssets) const
-{
-    if (!Asset)
+    // Release the outgoing bundles first so the freed memory counts towards the incoming budget check
+    for (UCustomAssetBundle* Bundle : ReleasedBundles)
     {
-        return 0;
+        MarkBundleUnloaded(Bundle);
     }
+    ReleaseUnneededAssets(NeededAssets);
     
-    int64 TotalDependencyMemory = 0;
-    
-    // Process each dependency
-    for (const FCustomAssetDependency& Dependency : Asset->Dependencies)
+    // LoadBundle only requests the assets that are not resident yet
+    bool bAnyIncomingRefused = false;
+    for (const FName& BundleId : IncomingBundleIds)
     {
-        // Skip already processed assets to avoid circular dependencies
-        if (ProcessedAssets.Contains(Dependency.DependentAssetId))
-        {
-            continue;
-        }
-        
-        // Mark this dependency as processed
-        ProcessedAssets.Add(Dependency.DependentAssetId);
-        
-        // Get the dependent asset
-        UCustomAssetBase* DependentAsset = GetAssetById(Dependency.DependentAssetId);
-        if (DependentAsset)
+        UCustomAssetBundle* Bundle = GetBundleById(BundleId);
+        if (::IsValid(Bundle) && !Bundle->bIsLoaded)
         {
-            // Base memory for this dependency
-            int64 DependencyMemory = 10 * 1024; // 10 KB base size
-            
-            // Add memory for strings
-            DependencyMemory += DependentAsset->DisplayName.ToString().Len() * sizeof(TCHAR);
-            DependencyMemory += DependentAsset->Description.ToString().Len() * sizeof(TCHAR);
-            
-            // Add memory for arrays
-            DependencyMemory += DependentAsset->Tags.Num() * sizeof(FName);
-            DependencyMemory += DependentAsset->VersionHistory.Num() * sizeof(FAssetVersionChange);
-            
-            // Add this dependency's memory
-            TotalDependencyMemory += DependencyMemory;
+            LoadBundle(BundleId, Strategy);
             
-            // Recursively add this dependency's dependencies
-            TotalDependencyMemory += CalculateDependenciesMemoryUsage(DependentAsset, ProcessedAssets);
+            // A deferred or streaming load roots the members that are already resident; a refused one roots nothing
+            bAnyIncomingRefused |= Strategy != EAssetLoadingStrategy::LazyLoad && !Bundle->bIsLoaded
+                && !ActiveBundleLoads.Contains(BundleId) && !IsBundleLoadDeferred(BundleId);
+        }
+    }
+    
+    // Assets retained only for a refused bundle would be left without a root, so they go as well
+    if (bAnyIncomingRefused)
+    {
+        TSet<FName> StillNeeded;
+        for (const auto& Pair : Bundles)
+        {
+            UCustomAssetBundle* Bundle = Pair.Value;
+            if (::IsValid(Bundle) && (Bundle->bIsLoaded || ActiveBundleLoads.Contains(Pair.Key) || IsBundleLoadDeferred(Pair.Key)))
+            {
+                GatherBundleClosure(Bundle, StillNeeded);
+            }
+        }
+        ReleaseUnneededAssets(StillNeeded);
+    }
+    
+    UE_LOG(LogTemp, Log, TEXT("TransitionBundles: %d bundles out, %d in; %d assets loaded (~%lld KB), %d retained, %d released (%lld KB)"), 
+        ReleasedBundles.Num(), IncomingBundleIds.Num(), Result.AssetsLoaded, Result.BytesLoaded / 1024, 
+        Result.AssetsRetained, Result.AssetsReleased, Result.BytesReleased / 1024);
+    
+    return Result;
+}
+
+void UCustomAssetManager::ScanForBundles()
+{
+    LLM_SCOPE_BYTAG(CustomAssets_Bundles);
+    
+    // Get the asset registry module
+    FAssetRegistryModule& AssetRegistryModule = FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry");
+    IAssetRegistry& AssetRegistry = AssetRegistryModule.Get();
+
+    // Wait for asset discovery to complete
+    UE_LOG(LogTemp, Warning, TEXT("[CRITICAL] ScanForBundles: Waiting for Asset Registry completion..."));
+    AssetRegistry.WaitForCompletion();
+
+    // Get all assets derived from UCustomAssetBundle
+    TArray<FAssetData> BundleData;
+    FTopLevelAssetPath BundleClassPath = UCustomAssetBundle::StaticClass()->GetClassPathName();
+    
+    UE_LOG(LogTemp, Warning, TEXT("[CRITICAL] ScanForBundles: Searching for bundles with class path %s..."), *BundleClassPath.ToString());
+    AssetRegistry.GetAssetsByClass(BundleClassPath, BundleData, true);
+
+    UE_LOG(LogTemp, Warning, TEXT("[CRITICAL] ScanForBundles: Found %d asset bundles"), BundleData.Num());
+
+    // Clear existing bundles map
+    Bundles.Empty();
+    AssetBundleIndex.Empty();
+
+    // Process each bundle
+    int32 LoadedBundleCount = 0;
+    for (const FAssetData& Data : BundleData)
+    {
+        // Log each bundle found
+        UE_LOG(LogTemp, Warning, TEXT("[CRITICAL] ScanForBundles: Processing bundle asset path: %s"), *Data.PackageName.ToString());
+        
+        // Load the bundle to get its ID
+        UCustomAssetBundle* Bundle = Cast<UCustomAssetBundle>(Data.GetAsset());
+        if (Bundle)
+        {
+            if (!Bundle->BundleId.IsNone())
+            {
+                // Log the bundle info
+                UE_LOG(LogTemp, Warning, TEXT("[CRITICAL] ScanForBundles: Loaded bundle with ID %s, name '%s', containing %d assets and %d loaded assets"), 
+                    *Bundle->BundleId.ToString(), 
+                    *Bundle->DisplayName.ToString(),
+                    Bundle->AssetIds.Num(),
+                    Bundle->Assets.Num());
+                
+                for (const FName& AssetId : Bundle->AssetIds)
+                {
+                    UE_LOG(LogTemp, Log, TEXT("      Asset ID in bundle: %s"), *AssetId.ToString());
+                }
+                
+                // Register the bundle
+                if (!Bundles.Contains(Bundle->BundleId))
+                {
+                    RegisterBundle(Bundle);
+                    LoadedBundleCount++;
+                }
+                else
+                {
+                    UE_LOG(LogTemp, Warning, TEXT("[CRITICAL] ScanForBundles: Duplicate bundle ID %s found, skipping"), *Bundle->BundleId.ToString());
+                }
+            }
+            else
+            {
+                UE_LOG(LogTemp, Warning, TEXT("[CRITICAL] ScanForBundles: Bundle %s has no ID assigned, assigning new ID"), *Data.AssetName.ToString());
+                // Generate a new ID
+                FGuid NewGuid = FGuid::NewGuid();
+                Bundle->BundleId = FName(*NewGuid.ToString());
+                
+                // Try to register with new ID
+                RegisterBundle(Bundle);
+                LoadedBundleCount++;
+            }
+        }
+        else
+        {
+            UE_LOG(LogTemp, Warning, TEXT("[CRITICAL] ScanForBundles: Failed to load bundle asset %s"), *Data.PackageName.ToString());
+        }
+    }
+    
+    UE_LOG(LogTemp, Warning, TEXT("[CRITICAL] ScanForBundles: Successfully registered %d/%d bundles"), LoadedBundleCount, BundleData.Num());
+    
+    // Additional check to see if bundles are really in the map
+    TArray<UCustomAssetBundle*> AllBundles;
+    GetAllBundles(AllBundles);
+    UE_LOG(LogTemp, Warning, TEXT("[CRITICAL] ScanForBundles: Bundles map contains %d bundles after scan"), AllBundles.Num());
+    
+    // Log all bundles now in the map
+    for (UCustomAssetBundle* Bundle : AllBundles)
+    {
+        if (Bundle)
+        {
+            UE_LOG(LogTemp, Warning, TEXT("[CRITICAL] Bundle in map: ID=%s, Name='%s', Assets=%d"), 
+                *Bundle->BundleId.ToString(), 
+                *Bundle->DisplayName.ToString(),
+                Bundle->AssetIds.Num());
+        }
+    }
+}
+
+void UCustomAssetManager::PreloadBundles()
+{
+    LLM_SCOPE_BYTAG(CustomAssets_LoadedAssets);
+    
+    // Get all bundles
+    TArray<UCustomAssetBundle*> AllBundles;
+    GetAllBundles(AllBundles);
+
+    // Early exit if no bundles
+    if (AllBundles.Num() == 0)
+    {
+        return;
+    }
+
+    // Sort bundles by priority (higher priority first)
+    AllBundles.Sort([](const UCustomAssetBundle& A, const UCustomAssetBundle& B) {
+        return A.Priority > B.Priority;
+    });
+
+    // Collect all bundles marked for preloading
+    TArray<UCustomAssetBundle*> BundlesToPreload;
+    BundlesToPreload.Reserve(AllBundles.Num() / 2); // Estimate half will be preloaded
+    
+    for (UCustomAssetBundle* Bundle : AllBundles)
+    {
+        if (::IsValid(Bundle) && Bundle->bPreloadAtStartup)
+        {
+            BundlesToPreload.Add(Bundle);
+        }
+    }
+    
+    // Early exit if no bundles to preload
+    if (BundlesToPreload.Num() == 0)
+    {
+        return;
+    }
+    
+    UE_LOG(LogTemp, Log, TEXT("Preloading %d bundles"), BundlesToPreload.Num());
+    
+    // Preloaded assets are kept reachable by their bundles, not as direct loads
+    TGuardValue<int32> InternalLoadGuard(InternalLoadDepth, InternalLoadDepth + 1);
+    
+    // Bundles that are never unloaded are rooted and clustered so GC barely looks at them
+    if (bPlacePermanentBundlesInDisregardPool)
+    {
+        TArray<UCustomAssetBundle*> PermanentBundles = BundlesToPreload.FilterByPredicate([](const UCustomAssetBundle* Bundle) {
+            return Bundle->bKeepInMemory;
+        });
+        
+        for (UCustomAssetBundle* LoadedBundle : PreloadPermanentBundles(PermanentBundles))
+        {
+            BundlesToPreload.Remove(LoadedBundle);
+        }
+        
+        if (BundlesToPreload.Num() == 0)
+        {
+            return;
+        }
+    }
+    
+    // For a small number of bundles, load them individually
+    if (BundlesToPreload.Num() < 3)
+    {
+        for (UCustomAssetBundle* Bundle : BundlesToPreload)
+        {
+            UE_LOG(LogTemp, Log, TEXT("Preloading bundle: %s"), *Bundle->BundleId.ToString());
+            LoadBundle(Bundle->BundleId, EAssetLoadingStrategy::Preload);
+        }
+    }
+    else
+    {
+        // For a larger number of bundles, batch load all assets
+        TArray<FSoftObjectPath> AllAssetPaths;
+        // Estimate average of 10 assets per bundle
+        AllAssetPaths.Reserve(BundlesToPreload.Num() * 10);
+        
+        // Collect all asset paths from all bundles to preload
+        for (UCustomAssetBundle* Bundle : BundlesToPreload)
+        {
+            UE_LOG(LogTemp, Log, TEXT("Adding bundle %s to preload batch"), *Bundle->BundleId.ToString());
+            
+            if (!Bundle->Manifest.IsUpToDate(Bundle->AssetIds))
+            {
+                RefreshBundleManifest(Bundle, GIsEditor);
+            }
+            
+            // Include the hard dependency closure, dependencies first
+            for (const FName& AssetId : Bundle->Manifest.LoadOrder)
+            {
+                FSoftObjectPath* AssetPath = AssetPathMap.Find(AssetId);
+                if (AssetPath)
+                {
+                    AllAssetPaths.AddUnique(*AssetPath);
+                }
+            }
+        }
+        
+        // Batch load all assets
+        if (AllAssetPaths.Num() > 0)
+        {
+            UE_LOG(LogTemp, Log, TEXT("Batch preloading %d assets from %d bundles"), 
+                AllAssetPaths.Num(), BundlesToPreload.Num());
+                
+            FStreamableManager& StreamableMgr = UAssetManager::GetStreamableManager();
+            StreamableMgr.RequestSyncLoad(AllAssetPaths);
+            
+            // Register the loaded assets bundle by bundle so startup memory is attributed to the bundle that brought it in
+            TSet<FName> RegisteredAssetIds;
+            for (UCustomAssetBundle* Bundle : BundlesToPreload)
+            {
+                FScopedAssetLoadContext LoadContext(MemoryTracker, NAME_None, Bundle->BundleId, TEXT("PreloadBundles"));
+                
+                for (const FName& AssetId : Bundle->Manifest.LoadOrder)
+                {
+                    bool bAlreadyRegistered = false;
+                    RegisteredAssetIds.Add(AssetId, &bAlreadyRegistered);
+                    
+                    const FSoftObjectPath* AssetPath = AssetPathMap.Find(AssetId);
+                    if (bAlreadyRegistered || !AssetPath || !AssetPath->IsValid())
+                    {
+                        continue;
+                    }
+                    
+                    if (UCustomAssetBase* Asset = Cast<UCustomAssetBase>(AssetPath->ResolveObject()))
+                    {
+                        RegisterAsset(Asset);
+                    }
+                }
+            }
+            
+            // Mark all bundles as loaded
+            for (UCustomAssetBundle* Bundle : BundlesToPreload)
+            {
+                Bundle->bIsLoaded = true;
+                BuildBundleRuntimeData(Bundle);
+                CreateBundleGCCluster(Bundle);
+            }
+        }
+    }
+}
+
+// DEPENDENCY FUNCTIONS
+
+void UCustomAssetManager::LoadDependencies(const FName& AssetId, bool bLoadHardDependenciesOnly, EAssetLoadingStrategy Strategy)
+{
+    LLM_SCOPE_BYTAG(CustomAssets_LoadedAssets);
+    
+    UCustomAssetBase* Asset = GetAssetById(AssetId);
+    if (!::IsValid(Asset))
+    {
+        UE_LOG(LogTemp, Warning, TEXT("Asset with ID %s not loaded, cannot load dependencies"), *AssetId.ToString());
+        return;
+    }
+
+    // Get dependencies to load
+    TArray<FName> DependenciesToLoad;
+    
+    if (bLoadHardDependenciesOnly)
+    {
+        // Only load hard dependencies
+        DependenciesToLoad = Asset->GetHardDependencies();
+    }
+    else
+    {
+        // Load all dependencies
+        DependenciesToLoad.Reserve(Asset->Dependencies.Num());
+        for (const FCustomAssetDependency& Dependency : Asset->Dependencies)
+        {
+            DependenciesToLoad.Add(Dependency.DependentAssetId);
+        }
+    }
+
+    // Dependencies are kept reachable through their dependents, not as direct loads
+    TGuardValue<int32> InternalLoadGuard(InternalLoadDepth, InternalLoadDepth + 1);
+
+    // Load each dependency - but only if not already loaded
+    for (const FName& DependencyId : DependenciesToLoad)
+    {
+        // Skip if already loaded (optimization to avoid redundant loads)
+        if (GetAssetById(DependencyId) != nullptr)
+        {
+            continue;
+        }
+        
+        LoadAssetByIdWithStrategy(DependencyId, Strategy);
+    }
+}
+
+TArray<FName> UCustomAssetManager::GetDependentAssets(const FName& AssetId, bool bHardDependenciesOnly) const
+{
+    TArray<FName> DependentAssets;
+    
+    UCustomAssetBase* Asset = GetAssetById(AssetId);
+    if (!Asset)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("Asset with ID %s not loaded, cannot get dependent assets"), *AssetId.ToString());
+        return DependentAssets;
+    }
+
+    // Get dependent assets
+    for (const FCustomAssetDependency& Dependency : Asset->DependentAssets)
+    {
+        if (!bHardDependenciesOnly || Dependency.bHardDependency)
+        {
+            DependentAssets.Add(Dependency.DependentAssetId);
+        }
+    }
+
+    return DependentAssets;
+}
+
+bool UCustomAssetManager::CanUnloadAsset(const FName& AssetId) const
+{
+    UCustomAssetBase* Asset = GetAssetById(AssetId);
+    if (!Asset)
+    {
+        // Asset not loaded, so it can be "unloaded"
+        return true;
+    }
+
+    // Assets of permanent bundles stay resident for the process lifetime
+    if (PermanentAssets.Contains(AssetId))
+    {
+        return false;
+    }
+
+    // Check if any loaded assets have a hard dependency on this asset
+    for (const FCustomAssetDependency& Dependency : Asset->DependentAssets)
+    {
+        if (Dependency.bHardDependency && LoadedAssets.Contains(Dependency.DependentAssetId))
+        {
+            // Found a loaded asset with a hard dependency on this asset
+            return false;
+        }
+    }
+
+    // No loaded assets have a hard dependency on this asset
+    return true;
+}
+
+void UCustomAssetManager::UpdateDependencies()
+{
+    LLM_SCOPE_BYTAG(CustomAssets_Manager);
+    
+    // Clear all dependent assets
+    TArray<UCustomAssetBase*> AllAssets = GetAllLoadedAssets();
+    for (UCustomAssetBase* Asset : AllAssets)
+    {
+        Asset->DependentAssets.Empty();
+    }
+
+    // Register dependencies for all loaded assets
+    for (UCustomAssetBase* Asset : AllAssets)
+    {
+        RegisterAssetDependencies(Asset);
+    }
+}
+
+//=================================================================
+// BUNDLE REFERENCE COUNTING IMPLEMENTATION
+//=================================================================
+
+void UCustomAssetManager::AcquireBundle(FName BundleId, FName OwnerId, EAssetLoadingStrategy Strategy)
+{
+    LLM_SCOPE_BYTAG(CustomAssets_Bundles);
+    
+    if (BundleId.IsNone() || OwnerId.IsNone())
+    {
+        UE_LOG(LogTemp, Warning, TEXT("Cannot acquire bundle: Invalid bundle ID or owner"));
+        return;
+    }
+    
+    UCustomAssetBundle* Bundle = GetBundleById(BundleId);
+    if (!::IsValid(Bundle))
+    {
+        UE_LOG(LogTemp, Warning, TEXT("Cannot acquire bundle %s: Bundle not found"), *BundleId.ToString());
+        return;
+    }
+    
+    FBundleReferenceState& Reference = BundleReferences.FindOrAdd(BundleId);
+    bool bAlreadyOwned = false;
+    Reference.Owners.Add(OwnerId, &bAlreadyOwned);
+    
+    // Reacquiring a lingering bundle keeps it without a reload
+    Reference.LingerDeadline = 0.0;
+    
+    if (!bAlreadyOwned)
+    {
+        UE_LOG(LogTemp, Verbose, TEXT("Bundle %s acquired by %s (%d owners)"), 
+            *BundleId.ToString(), *OwnerId.ToString(), Reference.Owners.Num());
+    }
+    
+    // Load on any acquire, the bundle may have been unloaded directly through UnloadBundle
+    if (!Bundle->bIsLoaded && !ActiveBundleLoads.Contains(BundleId) && !IsBundleLoadDeferred(BundleId))
+    {
+        LoadBundle(BundleId, Strategy);
+    }
+}
+
+void UCustomAssetManager::ReleaseBundle(FName BundleId, FName OwnerId, bool bUnloadImmediately)
+{
+    FBundleReferenceState* Reference = BundleReferences.Find(BundleId);
+    if (!Reference || Reference->Owners.Remove(OwnerId) == 0)
+    {
+        return;
+    }
+    
+    UE_LOG(LogTemp, Verbose, TEXT("Bundle %s released by %s (%d owners)"), 
+        *BundleId.ToString(), *OwnerId.ToString(), Reference->Owners.Num());
+    
+    if (Reference->Owners.Num() > 0)
+    {
+        return;
+    }
+    
+    if (bUnloadImmediately || BundleLingerSeconds <= 0.0f)
+    {
+        BundleReferences.Remove(BundleId);
+        UnloadBundle(BundleId);
+        return;
+    }
+    
+    Reference->LingerDeadline = GetBundleReleaseTime() + BundleLingerSeconds;
+}
+
+void UCustomAssetManager::ReleaseAllBundlesForOwner(FName OwnerId)
+{
+    TArray<FName> OwnedBundleIds;
+    for (const auto& Pair : BundleReferences)
+    {
+        if (Pair.Value.Owners.Contains(OwnerId))
+        {
+            OwnedBundleIds.Add(Pair.Key);
+        }
+    }
+    
+    for (const FName& BundleId : OwnedBundleIds)
+    {
+        ReleaseBundle(BundleId, OwnerId);
+    }
+}
+
+int32 UCustomAssetManager::GetBundleReferenceCount(FName BundleId) const
+{
+    const FBundleReferenceState* Reference = BundleReferences.Find(BundleId);
+    return Reference ? Reference->Owners.Num() : 0;
+}
+
+TArray<FName> UCustomAssetManager::GetBundleOwners(FName BundleId) const
+{
+    const FBundleReferenceState* Reference = BundleReferences.Find(BundleId);
+    return Reference ? Reference->Owners.Array() : TArray<FName>();
+}
+
+void UCustomAssetManager::SetBundleLingerTime(float Seconds)
+{
+    BundleLingerSeconds = FMath::Max(0.0f, Seconds);
+}
+
+FName UCustomAssetManager::GetLevelBundleOwner(FName LevelName)
+{
+    return FName(*FString::Printf(TEXT("Level.%s"), *LevelName.ToString()));
+}
+
+FName UCustomAssetManager::GetStreamingRegionBundleOwner(FName RegionName)
+{
+    return FName(*FString::Printf(TEXT("Region.%s"), *RegionName.ToString()));
+}
+
+FName UCustomAssetManager::GetDataLayerBundleOwner(FName DataLayerName)
+{
+    return FName(*FString::Printf(TEXT("DataLayer.%s"), *DataLayerName.ToString()));
+}
+
+FName UCustomAssetManager::GetPredictionBundleOwner()
+{
+    return FName(TEXT("Prediction"));
+}
+
+void UCustomAssetManager::ProcessLingeringBundles()
+{
+    if (BundleReferences.Num() == 0)
+    {
+        return;
+    }
+    
+    const double Now = GetBundleReleaseTime();
+    TArray<FName> ExpiredBundleIds;
+    for (auto It = BundleReferences.CreateIterator(); It; ++It)
+    {
+        if (It.Value().Owners.Num() > 0)
+        {
+            continue;
+        }
+        
+        // World time restarts with each world, so a deadline from a previous one starts the wait over
+        It.Value().LingerDeadline = FMath::Min(It.Value().LingerDeadline, Now + BundleLingerSeconds);
+        if (It.Value().LingerDeadline <= Now)
+        {
+            ExpiredBundleIds.Add(It.Key());
+            It.RemoveCurrent();
+        }
+    }
+    
+    for (const FName& BundleId : ExpiredBundleIds)
+    {
+        UE_LOG(LogTemp, Log, TEXT("Bundle %s has no owners left, unloading"), *BundleId.ToString());
+        UnloadBundle(BundleId);
+    }
+}
+
+//=================================================================
+// REACHABILITY IMPLEMENTATION
+//=================================================================
+
+void UCustomAssetManager::PinAsset(const FName& AssetId)
+{
+    LLM_SCOPE_BYTAG(CustomAssets_Manager);
+    
+    if (!AssetId.IsNone())
+    {
+        PinnedAssets.Add(AssetId);
+    }
+}
+
+void UCustomAssetManager::UnpinAsset(const FName& AssetId)
+{
+    if (PinnedAssets.Remove(AssetId) > 0)
+    {
+        bReachabilityDirty = true;
+    }
+}
+
+bool UCustomAssetManager::IsAssetPinned(const FName& AssetId) const
+{
+    return PinnedAssets.Contains(AssetId);
+}
+
+TArray<FName> UCustomAssetManager::GetReachabilityRoots() const
+{
+    TSet<FName> Roots;
+    GatherReachabilityRoots(Roots);
+    return Roots.Array();
+}
+
+int32 UCustomAssetManager::CollectUnreachableAssets()
+{
+    // Restart from a fresh pass and run it to completion
+    ReachabilityPhase = EReachabilityPhase::Idle;
+    bReachabilityDirty = true;
+    
+    int32 CollectedCount = 0;
+    do
+    {
+        CollectedCount += StepReachabilityCollection(MAX_int32);
+    }
+    while (ReachabilityPhase != EReachabilityPhase::Idle);
+    
+    return CollectedCount;
+}
+
+void UCustomAssetManager::SetReachabilityCollectionEnabled(bool bEnabled)
+{
+    bReachabilityCollectionEnabled = bEnabled;
+}
+
+void UCustomAssetManager::GatherReachabilityRoots(TSet<FName>& OutRoots) const
+{
+    OutRoots.Append(DirectLoadRoots);
+    OutRoots.Append(PinnedAssets);
+    OutRoots.Append(PermanentAssets);
+    
+    for (const TPair<FName, double>& Pair : PrefetchedAssets)
+    {
+        OutRoots.Add(Pair.Key);
+    }
+    
+    // Members of bundles kept in memory are never collected
+    for (const TPair<FName, UCustomAssetBundle*>& Pair : Bundles)
+    {
+        if (::IsValid(Pair.Value) && Pair.Value->bKeepInMemory)
+        {
+            OutRoots.Append(Pair.Value->AssetIds);
+        }
+    }
+    
+    // Loaded bundles root all of their members and the hard dependencies resolved when they were loaded
+    for (const TPair<FName, UCustomAssetBundle*>& Pair : Bundles)
+    {
+        if (::IsValid(Pair.Value) && Pair.Value->bIsLoaded)
+        {
+            OutRoots.Append(Pair.Value->AssetIds);
+            
+            if (const FBundleRuntimeData* RuntimeData = GetBundleRuntimeData(Pair.Key))
+            {
+                OutRoots.Append(RuntimeData->ExternalHardDependencyIds);
+            }
+        }
+    }
+    
+    // Bundles still streaming or waiting for memory keep the members that are already resident
+    for (const TPair<FName, FBundleLoadState>& Pair : ActiveBundleLoads)
+    {
+        if (const UCustomAssetBundle* Bundle = GetBundleById(Pair.Key))
+        {
+            OutRoots.Append(Bundle->AssetIds);
+        }
+    }
+    for (const TPair<FName, EAssetLoadingStrategy>& Entry : DeferredBundleLoads)
+    {
+        if (const UCustomAssetBundle* Bundle = GetBundleById(Entry.Key))
+        {
+            OutRoots.Append(Bundle->AssetIds);
+        }
+    }
+    
+    // Bundles associated with loaded levels root their members even while still streaming
+    for (const FBundleLevelAssociation& Association : LevelBundleAssociations)
+    {
+        if (LoadedLevels.Contains(Association.LevelName))
+        {
+            const UCustomAssetBundle* Bundle = GetBundleById(Association.BundleId);
+            if (::IsValid(Bundle))
+            {
+                OutRoots.Append(Bundle->AssetIds);
+            }
+        }
+    }
+    
+    // Regions whose cells are loaded root their bundles the same way
+    for (const TPair<FName, FName>& RegionBundle : ActiveStreamingRegionBundles)
+    {
+        const UCustomAssetBundle* Bundle = GetBundleById(RegionBundle.Key);
+        if (::IsValid(Bundle))
+        {
+            OutRoots.Append(Bundle->AssetIds);
+        }
+    }
+    
+    // And so do active Data Layers
+    for (const FBundleDataLayerAssociation& Association : DataLayerBundleAssociations)
+    {
+        if (ActiveDataLayers.Contains(Association.DataLayerName))
+        {
+            const UCustomAssetBundle* Bundle = GetBundleById(Association.BundleId);
+            if (::IsValid(Bundle))
+            {
+                OutRoots.Append(Bundle->AssetIds);
+            }
+        }
+    }
+}
+
+int32 UCustomAssetManager::StepReachabilityCollection(int32 Budget)
+{
+    int32 CollectedCount = 0;
+    
+    switch (ReachabilityPhase)
+    {
+    case EReachabilityPhase::Idle:
+        {
+            if (!bReachabilityDirty)
+            {
+                break;
+            }
+            
+            // Start a new pass from the current roots
+            bReachabilityDirty = false;
+            ReachableAssets.Reset();
+            GatherReachabilityRoots(ReachableAssets);
+            ReachabilityMarkStack = ReachableAssets.Array();
+            ReachabilityPhase = EReachabilityPhase::Mark;
+        }
+        break;
+        
+    case EReachabilityPhase::Mark:
+        {
+            // Follow hard dependency edges from the roots
+            for (int32 Processed = 0; Processed < Budget && ReachabilityMarkStack.Num() > 0; ++Processed)
+            {
+                const FName AssetId = ReachabilityMarkStack.Pop(EAllowShrinking::No);
+                const UCustomAssetBase* Asset = LoadedAssets.FindRef(AssetId);
+                if (!::IsValid(Asset))
+                {
+                    continue;
+                }
+                
+                for (const FCustomAssetDependency& Dependency : Asset->Dependencies)
+                {
+                    if (!Dependency.bHardDependency)
+                    {
+                        continue;
+                    }
+                    
+                    bool bAlreadyReachable = false;
+                    ReachableAssets.Add(Dependency.DependentAssetId, &bAlreadyReachable);
+                    if (!bAlreadyReachable)
+                    {
+                        ReachabilityMarkStack.Add(Dependency.DependentAssetId);
+                    }
+                }
+            }
+            
+            if (ReachabilityMarkStack.Num() == 0)
+            {
+                LoadedAssets.GetKeys(ReachabilitySweepQueue);
+                ReachabilityRequeuedAt.Reset();
+                ReachabilitySweepCollected = 0;
+                ReachabilityPhase = EReachabilityPhase::Sweep;
+            }
+        }
+        break;
+        
+    case EReachabilityPhase::Sweep:
+        {
+            // Unload loaded assets that no root reaches
+            for (int32 Processed = 0; Processed < Budget && ReachabilitySweepQueue.Num() > 0; ++Processed)
+            {
+                const FName AssetId = ReachabilitySweepQueue.Pop(EAllowShrinking::No);
+                if (ReachableAssets.Contains(AssetId))
+                {
+                    continue;
+                }
+                
+                if (!LoadedAssets.Contains(AssetId) || PinnedAssets.Contains(AssetId) || PermanentAssets.Contains(AssetId))
+                {
+                    continue;
+                }
+                
+                // A dependent still waiting in the queue blocks this asset; retry it once the sweep has made progress
+                if (!CanUnloadAsset(AssetId))
+                {
+                    const int32* RequeuedAt = ReachabilityRequeuedAt.Find(AssetId);
+                    if (!RequeuedAt || *RequeuedAt < ReachabilitySweepCollected)
+                    {
+                        ReachabilityRequeuedAt.Add(AssetId, ReachabilitySweepCollected);
+                        ReachabilitySweepQueue.Insert(AssetId, 0);
+                    }
+                    continue;
+                }
+                
+                // Same path as an explicit unload; the asset was no root, so no new pass is needed for it
+                const bool bWasDirty = bReachabilityDirty;
+                if (UnloadAssetById(AssetId))
+                {
+                    ++CollectedCount;
+                    ++ReachabilitySweepCollected;
+                    if (MemoryTracker)
+                    {
+                        MemoryTracker->RecordEviction(AssetId);
+                    }
+                    UE_LOG(LogTemp, Verbose, TEXT("Collected unreachable asset %s"), *AssetId.ToString());
+                }
+                bReachabilityDirty = bWasDirty;
+            }
+            
+            if (ReachabilitySweepQueue.Num() == 0)
+            {
+                ReachabilityRequeuedAt.Reset();
+                ReachableAssets.Reset();
+                ReachabilityPhase = EReachabilityPhase::Idle;
+            }
+        }
+        break;
+    }
+    
+    if (CollectedCount > 0)
+    {
+        UE_LOG(LogTemp, Log, TEXT("Reachability collector unloaded %d unreachable assets"), CollectedCount);
+    }
+    
+    return CollectedCount;
+}
+
+bool UCustomAssetManager::Tick(float DeltaTime)
+{
+    LLM_SCOPE_BYTAG(CustomAssets_Manager);
+    
+    // Expired prefetches stop rooting their assets
+    const double Now = FPlatformTime::Seconds();
+    for (auto It = PrefetchedAssets.CreateIterator(); It; ++It)
+    {
+        if (It.Value() <= Now)
+        {
+            It.RemoveCurrent();
+            bReachabilityDirty = true;
+        }
+    }
+    
+    if (bReachabilityCollectionEnabled)
+    {
+        StepReachabilityCollection(ReachabilityStepBudget);
+    }
+    
+    // Sample the memory timeline at a fixed interval
+    TimelineSampleAccumulator += DeltaTime;
+    if (MemoryTracker && TimelineSampleInterval > 0.0f && TimelineSampleAccumulator >= TimelineSampleInterval)
+    {
+        TimelineSampleAccumulator = 0.0f;
+        
+        int64 PrefetchBytes = 0;
+        for (const auto& Pair : PrefetchedAssets)
+        {
+            PrefetchBytes += MemoryTracker->GetAssetMemoryStats(Pair.Key).MemoryUsage;
+        }
+        
+        int64 PinnedBytes = 0;
+        for (const FName& AssetId : PinnedAssets)
+        {
+            PinnedBytes += MemoryTracker->GetAssetMemoryStats(AssetId).MemoryUsage;
+        }
+        
+        MemoryTracker->RecordTimelineSample(PrefetchBytes, PinnedBytes);
+    }
+    
+    // Serve low or high detail variants according to the presentation budget
+    UpdatePresentationQuality();
+    
+    // Unload released bundles whose linger time has run out, then start deferred loads into the freed memory
+    ProcessLingeringBundles();
+    RetryDeferredBundleLoads();
+    
+    // Write the next slice of an asynchronous SaveAllBundles
+    ProcessPendingBundleSaves(BundleSaveTimeBudgetMs);
+    
+    // Prefetch bundles of the likely next levels while the disk is idle
+    ProcessPredictivePrefetches();
+    
+#if !UE_BUILD_SHIPPING
+    // Audit residency periodically in development builds, right after a garbage collection when the result is exact.
+    // Referencer chains each walk the whole object graph, so they are left to CustomAssets.AuditResidency
+    ResidencyAuditAccumulator += DeltaTime;
+    if (bPeriodicResidencyAudits && ResidencyAuditor && ResidencyAuditInterval > 0.0f && ResidencyAuditAccumulator >= ResidencyAuditInterval
+        && ResidencyAuditor->HasCollectedGarbageSinceLastAudit())
+    {
+        ResidencyAuditAccumulator = 0.0f;
+        
+        const FAssetResidencyReport Report = ResidencyAuditor->RunAudit(this, false);
+        if (Report.CountIssues(EAssetResidencyIssueType::ResidentAfterUnload) > 0 || Report.CountIssues(EAssetResidencyIssueType::LoadedNotResident) > 0)
+        {
+            UCustomAssetResidencyAuditor::LogReport(Report);
+        }
+    }
+#endif
+    
+    // Keep ticking
+    return true;
+}
+
+bool FBundleRuntimeData::ContainsMember(const FName& AssetId) const
+{
+    return Algo::BinarySearch(MemberIds, AssetId, FNameFastLess()) != INDEX_NONE;
+}
+
+const FBundleRuntimeData* UCustomAssetManager::GetBundleRuntimeData(const FName& BundleId) const
+{
+    const TUniquePtr<FBundleRuntimeData>* RuntimeData = BundleRuntimeData.Find(BundleId);
+    return RuntimeData ? RuntimeData->Get() : nullptr;
+}
+
+void UCustomAssetManager::BuildBundleRuntimeData(UCustomAssetBundle* Bundle)
+{
+    LLM_SCOPE_BYTAG(CustomAssets_Bundles);
+    
+    if (!::IsValid(Bundle))
+    {
+        return;
+    }
+    
+    // Gather external hard dependencies in a scratch set, only the final arrays go into the arena
+    TArray<FName> SortedMembers = Bundle->AssetIds;
+    SortedMembers.Sort(FNameFastLess());
+    
+    TSet<FName> ExternalDependencies;
+    if (Bundle->Manifest.bIsBuilt)
+    {
+        // The manifest already holds the transitive hard dependency closure
+        for (const FName& AssetId : Bundle->Manifest.LoadOrder)
+        {
+            if (Algo::BinarySearch(SortedMembers, AssetId, FNameFastLess()) == INDEX_NONE)
+            {
+                ExternalDependencies.Add(AssetId);
+            }
+        }
+    }
+    else
+    {
+        for (const FName& AssetId : SortedMembers)
+        {
+            const UCustomAssetBase* Asset = LoadedAssets.FindRef(AssetId);
+            if (!::IsValid(Asset))
+            {
+                continue;
+            }
+            
+            for (const FCustomAssetDependency& Dependency : Asset->Dependencies)
+            {
+                if (Dependency.bHardDependency && Algo::BinarySearch(SortedMembers, Dependency.DependentAssetId, FNameFastLess()) == INDEX_NONE)
+                {
+                    ExternalDependencies.Add(Dependency.DependentAssetId);
+                }
+            }
+        }
+    }
+    
+    TArray<FName> SortedDependencies = ExternalDependencies.Array();
+    SortedDependencies.Sort(FNameFastLess());
+    
+    // Size the first arena block so a bundle normally needs a single heap allocation
+    const SIZE_T ArenaBytes = SortedMembers.Num() * (sizeof(FName) + sizeof(int64)) + SortedDependencies.Num() * sizeof(FName) + 64;
+    TUniquePtr<FBundleRuntimeData> RuntimeData = MakeUnique<FBundleRuntimeData>(ArenaBytes);
+    
+    RuntimeData->MemberIds = RuntimeData->Arena.CopyArray<FName>(SortedMembers);
+    RuntimeData->ExternalHardDependencyIds = RuntimeData->Arena.CopyArray<FName>(SortedDependencies);
+    RuntimeData->MemberMemory = RuntimeData->Arena.AllocArray<int64>(SortedMembers.Num());
+    
+    if (MemoryTracker)
+    {
+        for (int32 i = 0; i < SortedMembers.Num(); ++i)
+        {
+            RuntimeData->MemberMemory[i] = MemoryTracker->GetAssetMemoryStats(SortedMembers[i]).MemoryUsage;
+            RuntimeData->EstimatedMemory += RuntimeData->MemberMemory[i];
+        }
+    }
+    
+    BundleRuntimeData.Add(Bundle->BundleId, MoveTemp(RuntimeData));
+}
+
+void UCustomAssetManager::CreateBundleGCCluster(UCustomAssetBundle* Bundle)
+{
+    // Permanent bundles always cluster so GC checks them as one object
+    const bool bPermanent = ::IsValid(Bundle) && DisregardForGCReport.BundleIds.Contains(Bundle->BundleId);
+    if (!::IsValid(Bundle) || (!Bundle->bCreateGCCluster && !bPermanent))
+    {
+        return;
+    }
+    
+    // Only assets that actually finished loading can be cluster members
+    TArray<UCustomAssetBase*> LoadedMembers;
+    LoadedMembers.Reserve(Bundle->AssetIds.Num());
+    for (const FName& AssetId : Bundle->AssetIds)
+    {
+        UCustomAssetBase* Asset = LoadedAssets.FindRef(AssetId);
+        if (::IsValid(Asset))
+        {
+            LoadedMembers.Add(Asset);
+        }
+    }
+    
+    Bundle->CreateGCCluster(LoadedMembers, bPermanent);
+}
+
+bool UCustomAssetManager::ExportDependencyGraph(const FString& FilePath) const
+{
+    FString DotContent = "digraph AssetDependencies {\n";
+    DotContent += "  rankdir=LR;\n";
+    DotContent += "  node [shape=box, style=filled, fillcolor=lightblue];\n\n";
+
+    // Add nodes for all assets
+    TArray<FName> AssetIds = GetAllAssetIds();
+    for (const FName& AssetId : AssetIds)
+    {
+        DotContent += FString::Printf(TEXT("  \"%s\";\n"), *AssetId.ToString());
+    }
+
+    DotContent += "\n";
+
+    // Add edges for dependencies
+    for (const FName& AssetId : AssetIds)
+    {
+        UCustomAssetBase* Asset = GetAssetById(AssetId);
+        if (Asset)
+        {
+            for (const FCustomAssetDependency& Dependency : Asset->Dependencies)
+            {
+                FString EdgeStyle = Dependency.bHardDependency ? "solid" : "dashed";
+                FString EdgeColor = Dependency.bHardDependency ? "black" : "gray";
+                
+                DotContent += FString::Printf(TEXT("  \"%s\" -> \"%s\" [label=\"%s\", style=%s, color=%s];\n"),
+                    *AssetId.ToString(),
+                    *Dependency.DependentAssetId.ToString(),
+                    *Dependency.DependencyType.ToString(),
+                    *EdgeStyle,
+                    *EdgeColor);
+            }
+        }
+    }
+
+    DotContent += "}\n";
+
+    // Write the DOT file
+    return FFileHelper::SaveStringToFile(DotContent, *FilePath);
+}
+
+void UCustomAssetManager::RegisterAssetDependencies(UCustomAssetBase* Asset)
+{
+    LLM_SCOPE_BYTAG(CustomAssets_Manager);
+    
+    if (!Asset)
+    {
+        return;
+    }
+
+    // Register this asset as a dependent for each of its dependencies
+    for (const FCustomAssetDependency& Dependency : Asset->Dependencies)
+    {
+        UCustomAssetBase* DependentAsset = GetAssetById(Dependency.DependentAssetId);
+        if (DependentAsset)
+        {
+            DependentAsset->AddDependentAsset(Asset->AssetId, Dependency.DependencyType, Dependency.bHardDependency);
+        }
+    }
+}
+
+void UCustomAssetManager::UnregisterAssetDependencies(UCustomAssetBase* Asset)
+{
+    if (!Asset)
+    {
+        return;
+    }
+
+    // Unregister this asset as a dependent for each of its dependencies
+    for (const FCustomAssetDependency& Dependency : Asset->Dependencies)
+    {
+        UCustomAssetBase* DependentAsset = GetAssetById(Dependency.DependentAssetId);
+        if (DependentAsset)
+        {
+            DependentAsset->RemoveDependentAsset(Asset->AssetId);
+        }
+    }
+}
+
+// MEMORY MANAGEMENT FUNCTIONS
+
+void UCustomAssetManager::SetMemoryManagementPolicy(EMemoryManagementPolicy Policy)
+{
+    MemoryPolicy = Policy;
+}
+
+void UCustomAssetManager::SetMemoryUsageThreshold(int32 ThresholdMB)
+{
+    // Convert megabytes to bytes
+    MemoryThreshold = static_cast<int64>(ThresholdMB) * 1024 * 1024;
+}
+
+int32 UCustomAssetManager::GetCurrentMemoryUsage() const
+{
+    if (!MemoryTracker)
+    {
+        return 0;
+    }
+    
+    // Convert bytes to megabytes
+    return static_cast<int32>(MemoryTracker->GetLoadedMemoryUsage() / (1024 * 1024));
+}
+
+int32 UCustomAssetManager::GetMemoryUsageThreshold() const
+{
+    // Convert bytes to megabytes
+    return static_cast<int32>(MemoryThreshold / (1024 * 1024));
+}
+
+void UCustomAssetManager::ManageMemoryUsage()
+{
+    if (!MemoryTracker)
+    {
+        return;
+    }
+    
+    // Enforce pool budgets first so an overflowing pool only evicts its own assets
+    EnforceBudgetPools();
+    
+    if (MemoryPolicy == EMemoryManagementPolicy::KeepAll)
+    {
+        return;
+    }
+    
+    // Get the current memory usage
+    int64 CurrentUsage = MemoryTracker->GetLoadedMemoryUsage();
+    
+    // Check if we need to free memory - add a threshold buffer to avoid frequent memory management
+    // Only trigger memory management if we're significantly over the threshold (10% buffer)
+    if (CurrentUsage > (MemoryThreshold * 1.1))
+    {
+        // Calculate how much memory to free (target is 80% of threshold)
+        int64 TargetUsage = MemoryThreshold * 0.8;
+        int64 MemoryToFree = CurrentUsage - TargetUsage;
+        
+        // Convert to megabytes for the function call
+        int32 MemoryToFreeMB = static_cast<int32>(MemoryToFree / (1024 * 1024));
+        
+        // Free memory
+        UnloadAssetsToFreeMemory(MemoryToFreeMB);
+    }
+}
+
+void UCustomAssetManager::UnloadAssetsToFreeMemory(int32 MemoryToFreeMB)
+{
+    if (!MemoryTracker || MemoryToFreeMB <= 0)
+    {
+        return;
+    }
+    
+    // Convert megabytes to bytes
+    int64 MemoryToFree = static_cast<int64>(MemoryToFreeMB) * 1024 * 1024;
+    
+    // Get assets to unload based on the memory policy
+    TArray<FName> AssetsToUnload = GetEvictionCandidates(MemoryPolicy);
+    
+    // Unload assets until we free enough memory
+    int64 MemoryFreed = UnloadCandidatesToFreeMemory(AssetsToUnload, MemoryToFree);
+    
+    // Log the total memory freed
+    UE_LOG(LogTemp, Verbose, TEXT("Memory management freed %lld bytes of memory"), MemoryFreed);
+}
+
+TArray<FName> UCustomAssetManager::GetEvictionCandidates(EMemoryManagementPolicy Policy, FName PoolId) const
+{
+    TArray<FName> Result;
+    if (!MemoryTracker)
+    {
+        return Result;
+    }
+    
+    // Only loaded assets (optionally restricted to a pool and its nested pools) can be evicted
+    TArray<FAssetMemoryStats> Candidates;
+    for (const FAssetMemoryStats& Stats : MemoryTracker->GetAllMemoryStats())
+    {
+        if (!Stats.bIsLoaded || !LoadedAssets.Contains(Stats.AssetId))
+        {
+            continue;
+        }
+        
+        const FName AssetPoolId = AssetBudgetPoolAssignments.FindRef(Stats.AssetId);
+        if (!PoolId.IsNone() && !IsBudgetPoolWithin(AssetPoolId, PoolId))
+        {
+            continue;
+        }
+        
+        // Global eviction leaves assets alone whose pool enforces its own budget
+        if (PoolId.IsNone() && IsBudgetPoolManaged(AssetPoolId))
+        {
+            continue;
+        }
+        
+        Candidates.Add(Stats);
+    }
+    
+    switch (Policy)
+    {
+    case EMemoryManagementPolicy::UnloadLRU:
+        // Least recently used first
+        Candidates.Sort([](const FAssetMemoryStats& A, const FAssetMemoryStats& B) {
+            return A.LastAccessTime < B.LastAccessTime;
+        });
+        break;
+        
+    case EMemoryManagementPolicy::UnloadLFU:
+        // Least frequently used first
+        Candidates.Sort([](const FAssetMemoryStats& A, const FAssetMemoryStats& B) {
+            return A.AccessCount < B.AccessCount;
+        });
+        break;
+        
+    default:
+        return Result;
+    }
+    
+    Result.Reserve(Candidates.Num());
+    for (const FAssetMemoryStats& Stats : Candidates)
+    {
+        Result.Add(Stats.AssetId);
+    }
+    
+    return Result;
+}
+
+int64 UCustomAssetManager::UnloadCandidatesToFreeMemory(const TArray<FName>& Candidates, int64 MemoryToFree)
+{
+    int64 MemoryFreed = 0;
+    
+    for (const FName& AssetId : Candidates)
+    {
+        // Check if we've freed enough memory
+        if (MemoryFreed >= MemoryToFree)
+        {
+            break;
+        }
+        
+        // Check if the asset can be unloaded - skip if not
+        if (!LoadedAssets.Contains(AssetId) || !CanUnloadAsset(AssetId))
+        {
+            continue;
+        }
+        
+        // Get the memory usage before unloading
+        FAssetMemoryStats AssetStats = MemoryTracker->GetAssetMemoryStats(AssetId);
+        
+        // Unload the asset and track memory freed
+        if (UnloadAssetById(AssetId))
+        {
+            MemoryFreed += AssetStats.MemoryUsage;
+            MemoryTracker->RecordEviction(AssetId);
+            
+            UE_LOG(LogTemp, Verbose, TEXT("Unloaded asset %s to free memory, freed %lld bytes"), 
+                *AssetId.ToString(), AssetStats.MemoryUsage);
+        }
+    }
+    
+    return MemoryFreed;
+}
+
+bool UCustomAssetManager::ExportMemoryUsageToCSV(const FString& FilePath) const
+{
+    if (!MemoryTracker)
+    {
+        return false;
+    }
+    
+    return MemoryTracker->ExportMemoryStatsToCSV(FilePath);
+}
+
+void UCustomAssetManager::SetTimelineSampleInterval(float IntervalSeconds)
+{
+    TimelineSampleInterval = FMath::Max(0.0f, IntervalSeconds);
+    TimelineSampleAccumulator = 0.0f;
+}
+
+bool UCustomAssetManager::ExportMemoryTimeline(const FString& FilePath, bool bBinary) const
+{
+    if (!MemoryTracker)
+    {
+        return false;
+    }
+    
+    return bBinary ? MemoryTracker->ExportTimelineToBinary(FilePath) : MemoryTracker->ExportTimelineToCSV(FilePath);
+}
+
+UCustomAssetMemoryTracker* UCustomAssetManager::GetMemoryTracker() const
+{
+    return MemoryTracker;
+}
+
+FAssetResidencyReport UCustomAssetManager::RunResidencyAudit(bool bCollectGarbageFirst)
+{
+    if (!ResidencyAuditor)
+    {
+        return FAssetResidencyReport();
+    }
+    
+    // Unregistered assets stay resident until the next collection, so collect first for an exact result
+    if (bCollectGarbageFirst)
+    {
+        CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+    }
+    
+    const FAssetResidencyReport Report = ResidencyAuditor->RunAudit(this);
+    UCustomAssetResidencyAuditor::LogReport(Report);
+    return Report;
+}
+
+void UCustomAssetManager::SetResidencyAuditInterval(float IntervalSeconds)
+{
+    ResidencyAuditInterval = FMath::Max(0.0f, IntervalSeconds);
+    ResidencyAuditAccumulator = 0.0f;
+}
+
+UCustomAssetResidencyAuditor* UCustomAssetManager::GetResidencyAuditor() const
+{
+    return ResidencyAuditor;
+}
+
+void UCustomAssetManager::SetCoAccessRecordingEnabled(bool bEnabled)
+{
+    bRecordCoAccess = bEnabled;
+    if (CoAccessRecorder)
+    {
+        CoAccessRecorder->WindowSeconds = CoAccessWindowSeconds;
+    }
+}
+
+bool UCustomAssetManager::SaveCoAccessTrace(const FString& FilePath)
+{
+    if (!CoAccessRecorder)
+    {
+        return false;
+    }
+    
+    return CoAccessRecorder->SaveTrace(FilePath.IsEmpty() ? UCustomAssetCoAccessRecorder::GetDefaultTracePath() : FilePath);
+}
+
+UCustomAssetCoAccessRecorder* UCustomAssetManager::GetCoAccessRecorder() const
+{
+    return CoAccessRecorder;
+}
+
+bool UCustomAssetManager::SaveLevelTransitionModel(const FString& FilePath)
+{
+    if (!LevelTransitionModel)
+    {
+        return false;
+    }
+    
+    return LevelTransitionModel->SaveModel(FilePath.IsEmpty() ? UCustomAssetLevelTransitionModel::GetDefaultModelPath() : FilePath);
+}
+
+UCustomAssetLevelTransitionModel* UCustomAssetManager::GetLevelTransitionModel() const
+{
+    return LevelTransitionModel;
+}
+
+FName UCustomAssetManager::GetActiveLevelName() const
+{
+    const UWorld* World = GetGameWorld();
+    return World ? FName(*UWorld::RemovePIEPrefix(World->GetMapName())) : NAME_None;
+}
+
+UWorld* UCustomAssetManager::GetGameWorld() const
+{
+    if (!GEngine)
+    {
+        return nullptr;
+    }
+    
+    for (const FWorldContext& Context : GEngine->GetWorldContexts())
+    {
+        UWorld* World = Context.World();
+        if (World && (Context.WorldType == EWorldType::Game || Context.WorldType == EWorldType::PIE))
+        {
+            return World;
+        }
+    }
+    
+    return nullptr;
+}
+
+double UCustomAssetManager::GetBundleReleaseTime() const
+{
+    const UWorld* World = GetGameWorld();
+    return World ? World->GetTimeSeconds() : 0.0;
+}
+
+//=================================================================
+// MEMORY BUDGET POOLS IMPLEMENTATION
+//=================================================================
+
+bool UCustomAssetManager::RegisterBudgetPool(const FAssetBudgetPool& Pool)
+{
+    LLM_SCOPE_BYTAG(CustomAssets_Manager);
+    
+    if (Pool.PoolId.IsNone())
+    {
+        UE_LOG(LogTemp, Warning, TEXT("Cannot register budget pool with None ID"));
+        return false;
+    }
+    
+    // The parent pool must exist and must not be the pool itself or nested inside it
+    if (!Pool.ParentPoolId.IsNone())
+    {
+        const bool bParentExists = BudgetPools.ContainsByPredicate([&Pool](const FAssetBudgetPool& Existing) {
+            return Existing.PoolId == Pool.ParentPoolId;
+        });
+        
+        if (!bParentExists || IsBudgetPoolWithin(Pool.ParentPoolId, Pool.PoolId))
+        {
+            UE_LOG(LogTemp, Warning, TEXT("Cannot register budget pool %s: invalid parent pool %s"), 
+                *Pool.PoolId.ToString(), *Pool.ParentPoolId.ToString());
+            return false;
+        }
+    }
+    
+    FAssetBudgetPool* Existing = BudgetPools.FindByPredicate([&Pool](const FAssetBudgetPool& Candidate) {
+        return Candidate.PoolId == Pool.PoolId;
+    });
+    
+    if (Existing)
+    {
+        *Existing = Pool;
+    }
+    else
+    {
+        BudgetPools.Add(Pool);
+    }
+    
+    UE_LOG(LogTemp, Log, TEXT("Registered budget pool %s (parent: %s, limit: %d MB)"), 
+        *Pool.PoolId.ToString(), *Pool.ParentPoolId.ToString(), Pool.LimitMB);
+    
+    // Re-resolve pool assignments for everything that is currently loaded
+    AssetBudgetPoolAssignments.Empty(LoadedAssets.Num());
+    for (const TPair<FName, UCustomAssetBase*>& Pair : LoadedAssets)
+    {
+        AssetBudgetPoolAssignments.Add(Pair.Key, ResolveBudgetPool(Pair.Value));
+    }
+    
+    return true;
+}
+
+void UCustomAssetManager::UnregisterBudgetPool(FName PoolId)
+{
+    const int32 PoolIndex = BudgetPools.IndexOfByPredicate([PoolId](const FAssetBudgetPool& Pool) {
+        return Pool.PoolId == PoolId;
+    });
+    
+    if (PoolIndex == INDEX_NONE)
+    {
+        return;
+    }
+    
+    // Nested pools move up to the removed pool's parent
+    const FName ParentPoolId = BudgetPools[PoolIndex].ParentPoolId;
+    for (FAssetBudgetPool& Pool : BudgetPools)
+    {
+        if (Pool.ParentPoolId == PoolId)
+        {
+            Pool.ParentPoolId = ParentPoolId;
+        }
+    }
+    
+    BudgetPools.RemoveAt(PoolIndex);
+    
+    // Re-resolve pool assignments for everything that is currently loaded
+    AssetBudgetPoolAssignments.Empty(LoadedAssets.Num());
+    if (BudgetPools.Num() > 0)
+    {
+        for (const TPair<FName, UCustomAssetBase*>& Pair : LoadedAssets)
+        {
+            AssetBudgetPoolAssignments.Add(Pair.Key, ResolveBudgetPool(Pair.Value));
+        }
+    }
+    
+    UE_LOG(LogTemp, Log, TEXT("Unregistered budget pool %s"), *PoolId.ToString());
+}
+
+TArray<FAssetBudgetPool> UCustomAssetManager::GetAllBudgetPools() const
+{
+    return BudgetPools;
+}
+
+FName UCustomAssetManager::GetBudgetPoolForAsset(const FName& AssetId) const
+{
+    return AssetBudgetPoolAssignments.FindRef(AssetId);
+}
+
+int64 UCustomAssetManager::GetBudgetPoolUsage(FName PoolId) const
+{
+    if (!MemoryTracker || PoolId.IsNone())
+    {
+        return 0;
+    }
+    
+    int64 Usage = 0;
+    for (const TPair<FName, FName>& Pair : AssetBudgetPoolAssignments)
+    {
+        if (LoadedAssets.Contains(Pair.Key) && IsBudgetPoolWithin(Pair.Value, PoolId))
+        {
+            Usage += MemoryTracker->GetAssetMemoryStats(Pair.Key).MemoryUsage;
+        }
+    }
+    
+    return Usage;
+}
+
+FName UCustomAssetManager::ResolveBudgetPool(const UCustomAssetBase* Asset) const
+{
+    if (!Asset)
+    {
+        return NAME_None;
+    }
+    
+    FName BestPoolId = NAME_None;
+    int32 BestDepth = INDEX_NONE;
+    
+    for (const FAssetBudgetPool& Pool : BudgetPools)
+    {
+        // A nested pool only refines its parents, so every enclosing pool must match as well
+        bool bMatches = true;
+        FName CurrentPoolId = Pool.PoolId;
+        int32 Depth = 0;
+        while (!CurrentPoolId.IsNone() && bMatches)
+        {
+            const FAssetBudgetPool* CurrentPool = BudgetPools.FindByPredicate([CurrentPoolId](const FAssetBudgetPool& Candidate) {
+                return Candidate.PoolId == CurrentPoolId;
+            });
+            
+            if (!CurrentPool)
+            {
+                break;
+            }
+            
+            bMatches = DoesAssetMatchBudgetPool(Asset, *CurrentPool);
+            CurrentPoolId = CurrentPool->ParentPoolId;
+            ++Depth;
+        }
+        
+        // The deepest matching pool wins, ties go to the pool registered first
+        if (bMatches && Depth > BestDepth)
+        {
+            BestPoolId = Pool.PoolId;
+            BestDepth = Depth;
+        }
+    }
+    
+    return BestPoolId;
+}
+
+bool UCustomAssetManager::DoesAssetMatchBudgetPool(const UCustomAssetBase* Asset, const FAssetBudgetPool& Pool) const
+{
+    if (Pool.AssetClass && !Asset->IsA(Pool.AssetClass))
+    {
+        return false;
+    }
+    
+    if (!Pool.Tag.IsNone() && !Asset->Tags.Contains(Pool.Tag))
+    {
+        return false;
+    }
+    
+    if (!Pool.BundleId.IsNone())
+    {
+        // Loaded bundles answer membership from their sorted runtime data
+        if (const FBundleRuntimeData* RuntimeData = GetBundleRuntimeData(Pool.BundleId))
+        {
+            return RuntimeData->ContainsMember(Asset->AssetId);
+        }
+        
+        const UCustomAssetBundle* Bundle = GetBundleById(Pool.BundleId);
+        if (!Bundle || !Bundle->ContainsAsset(Asset->AssetId))
+        {
+            return false;
+        }
+    }
+    
+    return true;
+}
+
+int32 UCustomAssetManager::GetBudgetPoolDepth(FName PoolId) const
+{
+    int32 Depth = -1;
+    
+    // Bounded walk so a corrupted hierarchy can never loop forever
+    for (int32 Guard = 0; !PoolId.IsNone() && Guard <= BudgetPools.Num(); ++Guard)
+    {
+        const FAssetBudgetPool* Pool = BudgetPools.FindByPredicate([PoolId](const FAssetBudgetPool& Candidate) {
+            return Candidate.PoolId == PoolId;
+        });
+        
+        if (!Pool)
+        {
+            break;
+        }
+        
+        ++Depth;
+        PoolId = Pool->ParentPoolId;
+    }
+    
+    return Depth;
+}
+
+bool UCustomAssetManager::IsBudgetPoolManaged(FName PoolId) const
+{
+    for (int32 Guard = 0; !PoolId.IsNone() && Guard <= BudgetPools.Num(); ++Guard)
+    {
+        const FAssetBudgetPool* Pool = BudgetPools.FindByPredicate([PoolId](const FAssetBudgetPool& Candidate) {
+            return Candidate.PoolId == PoolId;
+        });
+        
+        if (!Pool)
+        {
+            break;
+        }
+        
+        if (Pool->LimitMB > 0 || Pool->EvictionPolicy == EMemoryManagementPolicy::KeepAll)
+        {
+            return true;
+        }
+        
+        PoolId = Pool->ParentPoolId;
+    }
+    
+    return false;
+}
+
+bool UCustomAssetManager::IsBudgetPoolWithin(FName PoolId, FName AncestorPoolId) const
+{
+    if (AncestorPoolId.IsNone())
+    {
+        return false;
+    }
+    
+    for (int32 Guard = 0; !PoolId.IsNone() && Guard <= BudgetPools.Num(); ++Guard)
+    {
+        if (PoolId == AncestorPoolId)
+        {
+            return true;
+        }
+        
+        const FAssetBudgetPool* Pool = BudgetPools.FindByPredicate([PoolId](const FAssetBudgetPool& Candidate) {
+            return Candidate.PoolId == PoolId;
+        });
+        
+        if (!Pool)
+        {
+            break;
+        }
+        
+        PoolId = Pool->ParentPoolId;
+    }
+    
+    return false;
+}
+
+void UCustomAssetManager::EnforceBudgetPools()
+{
+    if (BudgetPools.Num() == 0 || !MemoryTracker)
+    {
+        return;
+    }
+    
+    // Deepest pools first, so an overflow is resolved inside the offending pool before its parents
+    TArray<FAssetBudgetPool> SortedPools = BudgetPools;
+    SortedPools.Sort([this](const FAssetBudgetPool& A, const FAssetBudgetPool& B) {
+        return GetBudgetPoolDepth(A.PoolId) > GetBudgetPoolDepth(B.PoolId);
+    });
+    
+    for (const FAssetBudgetPool& Pool : SortedPools)
+    {
+        if (Pool.LimitMB <= 0 || Pool.EvictionPolicy == EMemoryManagementPolicy::KeepAll)
+        {
+            continue;
+        }
+        
+        const int64 Limit = static_cast<int64>(Pool.LimitMB) * 1024 * 1024;
+        const int64 Usage = GetBudgetPoolUsage(Pool.PoolId);
+        if (Usage <= Limit)
+        {
+            continue;
+        }
+        
+        // Free down to 80% of the pool limit, matching the global threshold behaviour
+        const int64 TargetUsage = static_cast<int64>(Limit * 0.8);
+        TArray<FName> Candidates = GetEvictionCandidates(Pool.EvictionPolicy, Pool.PoolId);
+        const int64 MemoryFreed = UnloadCandidatesToFreeMemory(Candidates, Usage - TargetUsage);
+        
+        UE_LOG(LogTemp, Log, TEXT("Budget pool %s was over its limit (%lld / %lld bytes), freed %lld bytes"), 
+            *Pool.PoolId.ToString(), Usage, Limit, MemoryFreed);
+    }
+}
+
+int64 UCustomAssetManager::EstimateAssetMemoryUsage(UCustomAssetBase* Asset) const
+{
+    if (!Asset)
+    {
+        return 0;
+    }
+    
+    // A very basic estimate based on the asset class
+    // In a real implementation, you would want to do more detailed analysis
+    
+    // Start with a base size
+    int64 MemoryUsage = 10 * 1024; // 10 KB base size
+    
+    // Add memory for strings
+    MemoryUsage += Asset->DisplayName.ToString().Len() * sizeof(TCHAR);
+    MemoryUsage += Asset->Description.ToString().Len() * sizeof(TCHAR);
+    
+    // Add memory for arrays
+    MemoryUsage += Asset->Tags.Num() * sizeof(FName);
+    MemoryUsage += Asset->Dependencies.Num() * sizeof(FCustomAssetDependency);
+    MemoryUsage += Asset->VersionHistory.Num() * sizeof(FAssetVersionChange);
+    
+    // Add memory used by dependencies (sub-assets)
+    TSet<FName> ProcessedAssets;
+    ProcessedAssets.Add(Asset->AssetId); // Avoid circular dependencies
+    MemoryUsage += CalculateDependenciesMemoryUsage(Asset, ProcessedAssets);
+    
+    // Add class-specific memory
+    // This would need to be customized for each asset type
+    // For example, for an item asset with textures:
+    /*
+    UCustomItemAsset* ItemAsset = Cast<UCustomItemAsset>(Asset);
+    if (ItemAsset && ItemAsset->Icon.IsValid())
+    {
+        // Estimate texture memory
+        UTexture2D* IconTexture = ItemAsset->Icon.Get();
+        if (IconTexture)
+        {
+            FTextureResource* Resource = IconTexture->Resource;
+            if (Resource)
+            {
+                MemoryUsage += Resource->GetResourceBulkDataSize();
+            }
+        }
+    }
+    */
+    
+    return MemoryUsage;
+}
+
+// New helper method to calculate memory used by dependencies recursively
+int64 UCustomAssetManager::CalculateDependenciesMemoryUsage(UCustomAssetBase* Asset, TSet<FName>& ProcessedAssets) const
+{
+    if (!Asset)
+    {
+        return 0;
+    }
+    
+    int64 TotalDependencyMemory = 0;
+    
+    // Process each dependency
+    for (const FCustomAssetDependency& Dependency : Asset->Dependencies)
+    {
+        // Skip already processed assets to avoid circular dependencies
+        if (ProcessedAssets.Contains(Dependency.DependentAssetId))
+        {
+            continue;
+        }
+        
+        // Mark this dependency as processed
+        ProcessedAssets.Add(Dependency.DependentAssetId);
+        
+        // Get the dependent asset
+        UCustomAssetBase* DependentAsset = GetAssetById(Dependency.DependentAssetId);
+        if (DependentAsset)
+        {
+            // Base memory for this dependency
+            int64 DependencyMemory = 10 * 1024; // 10 KB base size
+            
+            // Add memory for strings
+            DependencyMemory += DependentAsset->DisplayName.ToString().Len() * sizeof(TCHAR);
+            DependencyMemory += DependentAsset->Description.ToString().Len() * sizeof(TCHAR);
+            
+            // Add memory for arrays
+            DependencyMemory += DependentAsset->Tags.Num() * sizeof(FName);
+            DependencyMemory += DependentAsset->VersionHistory.Num() * sizeof(FAssetVersionChange);
+            
+            // Add this dependency's memory
+            TotalDependencyMemory += DependencyMemory;
+            
+            // Recursively add this dependency's dependencies
+            TotalDependencyMemory += CalculateDependenciesMemoryUsage(DependentAsset, ProcessedAssets);
         }
     }
     
     return TotalDependencyMemory;
 }
 
-// Implementation for the CreateBundle method
-UCustomAssetBundle* UCustomAssetManager::CreateBundle(const FString& BundleName)
+// Implementation for the CreateBundle method
+UCustomAssetBundle* UCustomAssetManager::CreateBundle(const FString& BundleName)
+{
+    LLM_SCOPE_BYTAG(CustomAssets_Bundles);
+    
+    UE_LOG(LogTemp, Warning, TEXT("UCustomAssetManager::CreateBundle - Creating bundle %s"), *BundleName);
+    
+    // Create a new bundle asset
+    UCustomAssetBundle* NewBundle = NewObject<UCustomAssetBundle>();
+    if (NewBundle)
+    {
+        // Initialize the bundle
+        NewBundle->BundleId = FName(*BundleName);
+        NewBundle->DisplayName = FText::FromString(BundleName);
+        NewBundle->bIsLoaded = false;
+        NewBundle->bPreloadAtStartup = false;
+        NewBundle->Priority = 0;
+        
+        // Add the bundle to our manager
+        AddBundle(NewBundle);
+    }
+    
+    return NewBundle;
+}
+
+// Implementation for the AddBundle method
+void UCustomAssetManager::AddBundle(UCustomAssetBundle* Bundle)
+{
+    LLM_SCOPE_BYTAG(CustomAssets_Bundles);
+    
+    if (Bundle && !Bundle->BundleId.IsNone())
+    {
+        UE_LOG(LogTemp, Warning, TEXT("UCustomAssetManager::AddBundle - Adding bundle %s"), *Bundle->BundleId.ToString());
+        
+        // Add to the bundle map
+        UnindexBundleAssets(Bundles.FindRef(Bundle->BundleId));
+        Bundles.Add(Bundle->BundleId, Bundle);
+        IndexBundleAssets(Bundle);
+    }
+}
+
+FDisregardForGCReport UCustomAssetManager::GetDisregardForGCReport() const
+{
+    return DisregardForGCReport;
+}
+
+TArray<UCustomAssetBundle*> UCustomAssetManager::PreloadPermanentBundles(const TArray<UCustomAssetBundle*>& InBundles)
+{
+    TArray<UCustomAssetBundle*> LoadedBundles;
+    if (InBundles.Num() == 0)
+    {
+        return LoadedBundles;
+    }
+    
+    // The engine closes the disregard-for-GC pool before the asset manager starts loading, so permanent bundles get the
+    // closest equivalent instead: the bundle is rooted and its members form a cluster GC checks as a single object
+    for (UCustomAssetBundle* Bundle : InBundles)
+    {
+        UE_LOG(LogTemp, Log, TEXT("Preloading permanent bundle %s"), *Bundle->BundleId.ToString());
+        LoadBundle(Bundle->BundleId, EAssetLoadingStrategy::Preload);
+        
+        if (!Bundle->bIsLoaded)
+        {
+            continue;
+        }
+        
+        LoadedBundles.Add(Bundle);
+        Bundle->AddToRoot();
+        DisregardForGCReport.BundleIds.Add(Bundle->BundleId);
+        PermanentAssets.Append(Bundle->AssetIds);
+        CreateBundleGCCluster(Bundle);
+        
+        // Measure what GC no longer traverses: object size plus the resources it owns exclusively
+        TArray<UObject*> PermanentObjects;
+        const FUObjectItem* RootItem = GUObjectArray.ObjectToObjectItem(Bundle);
+        if (Bundle->IsGCClusterRoot() && RootItem)
+        {
+            PermanentObjects.Add(Bundle);
+            for (const int32 ObjectIndex : GUObjectClusters[RootItem->GetClusterIndex()].Objects)
+            {
+                const FUObjectItem* ObjectItem = GUObjectArray.IndexToObject(ObjectIndex);
+                if (ObjectItem && ObjectItem->Object)
+                {
+                    PermanentObjects.Add(static_cast<UObject*>(ObjectItem->Object));
+                }
+            }
+        }
+        else
+        {
+            // Without a cluster (editor, gc.CreateGCClusters 0) the rooted bundle and its members are still never collected
+            PermanentObjects.Add(Bundle);
+            for (const FName& AssetId : Bundle->AssetIds)
+            {
+                if (UCustomAssetBase* Asset = LoadedAssets.FindRef(AssetId))
+                {
+                    PermanentObjects.Add(Asset);
+                }
+            }
+        }
+        
+        for (UObject* Object : PermanentObjects)
+        {
+            ++DisregardForGCReport.ObjectCount;
+            DisregardForGCReport.Bytes += Object->GetClass()->GetStructureSize() + Object->GetResourceSizeBytes(EResourceSizeMode::Exclusive);
+        }
+    }
+    
+    UE_LOG(LogTemp, Log, TEXT("Made %d bundles permanent: %d objects, %lld bytes"),
+        DisregardForGCReport.BundleIds.Num(), DisregardForGCReport.ObjectCount, DisregardForGCReport.Bytes);
+    
+    return LoadedBundles;
+}
+
+TArray<UCustomAssetBundle*> UCustomAssetManager::GetAllBundlesContainingAsset(const FName& AssetId) const
+{
+    TArray<UCustomAssetBundle*> Result;
+    
+    const TArray<FName>* BundleIds = AssetBundleIndex.Find(AssetId);
+    if (!BundleIds)
+    {
+        return Result;
+    }
+    
+    Result.Reserve(BundleIds->Num());
+    for (const FName& BundleId : *BundleIds)
+    {
+        // The membership check drops entries left behind by direct edits to a bundle's AssetIds
+        UCustomAssetBundle* Bundle = Bundles.FindRef(BundleId);
+        if (::IsValid(Bundle) && Bundle->ContainsAsset(AssetId))
+        {
+            Result.Add(Bundle);
+        }
+    }
+    
+    return Result;
+}
+
+void UCustomAssetManager::NotifyBundleAssetsChanged(const UCustomAssetBundle* Bundle, const TArray<FName>& AddedAssetIds, const TArray<FName>& RemovedAssetIds)
+{
+    // Only the registered instance of a bundle is indexed
+    UCustomAssetBundle* RegisteredBundle = Bundle ? Bundles.FindRef(Bundle->BundleId) : nullptr;
+    if (!RegisteredBundle || RegisteredBundle != Bundle)
+    {
+        return;
+    }
+    
+    // Runtime data of a loaded bundle describes its membership, so rebuild it rather than answer from stale arrays
+    if (BundleRuntimeData.Contains(Bundle->BundleId))
+    {
+        BundleRuntimeData.Remove(Bundle->BundleId);
+        BuildBundleRuntimeData(RegisteredBundle);
+    }
+    
+    // Pools selecting this bundle now match a different set of assets
+    const bool bBundleSelectsPool = BudgetPools.ContainsByPredicate([Bundle](const FAssetBudgetPool& Pool) {
+        return Pool.BundleId == Bundle->BundleId;
+    });
+    if (bBundleSelectsPool)
+    {
+        TArray<FName> ChangedAssetIds = AddedAssetIds;
+        ChangedAssetIds.Append(RemovedAssetIds);
+        for (const FName& AssetId : ChangedAssetIds)
+        {
+            if (const UCustomAssetBase* Asset = LoadedAssets.FindRef(AssetId))
+            {
+                AssetBudgetPoolAssignments.Add(AssetId, ResolveBudgetPool(Asset));
+            }
+        }
+    }
+    
+    for (const FName& AssetId : AddedAssetIds)
+    {
+        AssetBundleIndex.FindOrAdd(AssetId).AddUnique(Bundle->BundleId);
+    }
+    
+    for (const FName& AssetId : RemovedAssetIds)
+    {
+        if (TArray<FName>* BundleIds = AssetBundleIndex.Find(AssetId))
+        {
+            BundleIds->RemoveSingleSwap(Bundle->BundleId);
+            if (BundleIds->Num() == 0)
+            {
+                AssetBundleIndex.Remove(AssetId);
+            }
+        }
+    }
+}
+
+void UCustomAssetManager::IndexBundleAssets(UCustomAssetBundle* Bundle)
+{
+    if (!::IsValid(Bundle) || Bundle->BundleId.IsNone())
+    {
+        return;
+    }
+    
+    Bundle->RebuildMembershipSet();
+    for (const FName& AssetId : Bundle->AssetIds)
+    {
+        if (!AssetId.IsNone())
+        {
+            AssetBundleIndex.FindOrAdd(AssetId).AddUnique(Bundle->BundleId);
+        }
+    }
+}
+
+void UCustomAssetManager::UnindexBundleAssets(const UCustomAssetBundle* Bundle)
+{
+    if (!Bundle)
+    {
+        return;
+    }
+    
+    // AssetIds may have been edited since the bundle was indexed, so sweep the whole index instead of trusting it
+    for (auto It = AssetBundleIndex.CreateIterator(); It; ++It)
+    {
+        It->Value.RemoveSingleSwap(Bundle->BundleId);
+        if (It->Value.Num() == 0)
+        {
+            It.RemoveCurrent();
+        }
+    }
+}
+
+bool UCustomAssetManager::SaveBundle(UCustomAssetBundle* Bundle, const FString& PackagePath)
+{
+    LLM_SCOPE_BYTAG(CustomAssets_Bundles);
+    
+    FPendingBundleSave PendingSave;
+    bool bUnchanged = false;
+    if (!PrepareBundleSave(Bundle, PackagePath, PendingSave, bUnchanged))
+    {
+        return false;
+    }
+    
+    return bUnchanged || WriteBundlePackage(PendingSave, false);
+}
+
+bool UCustomAssetManager::PrepareBundleSave(UCustomAssetBundle* Bundle, const FString& PackagePath, FPendingBundleSave& OutSave, bool& bOutUnchanged)
+{
+    bOutUnchanged = false;
+    
+    if (!Bundle)
+    {
+        UE_LOG(LogTemp, Error, TEXT("SaveBundle: Cannot save null bundle"));
+        return false;
+    }
+    
+    // Add the IDs of loaded assets missing from AssetIds and keep the membership set in step
+    Bundle->RebuildMembershipSet();
+    
+    // Store the bundle ID and display name
+    FName OriginalBundleId = Bundle->BundleId;
+    FString OriginalDisplayName = Bundle->DisplayName.ToString();
+    
+    // Log the bundle state before saving
+    UE_LOG(LogTemp, Log, TEXT("SaveBundle: Saving bundle - ID: %s, Display Name: %s, Asset Count: %d"), 
+        *OriginalBundleId.ToString(), *OriginalDisplayName, Bundle->AssetIds.Num());
+    
+    // Make sure the bundle has a valid ID
+    if (OriginalBundleId.IsNone())
+    {
+        // Generate a new ID before saving
+        FGuid NewGuid = FGuid::NewGuid();
+        Bundle->BundleId = FName(*NewGuid.ToString());
+        OriginalBundleId = Bundle->BundleId; // Update our cached ID
+        UE_LOG(LogTemp, Log, TEXT("SaveBundle: Generated new ID: %s"), *OriginalBundleId.ToString());
+    }
+    
+    // Make sure the bundle has a valid display name
+    if (Bundle->DisplayName.IsEmpty())
+    {
+        Bundle->DisplayName = FText::FromString(OriginalDisplayName.IsEmpty() ? TEXT("New Bundle") : OriginalDisplayName);
+        OriginalDisplayName = Bundle->DisplayName.ToString(); // Update our cached display name
+        UE_LOG(LogTemp, Log, TEXT("SaveBundle: Fixed empty display name with: %s"), *OriginalDisplayName);
+    }
+    
+    // Store the original DisplayName explicitly to preserve it
+    FText PreservedDisplayName = Bundle->DisplayName;
+    
+    // Create a unique package name for the bundle
+    const FString FullPackagePath = MakeBundlePackagePath(OriginalBundleId, PackagePath);
+    const FString BundleName = FPackageName::GetShortName(FullPackagePath);
+    
+    // Nothing to write if this bundle is already the on-disk version and its content did not change
+    if (Bundle->GetOutermost()->GetName() == FullPackagePath && !Bundle->HasUnsavedChanges() 
+        && FPackageName::DoesPackageExist(FullPackagePath))
+    {
+        UE_LOG(LogTemp, Verbose, TEXT("SaveBundle: Bundle %s is unchanged, skipping package write"), *OriginalBundleId.ToString());
+        bOutUnchanged = true;
+        return true;
+    }
+    
+    UE_LOG(LogTemp, Log, TEXT("SaveBundle: Creating package at path: %s"), *FullPackagePath);
+    
+    // Make sure the folder exists
+    FString ContentDir = FPaths::ProjectContentDir();
+    FString RelativePath = FullPackagePath.Replace(TEXT("/Game/"), TEXT(""));
+    FString BundleDir = FPaths::GetPath(RelativePath);
+    FString FullBundleDir = FPaths::Combine(ContentDir, BundleDir);
+    
+    if (!FPlatformFileManager::Get().GetPlatformFile().DirectoryExists(*FullBundleDir))
+    {
+        FPlatformFileManager::Get().GetPlatformFile().CreateDirectoryTree(*FullBundleDir);
+    }
+    
+    // Create a new package for the bundle
+    UPackage* Package = CreatePackage(*FullPackagePath);
+    if (!Package)
+    {
+        UE_LOG(LogTemp, Error, TEXT("SaveBundle: Failed to create package for bundle %s"), *OriginalBundleId.ToString());
+        return false;
+    }
+    
+    Package->FullyLoad();
+    // Store a local copy of the asset IDs for transfer
+    TArray<FName> OriginalAssetIds = Bundle->AssetIds;
+    int32 OriginalAssetCount = OriginalAssetIds.Num();
+    TArray<UCustomAssetBase*> OriginalAssets = Bundle->Assets;
+
+    // Create a new bundle asset in the package, unless the bundle already is that asset;
+    // constructing an object over it would reset its properties before they are copied
+    const bool bIsPackageBundle = Bundle->GetOuter() == Package && Bundle->GetFName() == FName(*BundleName);
+    UCustomAssetBundle* SavedBundle = bIsPackageBundle ? Bundle : NewObject<UCustomAssetBundle>(Package, FName(*BundleName), RF_Public | RF_Standalone);
+    if (!SavedBundle)
+    {
+        UE_LOG(LogTemp, Error, TEXT("SaveBundle: Failed to create saved bundle object %s"), *OriginalBundleId.ToString());
+        return false;
+    }
+    
+
+    
+    UE_LOG(LogTemp, Log, TEXT("SaveBundle: Bundle has %d asset IDs to transfer"), OriginalAssetCount);
+    
+    // Copy the properties from the in-memory bundle to the saved bundle
+    SavedBundle->BundleId = OriginalBundleId;
+    SavedBundle->DisplayName = PreservedDisplayName;
+    SavedBundle->Description = Bundle->Description;
+    SavedBundle->bPreloadAtStartup = Bundle->bPreloadAtStartup;
+    SavedBundle->bKeepInMemory = Bundle->bKeepInMemory;
+    SavedBundle->bCreateGCCluster = Bundle->bCreateGCCluster;
+    SavedBundle->CriticalAssetIds = Bundle->CriticalAssetIds;
+    SavedBundle->Priority = Bundle->Priority;
+    SavedBundle->Tags = Bundle->Tags;
+    
+    // CRITICAL: Explicitly create a new array and add each asset ID individually
+    // This approach is more reliable than direct array assignment for serialization
+    SavedBundle->AssetIds.Empty(OriginalAssetCount);
+    for (const FName& AssetId : OriginalAssetIds)
+    {
+        if (!AssetId.IsNone())
+        {
+            SavedBundle->AssetIds.Add(AssetId);
+            UE_LOG(LogTemp, Verbose, TEXT("SaveBundle: Added asset ID %s to saved bundle"), *AssetId.ToString());
+        }
+    }
+    
+    // Ensure the asset IDs were copied correctly
+    if (SavedBundle->AssetIds.Num() != OriginalAssetCount)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("SaveBundle: Asset count mismatch! Original: %d, Saved: %d"), 
+            OriginalAssetCount, SavedBundle->AssetIds.Num());
+    }
+    
+    // Copy any loaded assets
+    if (OriginalAssets.Num() > 0)
+    {
+        SavedBundle->Assets.Empty(OriginalAssets.Num());
+        for (UCustomAssetBase* Asset : OriginalAssets)
+        {
+            if (Asset && !Asset->AssetId.IsNone())
+            {
+                SavedBundle->Assets.Add(Asset);
+                
+                // Make sure the Asset ID is also in the AssetIds array
+                if (!SavedBundle->AssetIds.Contains(Asset->AssetId))
+                {
+                    SavedBundle->AssetIds.Add(Asset->AssetId);
+                    UE_LOG(LogTemp, Log, TEXT("SaveBundle: Added missing asset ID %s from loaded asset"), *Asset->AssetId.ToString());
+                }
+            }
+        }
+    }
+    
+    SavedBundle->bIsLoaded = false; // Don't save loaded state
+    SavedBundle->RebuildMembershipSet();
+    
+    // Build the load manifest from the final asset list so it is saved alongside it
+    RefreshBundleManifest(SavedBundle, true);
+    
+    // The hash only becomes the saved one when the package is written, otherwise the next save would skip the edit
+    OutSave.ContentHash = SavedBundle->ComputeContentHash();
+    OutSave.PreviousContentHash = SavedBundle->SavedContentHash;
+    
+    // Verify the bundle has the correct data
+    UE_LOG(LogTemp, Log, TEXT("SaveBundle: Bundle to be saved has %d asset IDs and %d loaded assets"), 
+        SavedBundle->AssetIds.Num(), SavedBundle->Assets.Num());
+    
+    // DO NOT ADD DEFAULT ASSETS - This was causing the issue with bundles auto-including assets
+    // We want empty bundles to remain empty
+    
+    OutSave.BundleId = OriginalBundleId;
+    OutSave.SavedBundle = SavedBundle;
+    OutSave.PackagePath = FullPackagePath;
+    
+    return true;
+}
+
+bool UCustomAssetManager::WriteBundlePackage(const FPendingBundleSave& PendingSave, bool bAsync)
+{
+    LLM_SCOPE_BYTAG(CustomAssets_Bundles);
+    
+    UCustomAssetBundle* SavedBundle = PendingSave.SavedBundle.Get();
+    if (!SavedBundle)
+    {
+        UE_LOG(LogTemp, Error, TEXT("SaveBundle: Prepared bundle %s no longer exists"), *PendingSave.BundleId.ToString());
+        OnBundleSaved.Broadcast(PendingSave.BundleId, false);
+        return false;
+    }
+    
+    UPackage* Package = SavedBundle->GetOutermost();
+    
+    // Mark the package as dirty
+    Package->MarkPackageDirty();
+    
+    // Written with the package so the loaded bundle knows which content is on disk
+    SavedBundle->SavedContentHash = PendingSave.ContentHash;
+    
+    // Save the package; async saves serialize here and leave the file write to a background thread
+    bool bSuccess = false;
+    
+#if ENGINE_MAJOR_VERSION >= 5
+    FSavePackageArgs SaveArgs;
+    SaveArgs.TopLevelFlags = RF_Public | RF_Standalone;
+    SaveArgs.SaveFlags = SAVE_NoError | (bAsync ? SAVE_Async : SAVE_None);
+    bSuccess = UPackage::SavePackage(Package, SavedBundle, *PendingSave.PackagePath, SaveArgs);
+#else
+    bSuccess = UPackage::SavePackage(Package, SavedBundle, RF_Public | RF_Standalone, *PendingSave.PackagePath);
+#endif
+    
+    if (bSuccess)
+    {
+        UE_LOG(LogTemp, Log, TEXT("SaveBundle: Successfully saved bundle %s to %s"), 
+            *SavedBundle->BundleId.ToString(), *PendingSave.PackagePath);
+        
+        // Replace the in-memory bundle with the saved bundle in our map
+        if (Bundles.Contains(PendingSave.BundleId))
+        {
+            UnindexBundleAssets(Bundles[PendingSave.BundleId]);
+            Bundles[PendingSave.BundleId] = SavedBundle;
+        }
+        else
+        {
+            Bundles.Add(SavedBundle->BundleId, SavedBundle);
+        }
+        IndexBundleAssets(SavedBundle);
+    }
+    else
+    {
+        // The disk still holds the previous content, so the next save must not treat the edit as saved
+        SavedBundle->SavedContentHash = PendingSave.PreviousContentHash;
+        UE_LOG(LogTemp, Error, TEXT("SaveBundle: Failed to save bundle %s to %s"), *PendingSave.BundleId.ToString(), *PendingSave.PackagePath);
+    }
+    
+    OnBundleSaved.Broadcast(PendingSave.BundleId, bSuccess);
+    return bSuccess;
+}
+
+FString UCustomAssetManager::MakeBundlePackagePath(const FName& BundleId, const FString& PackagePath)
+{
+    const FString BasePath = PackagePath.IsEmpty() ? TEXT("/Game/Bundles") : PackagePath;
+    
+    // Make sure the object name is valid for UE
+    return FString::Printf(TEXT("%s/%s"), *BasePath, *BundleId.ToString()).Replace(TEXT("-"), TEXT("_"));
+}
+
+int32 UCustomAssetManager::SaveAllBundles(const FString& BasePath)
+{
+    LLM_SCOPE_BYTAG(CustomAssets_Bundles);
+    
+    if (IsSavingBundles())
+    {
+        UE_LOG(LogTemp, Warning, TEXT("SaveAllBundles: An asynchronous save is in progress, finishing it first"));
+        while (IsSavingBundles())
+        {
+            ProcessPendingBundleSaves(MAX_flt);
+        }
+    }
+    
+    // Default path if none provided
+    FString SavePath = BasePath.IsEmpty() ? TEXT("/Game/Bundles") : BasePath;
+    
+    TArray<FPendingBundleSave> PreparedSaves;
+    int32 UnchangedCount = 0;
+    PrepareAllBundleSaves(SavePath, PreparedSaves, UnchangedCount);
+    
+    // Serialize every package first and let the file writes overlap, then wait for them once
+    int32 SuccessCount = UnchangedCount;
+    for (const FPendingBundleSave& PendingSave : PreparedSaves)
+    {
+        if (WriteBundlePackage(PendingSave, true))
+        {
+            SuccessCount++;
+        }
+    }
+    UPackage::WaitForAsyncFileWrites();
+    
+    UE_LOG(LogTemp, Log, TEXT("Saved %d/%d bundles to %s (%d unchanged)"), SuccessCount, Bundles.Num(), *SavePath, UnchangedCount);
+    
+    return SuccessCount;
+}
+
+int32 UCustomAssetManager::SaveAllBundlesAsync(const FString& BasePath)
+{
+    LLM_SCOPE_BYTAG(CustomAssets_Bundles);
+    
+    if (IsSavingBundles())
+    {
+        UE_LOG(LogTemp, Warning, TEXT("SaveAllBundlesAsync: A save is already in progress"));
+        return 0;
+    }
+    
+    FString SavePath = BasePath.IsEmpty() ? TEXT("/Game/Bundles") : BasePath;
+    
+    BundleSaveProgress = FBundleSaveProgress();
+    NextPendingBundleSave = 0;
+    PendingBundleSavePath = SavePath;
+    
+    // Bundles are only queued here; each one is prepared right before it is written so later edits are not lost
+    Bundles.GenerateKeyArray(PendingBundleSaveIds);
+    BundleSaveProgress.TotalBundles = PendingBundleSaveIds.Num();
+    bBundleSaveInProgress = true;
+    
+    UE_LOG(LogTemp, Log, TEXT("SaveAllBundlesAsync: Saving %d bundles to %s"), BundleSaveProgress.TotalBundles, *SavePath);
+    
+    OnBundleSaveProgress.Broadcast(BundleSaveProgress);
+    
+    if (PendingBundleSaveIds.Num() == 0)
+    {
+        FinishBundleSaves(false);
+    }
+    
+    return BundleSaveProgress.TotalBundles;
+}
+
+void UCustomAssetManager::CancelSaveAllBundles()
+{
+    if (!IsSavingBundles())
+    {
+        return;
+    }
+    
+    UE_LOG(LogTemp, Log, TEXT("SaveAllBundlesAsync: Cancelled with %d bundles left"), PendingBundleSaveIds.Num() - NextPendingBundleSave);
+    FinishBundleSaves(true);
+}
+
+int32 UCustomAssetManager::PrepareAllBundleSaves(const FString& SavePath, TArray<FPendingBundleSave>& OutSaves, int32& OutUnchangedCount)
+{
+    TArray<UCustomAssetBundle*> AllBundles;
+    GetAllBundles(AllBundles);
+    
+    OutSaves.Reserve(OutSaves.Num() + AllBundles.Num());
+    OutUnchangedCount = 0;
+    int32 FailedCount = 0;
+    
+    for (UCustomAssetBundle* Bundle : AllBundles)
+    {
+        FPendingBundleSave PendingSave;
+        bool bUnchanged = false;
+        if (!PrepareBundleSave(Bundle, SavePath, PendingSave, bUnchanged))
+        {
+            FailedCount++;
+            OnBundleSaved.Broadcast(Bundle ? Bundle->BundleId : NAME_None, false);
+        }
+        else if (bUnchanged)
+        {
+            OutUnchangedCount++;
+        }
+        else
+        {
+            OutSaves.Add(MoveTemp(PendingSave));
+        }
+    }
+    
+    return FailedCount;
+}
+
+void UCustomAssetManager::ProcessPendingBundleSaves(float TimeBudgetMs)
+{
+    if (!bBundleSaveInProgress)
+    {
+        return;
+    }
+    
+    // Always handle at least one bundle so a tiny budget still makes progress
+    const double Deadline = FPlatformTime::Seconds() + TimeBudgetMs / 1000.0;
+    do
+    {
+        const FName BundleId = PendingBundleSaveIds[NextPendingBundleSave++];
+        
+        // Bundles removed since the save started are dropped from the total
+        UCustomAssetBundle* const* Bundle = Bundles.Find(BundleId);
+        if (!Bundle)
+        {
+            BundleSaveProgress.TotalBundles--;
+            continue;
+        }
+        
+        // Prepare against the registered bundle as it is now and write it in the same step
+        FPendingBundleSave PendingSave;
+        bool bUnchanged = false;
+        if (!PrepareBundleSave(*Bundle, PendingBundleSavePath, PendingSave, bUnchanged))
+        {
+            BundleSaveProgress.FailedBundles++;
+            OnBundleSaved.Broadcast(BundleId, false);
+        }
+        else if (bUnchanged)
+        {
+            BundleSaveProgress.UnchangedBundles++;
+        }
+        else if (WriteBundlePackage(PendingSave, true))
+        {
+            BundleSaveProgress.SavedBundles++;
+        }
+        else
+        {
+            BundleSaveProgress.FailedBundles++;
+        }
+    }
+    while (NextPendingBundleSave < PendingBundleSaveIds.Num() && FPlatformTime::Seconds() < Deadline);
+    
+    if (NextPendingBundleSave >= PendingBundleSaveIds.Num())
+    {
+        FinishBundleSaves(false);
+    }
+    else
+    {
+        OnBundleSaveProgress.Broadcast(BundleSaveProgress);
+    }
+}
+
+void UCustomAssetManager::FinishBundleSaves(bool bCancelled)
 {
-    UE_LOG(LogTemp, Warning, TEXT("UCustomAssetManager::CreateBundle - Creating bundle %s"), *BundleName);
+    // Packages serialized so far must be on disk before the save is reported as done
+    UPackage::WaitForAsyncFileWrites();
     
-    // Create a new bundle asset
-    UCustomAssetBundle* NewBundle = NewObject<UCustomAssetBundle>();
-    if (NewBundle)
+    PendingBundleSaveIds.Reset();
+    NextPendingBundleSave = 0;
+    bBundleSaveInProgress = false;
+    
+    BundleSaveProgress.bCancelled = bCancelled;
+    BundleSaveProgress.bComplete = true;
+    
+    UE_LOG(LogTemp, Log, TEXT("SaveAllBundlesAsync: %s, %d saved, %d failed, %d unchanged"), 
+        bCancelled ? TEXT("Cancelled") : TEXT("Finished"), BundleSaveProgress.SavedBundles, BundleSaveProgress.FailedBundles, BundleSaveProgress.UnchangedBundles);
+    
+    OnBundleSaveProgress.Broadcast(BundleSaveProgress);
+}
+
+bool UCustomAssetManager::DeleteBundle(const FName& BundleId)
+{
+    // Log entry for debugging
+    UE_LOG(LogTemp, Log, TEXT("DeleteBundle: Attempting to delete bundle with ID: %s"), *BundleId.ToString());
+    
+    // Special handling for None IDs - search for bundles with None ID
+    if (BundleId.IsNone())
     {
-        // Initialize the bundle
-        NewBundle->BundleId = FName(*BundleName);
-        NewBundle->DisplayName = FText::FromString(BundleName);
-        NewBundle->bIsLoaded = false;
-        NewBundle->bPreloadAtStartup = false;
-        NewBundle->Priority = 0;
+        UE_LOG(LogTemp, Warning, TEXT("DeleteBundle: Attempting to delete bundle with None ID"));
+        
+        // Find all bundles with None ID (this is an error condition but we'll try to recover)
+        TArray<UCustomAssetBundle*> BundlesToDelete;
+        for (const TPair<FName, UCustomAssetBundle*>& Pair : Bundles)
+        {
+            if (Pair.Key.IsNone() || (Pair.Value && Pair.Value->BundleId.IsNone()))
+            {
+                BundlesToDelete.Add(Pair.Value);
+            }
+        }
+        
+        if (BundlesToDelete.Num() == 0)
+        {
+            UE_LOG(LogTemp, Warning, TEXT("DeleteBundle: No bundles with None ID found"));
+            return false;
+        }
+        
+        // Remove all these problematic bundles
+        for (UCustomAssetBundle* Bundle : BundlesToDelete)
+        {
+            if (Bundle)
+            {
+                UE_LOG(LogTemp, Warning, TEXT("DeleteBundle: Removing bundle with None ID from memory"));
+                Bundles.Remove(FName());  // Remove the None key
+                // We can't delete the asset file because we don't know its path
+            }
+        }
+        
+        return true;
+    }
+
+    // Normal case - find the bundle by ID
+    UCustomAssetBundle* Bundle = GetBundleById(BundleId);
+    if (!Bundle)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("DeleteBundle: Bundle with ID %s not found"), *BundleId.ToString());
+        return false;
+    }
+
+    // Get the package path for the bundle
+    FString BundleName = BundleId.ToString().Replace(TEXT("-"), TEXT("_"));
+    FString PackagePath = FString::Printf(TEXT("/Game/Bundles/%s"), *BundleName);
+    
+    UE_LOG(LogTemp, Log, TEXT("DeleteBundle: Unregistering bundle %s"), *BundleId.ToString());
+    
+    // Unregister the bundle from the manager
+    UnregisterBundle(Bundle);
+    
+    // Delete the asset file from the content browser
+    bool bDeletedSuccessfully = false;
+    
+#if WITH_EDITOR
+    // In editor builds, use asset registry
+    FAssetRegistryModule& AssetRegistryModule = FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry");
+    FAssetData AssetData = AssetRegistryModule.Get().GetAssetByObjectPath(FSoftObjectPath(PackagePath));
+    
+    if (AssetData.IsValid())
+    {
+        UE_LOG(LogTemp, Log, TEXT("DeleteBundle: Found asset data for %s, attempting to delete"), *BundleId.ToString());
+        TArray<UObject*> ObjectsToDelete;
+        UObject* Asset = AssetData.GetAsset();
+        if (Asset)
+        {
+            ObjectsToDelete.Add(Asset);
+            bDeletedSuccessfully = ObjectTools::DeleteObjects(ObjectsToDelete, false) > 0;
+        }
+        else
+        {
+            UE_LOG(LogTemp, Warning, TEXT("DeleteBundle: Got AssetData but failed to load asset for %s"), *BundleId.ToString());
+            bDeletedSuccessfully = true; // Consider it a success if the asset is already gone
+        }
+    }
+    else
+    {
+        UE_LOG(LogTemp, Warning, TEXT("DeleteBundle: No AssetData found for %s"), *BundleId.ToString());
+        bDeletedSuccessfully = true; // Consider it a success if the asset is already gone
+    }
+#else
+    // In non-editor builds, just unregister the bundle
+    bDeletedSuccessfully = true;
+#endif
+    
+    if (bDeletedSuccessfully)
+    {
+        UE_LOG(LogTemp, Log, TEXT("DeleteBundle: Successfully deleted bundle %s"), *BundleId.ToString());
+    }
+    else
+    {
+        UE_LOG(LogTemp, Error, TEXT("DeleteBundle: Failed to delete bundle %s"), *BundleId.ToString());
+    }
+    
+    return bDeletedSuccessfully;
+}
+
+bool UCustomAssetManager::RenameBundle(const FName& BundleId, const FString& NewName)
+{
+    // Find the bundle by ID
+    UCustomAssetBundle* Bundle = GetBundleById(BundleId);
+    if (!Bundle)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("RenameBundle: Bundle with ID %s not found"), *BundleId.ToString());
+        return false;
+    }
+    
+    // Create a copy of the bundle with the new name/ID
+    UCustomAssetBundle* NewBundle = DuplicateObject<UCustomAssetBundle>(Bundle, GetTransientPackage());
+    if (!NewBundle)
+    {
+        UE_LOG(LogTemp, Error, TEXT("RenameBundle: Failed to duplicate bundle %s"), *BundleId.ToString());
+        return false;
+    }
+    
+    // Update the bundle's name properties
+    NewBundle->DisplayName = FText::FromString(NewName);
+    
+    // Generate a new bundle ID using GUID (or use the name if preferred)
+    FGuid NewGuid = FGuid::NewGuid();
+    FName NewBundleId = FName(*NewGuid.ToString());
+    NewBundle->BundleId = NewBundleId;
+    
+    UE_LOG(LogTemp, Log, TEXT("Renaming bundle from %s to %s (new ID: %s)"), 
+        *BundleId.ToString(), *NewName, *NewBundleId.ToString());
+    
+    // Copy all assets from old bundle to new bundle
+    NewBundle->AssetIds.Empty();
+    for (const FName& AssetId : Bundle->AssetIds)
+    {
+        if (!AssetId.IsNone())
+        {
+            NewBundle->AssetIds.Add(AssetId);
+        }
+    }
+    
+    // Register the new bundle
+    RegisterBundle(NewBundle);
+    
+    // Save the new bundle
+    if (!SaveBundle(NewBundle, TEXT("/Game/Bundles")))
+    {
+        UE_LOG(LogTemp, Error, TEXT("RenameBundle: Failed to save new bundle %s"), *NewBundleId.ToString());
+        
+        // Clean up on failure
+        UnregisterBundle(NewBundle);
+        return false;
+    }
+    
+    // Delete the old bundle
+    bool bDeleteResult = DeleteBundle(BundleId);
+    if (!bDeleteResult)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("RenameBundle: Failed to delete old bundle %s, but new bundle was created"), 
+            *BundleId.ToString());
+        // Continue with success even if old deletion failed
+    }
+    
+    UE_LOG(LogTemp, Log, TEXT("Successfully renamed bundle from %s to %s"), *BundleId.ToString(), *NewBundleId.ToString());
+    return true;
+}
+
+// Define the OnAssetLoaded method
+void UCustomAssetManager::OnAssetLoaded(FName AssetId, FSoftObjectPath AssetPath)
+{
+    LLM_SCOPE_BYTAG(CustomAssets_LoadedAssets);
+    
+    // Get the loaded asset
+    UCustomAssetBase* Asset = Cast<UCustomAssetBase>(AssetPath.ResolveObject());
+    if (::IsValid(Asset))
+    {
+        FScopedAssetLoadContext LoadContext(MemoryTracker, AssetId, NAME_None, TEXT("LoadAssetById (async)"));
+        
+        // Register the asset
+        RegisterAsset(Asset);
+        
+        // Load hard dependencies
+        LoadDependencies(AssetId, true, EAssetLoadingStrategy::Streaming);
+        
+        // Manage memory usage
+        ManageMemoryUsage();
+        
+        UE_LOG(LogTemp, Log, TEXT("Asset with ID %s loaded and registered"), *AssetId.ToString());
+    }
+}
+
+//=================================================================
+// ASSET PREFETCHING SYSTEM IMPLEMENTATION
+//=================================================================
+
+void UCustomAssetManager::PrefetchAssetsInRadius(FVector Location, float Radius, int32 MaxAssets)
+{
+    // Get assets within the radius
+    TArray<FName> NearbyAssetIds = GetAssetsInRadius(Location, Radius);
+    
+    // Early exit if no assets found
+    if (NearbyAssetIds.Num() == 0)
+    {
+        return;
+    }
+    
+    // Sort by distance from location
+    NearbyAssetIds.Sort([this, Location](const FName& A, const FName& B) {
+        float DistA = GetDistanceToAsset(A, Location);
+        float DistB = GetDistanceToAsset(B, Location);
+        return DistA < DistB;
+    });
+    
+    // Limit to max assets
+    if (NearbyAssetIds.Num() > MaxAssets)
+    {
+        NearbyAssetIds.SetNum(MaxAssets);
+    }
+    
+    // Prefetch the nearest assets
+    PrefetchAssets(NearbyAssetIds);
+    
+    UE_LOG(LogTemp, Log, TEXT("Prefetching %d assets in radius %.1f around location (%.1f, %.1f, %.1f)"),
+        NearbyAssetIds.Num(), Radius, Location.X, Location.Y, Location.Z);
+}
+
+void UCustomAssetManager::PrefetchAssets(const TArray<FName>& AssetIds)
+{
+    // Early exit if no assets
+    if (AssetIds.Num() == 0)
+    {
+        return;
+    }
+    
+    // Start a low-priority stream for each asset that isn't already loaded
+    for (const FName& AssetId : AssetIds)
+    {
+        // Skip if already loaded
+        if (GetAssetById(AssetId) != nullptr)
+        {
+            continue;
+        }
         
-        // Add the bundle to our manager
-        AddBundle(NewBundle);
+        // Stream with low priority
+        LowPriorityStreamAsset(AssetId);
     }
     
-    return NewBundle;
+    UE_LOG(LogTemp, Verbose, TEXT("Started prefetching %d assets"), AssetIds.Num());
 }
 
-// Implementation for the AddBundle method
-void UCustomAssetManager::AddBundle(UCustomAssetBundle* Bundle)
+void UCustomAssetManager::RegisterAssetLocation(const FName& AssetId, const FVector& WorldLocation)
 {
-    if (Bundle && !Bundle->BundleId.IsNone())
+    LLM_SCOPE_BYTAG(CustomAssets_Manager);
+    
+    if (!AssetId.IsNone())
     {
-        UE_LOG(LogTemp, Warning, TEXT("UCustomAssetManager::AddBundle - Adding bundle %s"), *Bundle->BundleId.ToString());
+        // Store or update the asset's world location
+        AssetLocations.Add(AssetId, WorldLocation);
         
-        // Add to the bundle map
-        Bundles.Add(Bundle->BundleId, Bundle);
+        UE_LOG(LogTemp, Verbose, TEXT("Registered asset %s at location (%.1f, %.1f, %.1f)"), 
+            *AssetId.ToString(), WorldLocation.X, WorldLocation.Y, WorldLocation.Z);
     }
 }
 
-TArray<UCustomAssetBundle*> UCustomAssetManager::GetAllBundlesContainingAsset(const FName& AssetId) const
+TArray<FName> UCustomAssetManager::GetAssetsInRadius(const FVector& Location, float Radius) const
 {
-    TArray<UCustomAssetBundle*> Result;
-    // Pre-allocate a reasonable size to avoid reallocations
-    Result.Reserve(5);  // Most assets are in a small number of bundles
+    TArray<FName> Result;
+    float RadiusSquared = Radius * Radius;
     
-    // Iterate through all bundles
-    for (const auto& Pair : Bundles)
+    // Check each asset with a registered location
+    for (const TPair<FName, FVector>& Pair : AssetLocations)
     {
-        UCustomAssetBundle* Bundle = Pair.Value;
-        if (::IsValid(Bundle) && Bundle->ContainsAsset(AssetId))
+        const FVector& AssetLocation = Pair.Value;
+        float DistanceSquared = FVector::DistSquared(Location, AssetLocation);
+        
+        // If within radius, add to result
+        if (DistanceSquared <= RadiusSquared)
         {
-            Result.Add(Bundle);
+            Result.Add(Pair.Key);
         }
     }
     
     return Result;
 }
 
-bool UCustomAssetManager::SaveBundle(UCustomAssetBundle* Bundle, const FString& PackagePath)
+float UCustomAssetManager::GetDistanceToAsset(const FName& AssetId, const FVector& FromLocation) const
 {
-    if (!Bundle)
+    // Look up the asset's registered location
+    const FVector* AssetLocation = AssetLocations.Find(AssetId);
+    
+    if (AssetLocation)
     {
-        UE_LOG(LogTemp, Error, TEXT("SaveBundle: Cannot save null bundle"));
-        return false;
+        // Return the distance
+        return FVector::Distance(FromLocation, *AssetLocation);
     }
     
-    // Check for assets in the Bundle->Assets array that might not be in AssetIds
-    for (UCustomAssetBase* Asset : Bundle->Assets)
+    // If no location registered, return a large value
+    return FLT_MAX;
+}
+
+void UCustomAssetManager::SetBundleAffinityPrefetchEnabled(bool bEnabled, int32 MaxAssets)
+{
+    bBundleAffinityPrefetch = bEnabled;
+    BundleAffinityPrefetchMaxAssets = FMath::Max(0, MaxAssets);
+}
+
+void UCustomAssetManager::ScheduleBundleAffinityPrefetch(const FName& AssetId)
+{
+    LLM_SCOPE_BYTAG(CustomAssets_LoadedAssets);
+    
+    // Loaded or loading bundles already bring their members in
+    TArray<UCustomAssetBundle*> ContainingBundles = GetAllBundlesContainingAsset(AssetId);
+    ContainingBundles.RemoveAll([this](const UCustomAssetBundle* Bundle)
     {
-        if (Asset && !Asset->AssetId.IsNone())
+        return Bundle->bIsLoaded || ActiveBundleLoads.Contains(Bundle->BundleId);
+    });
+    
+    if (ContainingBundles.Num() == 0)
+    {
+        return;
+    }
+    
+    // Siblings from the highest priority bundles are prefetched first
+    ContainingBundles.Sort([](const UCustomAssetBundle& A, const UCustomAssetBundle& B)
+    {
+        return A.Priority > B.Priority;
+    });
+    
+    int64 AvailableBytes = MemoryThreshold - (MemoryTracker ? MemoryTracker->GetLoadedMemoryUsage() : 0);
+    const double GraceDeadline = FPlatformTime::Seconds() + PrefetchRootGraceSeconds;
+    
+    TArray<FName> SiblingIds;
+    TArray<FSoftObjectPath> SiblingPaths;
+    for (const UCustomAssetBundle* Bundle : ContainingBundles)
+    {
+        for (const FName& SiblingId : Bundle->AssetIds)
         {
-            if (!Bundle->AssetIds.Contains(Asset->AssetId))
+            if (SiblingIds.Num() >= BundleAffinityPrefetchMaxAssets)
+            {
+                break;
+            }
+            
+            if (SiblingId == AssetId || LoadedAssets.Contains(SiblingId) || PrefetchedAssets.Contains(SiblingId) || SiblingIds.Contains(SiblingId))
+            {
+                continue;
+            }
+            
+            const FSoftObjectPath* SiblingPath = AssetPathMap.Find(SiblingId);
+            if (!SiblingPath || !SiblingPath->IsValid())
+            {
+                continue;
+            }
+            
+            // Stay inside the memory budget, a prefetch never causes eviction
+            const int64 SiblingBytes = EstimateManifestAssetBytes(SiblingId, nullptr);
+            if (SiblingBytes > AvailableBytes)
             {
-                UE_LOG(LogTemp, Warning, TEXT("SaveBundle: Found asset %s in Assets array but not in AssetIds array, adding it"), 
-                    *Asset->AssetId.ToString());
-                Bundle->AssetIds.Add(Asset->AssetId);
+                continue;
             }
+            AvailableBytes -= SiblingBytes;
+            
+            SiblingIds.Add(SiblingId);
+            SiblingPaths.Add(*SiblingPath);
+            
+            // Prefetched assets stay rooted for a grace period so they are not collected before first use
+            PrefetchedAssets.Add(SiblingId, GraceDeadline);
         }
     }
     
-    // Store the bundle ID and display name
-    FName OriginalBundleId = Bundle->BundleId;
-    FString OriginalDisplayName = Bundle->DisplayName.ToString();
+    if (SiblingPaths.Num() == 0)
+    {
+        return;
+    }
     
-    // Log the bundle state before saving
-    UE_LOG(LogTemp, Log, TEXT("SaveBundle: Saving bundle - ID: %s, Display Name: %s, Asset Count: %d"), 
-        *OriginalBundleId.ToString(), *OriginalDisplayName, Bundle->AssetIds.Num());
+    // One burst for all siblings instead of a cold miss per sibling
+    UAssetManager::GetStreamableManager().RequestAsyncLoad(
+        SiblingPaths,
+        FStreamableDelegate::CreateUObject(this, &UCustomAssetManager::OnBundleAffinityPrefetchLoaded, SiblingIds),
+        BundleAffinityPrefetchPriority
+    );
     
-    // Make sure the bundle has a valid ID
-    if (OriginalBundleId.IsNone())
+    UE_LOG(LogTemp, Verbose, TEXT("Prefetching %d bundle siblings of asset %s"), SiblingIds.Num(), *AssetId.ToString());
+}
+
+void UCustomAssetManager::OnBundleAffinityPrefetchLoaded(TArray<FName> AssetIds)
+{
+    LLM_SCOPE_BYTAG(CustomAssets_LoadedAssets);
+    
+    // Prefetched siblings are rooted by the grace period, not as direct loads
+    TGuardValue<int32> InternalLoadGuard(InternalLoadDepth, InternalLoadDepth + 1);
+    
+    for (const FName& AssetId : AssetIds)
     {
-        // Generate a new ID before saving
-        FGuid NewGuid = FGuid::NewGuid();
-        Bundle->BundleId = FName(*NewGuid.ToString());
-        OriginalBundleId = Bundle->BundleId; // Update our cached ID
-        UE_LOG(LogTemp, Log, TEXT("SaveBundle: Generated new ID: %s"), *OriginalBundleId.ToString());
+        const FSoftObjectPath* AssetPath = AssetPathMap.Find(AssetId);
+        UCustomAssetBase* Asset = AssetPath ? Cast<UCustomAssetBase>(AssetPath->ResolveObject()) : nullptr;
+        if (::IsValid(Asset) && LoadedAssets.FindRef(AssetId) != Asset)
+        {
+            FScopedAssetLoadContext LoadContext(MemoryTracker, AssetId, NAME_None, TEXT("BundleAffinityPrefetch"));
+            RegisterAsset(Asset);
+        }
     }
+}
+
+void UCustomAssetManager::LowPriorityStreamAsset(const FName& AssetId)
+{
+    LLM_SCOPE_BYTAG(CustomAssets_LoadedAssets);
     
-    // Make sure the bundle has a valid display name
-    if (Bundle->DisplayName.IsEmpty())
+    // Skip if already loaded
+    if (GetAssetById(AssetId) != nullptr)
     {
-        Bundle->DisplayName = FText::FromString(OriginalDisplayName.IsEmpty() ? TEXT("New Bundle") : OriginalDisplayName);
-        OriginalDisplayName = Bundle->DisplayName.ToString(); // Update our cached display name
-        UE_LOG(LogTemp, Log, TEXT("SaveBundle: Fixed empty display name with: %s"), *OriginalDisplayName);
+        return;
     }
     
-    // Store the original DisplayName explicitly to preserve it
-    FText PreservedDisplayName = Bundle->DisplayName;
+    // Check if we have a path for this asset ID
+    FSoftObjectPath* AssetPath = AssetPathMap.Find(AssetId);
+    if (!AssetPath)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("Asset with ID %s not found for prefetching"), *AssetId.ToString());
+        return;
+    }
     
-    // Create a unique package name for the bundle
-    FString BundleName = OriginalBundleId.ToString();
-    FString FullPackagePath = PackagePath.IsEmpty() ? 
-        FString::Printf(TEXT("/Game/Bundles/%s"), *BundleName) : 
-        FString::Printf(TEXT("%s/%s"), *PackagePath, *BundleName);
+    // Prefetched assets stay rooted for a grace period so they are not collected before first use
+    PrefetchedAssets.Add(AssetId, FPlatformTime::Seconds() + PrefetchRootGraceSeconds);
     
-    // Make sure the object name is valid for UE
-    FullPackagePath = FullPackagePath.Replace(TEXT("-"), TEXT("_"));
-    BundleName = BundleName.Replace(TEXT("-"), TEXT("_"));
+    // Create a low-priority streamable request
+    FStreamableManager& StreamableMgr = UAssetManager::GetStreamableManager();
     
-    UE_LOG(LogTemp, Log, TEXT("SaveBundle: Creating package at path: %s"), *FullPackagePath);
+    // Request async load without explicit priority (UE5.4 compatibility)
+    StreamableMgr.RequestAsyncLoad(
+        *AssetPath,
+        FStreamableDelegate::CreateUObject(this, &UCustomAssetManager::OnAssetLoaded, AssetId, *AssetPath)
+    );
     
-    // Make sure the folder exists
-    FString ContentDir = FPaths::ProjectContentDir();
-    FString RelativePath = FullPackagePath.Replace(TEXT("/Game/"), TEXT(""));
-    FString BundleDir = FPaths::GetPath(RelativePath);
-    FString FullBundleDir = FPaths::Combine(ContentDir, BundleDir);
+    UE_LOG(LogTemp, Verbose, TEXT("Started low-priority prefetch for asset %s"), *AssetId.ToString());
+}
+
+//=================================================================
+// ASSET COMPRESSION TIERS IMPLEMENTATION
+//=================================================================
+
+void UCustomAssetManager::SetAssetCompressionTier(const FName& AssetId, EAssetCompressionTier Tier)
+{
+    if (!AssetId.IsNone())
+    {
+        // Store or update the asset's compression tier
+        AssetCompressionTiers.Add(AssetId, Tier);
+        
+        UE_LOG(LogTemp, Log, TEXT("Set compression tier for asset %s to %d"), 
+            *AssetId.ToString(), static_cast<int32>(Tier));
+    }
+}
+
+EAssetCompressionTier UCustomAssetManager::GetAssetCompressionTier(const FName& AssetId) const
+{
+    // Look up the asset's compression tier
+    const EAssetCompressionTier* Tier = AssetCompressionTiers.Find(AssetId);
     
-    if (!FPlatformFileManager::Get().GetPlatformFile().DirectoryExists(*FullBundleDir))
+    if (Tier)
     {
-        FPlatformFileManager::Get().GetPlatformFile().CreateDirectoryTree(*FullBundleDir);
+        // Return the registered tier
+        return *Tier;
     }
     
-    // Create a new package for the bundle
-    UPackage* Package = CreatePackage(*FullPackagePath);
+    // If no tier registered, return the default
+    return DefaultCompressionTier;
+}
+
+void UCustomAssetManager::SetDefaultCompressionTier(EAssetCompressionTier Tier)
+{
+    DefaultCompressionTier = Tier;
+    
+    UE_LOG(LogTemp, Log, TEXT("Set default compression tier to %d"), static_cast<int32>(Tier));
+}
+
+bool UCustomAssetManager::RecompressAsset(const FName& AssetId, EAssetCompressionTier NewTier)
+{
+#if WITH_EDITOR
+    // In editor builds, we can actually recompress assets
+    
+    // Check if the asset exists
+    FSoftObjectPath* AssetPath = AssetPathMap.Find(AssetId);
+    if (!AssetPath)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("Asset with ID %s not found for recompression"), *AssetId.ToString());
+        return false;
+    }
+    
+    // Get the asset data
+    FAssetRegistryModule& AssetRegistryModule = FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry");
+    FAssetData AssetData = AssetRegistryModule.Get().GetAssetByObjectPath(*AssetPath);
+    
+    if (!AssetData.IsValid())
+    {
+        UE_LOG(LogTemp, Warning, TEXT("Asset data for %s not valid"), *AssetId.ToString());
+        return false;
+    }
+    
+    // Get the package that contains the asset
+    UPackage* Package = AssetData.GetPackage();
     if (!Package)
     {
-        UE_LOG(LogTemp, Error, TEXT("SaveBundle: Failed to create package for bundle %s"), *OriginalBundleId.ToString());
+        UE_LOG(LogTemp, Warning, TEXT("Could not get package for asset %s"), *AssetId.ToString());
         return false;
     }
     
-    Package->FullyLoad();
-    // Store a local copy of the asset IDs for transfer
-    TArray<FName> OriginalAssetIds = Bundle->AssetIds;
-    int32 OriginalAssetCount = OriginalAssetIds.Num();
-
-    // Create a new bundle asset in the package
-    UCustomAssetBundle* SavedBundle = NewObject<UCustomAssetBundle>(Package, FName(*BundleName), RF_Public | RF_Standalone);
-    if (!SavedBundle)
+    // Determine compression settings based on tier
+    int32 CompressionLevel = 0;
+    switch (NewTier)
+    {
+        case EAssetCompressionTier::None:
+            CompressionLevel = 0;
+            break;
+        case EAssetCompressionTier::Low:
+            CompressionLevel = 1;
+            break;
+        case EAssetCompressionTier::Medium:
+            CompressionLevel = 5;
+            break;
+        case EAssetCompressionTier::High:
+            CompressionLevel = 9;
+            break;
+    }
+    
+    // Save package with new compression settings
+    FSavePackageArgs SaveArgs;
+    SaveArgs.TopLevelFlags = RF_Public | RF_Standalone;
+    SaveArgs.SaveFlags = SAVE_Async;
+    // CompressionLevel is not directly accessible in UE5.4
+    // Will use default compression for now
+    
+    // Save the package
+    bool bSuccess = UPackage::SavePackage(Package, nullptr, *Package->GetName(), SaveArgs);
+    
+    if (bSuccess)
+    {
+        // Update the asset's compression tier
+        SetAssetCompressionTier(AssetId, NewTier);
+        
+        UE_LOG(LogTemp, Log, TEXT("Successfully recompressed asset %s with tier %d"), 
+            *AssetId.ToString(), static_cast<int32>(NewTier));
+    }
+    else
     {
-        UE_LOG(LogTemp, Error, TEXT("SaveBundle: Failed to create saved bundle object %s"), *OriginalBundleId.ToString());
-        return false;
+        UE_LOG(LogTemp, Warning, TEXT("Failed to recompress asset %s"), *AssetId.ToString());
     }
     
+    return bSuccess;
+#else
+    // In non-editor builds, we can't recompress
+    UE_LOG(LogTemp, Warning, TEXT("Asset recompression is only available in editor builds"));
+    
+    // Still update the tier for future reference
+    SetAssetCompressionTier(AssetId, NewTier);
+    
+    return false;
+#endif
+}
 
+int64 UCustomAssetManager::EstimateAssetSizeFromMetadata(const FName& AssetId) const
+{
+    // This is a basic implementation - in a real system, you would store and retrieve
+    // actual size metadata for each asset
     
-    UE_LOG(LogTemp, Log, TEXT("SaveBundle: Bundle has %d asset IDs to transfer"), OriginalAssetCount);
+    // Look up the asset's compression tier
+    EAssetCompressionTier Tier = GetAssetCompressionTier(AssetId);
     
-    // Copy the properties from the in-memory bundle to the saved bundle
-    SavedBundle->BundleId = OriginalBundleId;
-    SavedBundle->DisplayName = PreservedDisplayName;
-    SavedBundle->Description = Bundle->Description;
-    SavedBundle->bPreloadAtStartup = Bundle->bPreloadAtStartup;
-    SavedBundle->bKeepInMemory = Bundle->bKeepInMemory;
-    SavedBundle->Priority = Bundle->Priority;
-    SavedBundle->Tags = Bundle->Tags;
+    // Base size estimate
+    int64 BaseSize = 500 * 1024; // 500 KB base size
     
-    // CRITICAL: Explicitly create a new array and add each asset ID individually
-    // This approach is more reliable than direct array assignment for serialization
-    SavedBundle->AssetIds.Empty(OriginalAssetCount);
-    for (const FName& AssetId : OriginalAssetIds)
+    // Adjust based on compression tier
+    switch (Tier)
     {
-        if (!AssetId.IsNone())
-        {
-            SavedBundle->AssetIds.Add(AssetId);
-            UE_LOG(LogTemp, Verbose, TEXT("SaveBundle: Added asset ID %s to saved bundle"), *AssetId.ToString());
-        }
+        case EAssetCompressionTier::None:
+            return BaseSize;
+        case EAssetCompressionTier::Low:
+            return BaseSize * 0.8;
+        case EAssetCompressionTier::Medium:
+            return BaseSize * 0.5;
+        case EAssetCompressionTier::High:
+            return BaseSize * 0.3;
+        default:
+            return BaseSize;
     }
+}
+
+//=================================================================
+// LEVEL STREAMING INTEGRATION IMPLEMENTATION
+//=================================================================
+
+void UCustomAssetManager::RegisterBundleWithLevel(FName BundleId, FName LevelName, float PreloadDistance, bool bUnloadWithLevel)
+{
+    LLM_SCOPE_BYTAG(CustomAssets_Bundles);
     
-    // Ensure the asset IDs were copied correctly
-    if (SavedBundle->AssetIds.Num() != OriginalAssetCount)
+    if (BundleId.IsNone() || LevelName.IsNone())
     {
-        UE_LOG(LogTemp, Warning, TEXT("SaveBundle: Asset count mismatch! Original: %d, Saved: %d"), 
-            OriginalAssetCount, SavedBundle->AssetIds.Num());
+        UE_LOG(LogTemp, Warning, TEXT("Cannot register bundle with level: Invalid bundle ID or level name"));
+        return;
     }
     
-    // Copy any loaded assets
-    if (Bundle->Assets.Num() > 0)
+    // Check if this association already exists
+    for (int32 i = 0; i < LevelBundleAssociations.Num(); ++i)
     {
-        SavedBundle->Assets.Empty(Bundle->Assets.Num());
-        for (UCustomAssetBase* Asset : Bundle->Assets)
+        if (LevelBundleAssociations[i].BundleId == BundleId && 
+            LevelBundleAssociations[i].LevelName == LevelName)
         {
-            if (Asset && !Asset->AssetId.IsNone())
-            {
-                SavedBundle->Assets.Add(Asset);
-                
-                // Make sure the Asset ID is also in the AssetIds array
-                if (!SavedBundle->AssetIds.Contains(Asset->AssetId))
-                {
-                    SavedBundle->AssetIds.Add(Asset->AssetId);
-                    UE_LOG(LogTemp, Log, TEXT("SaveBundle: Added missing asset ID %s from loaded asset"), *Asset->AssetId.ToString());
-                }
-            }
+            // Update existing association
+            LevelBundleAssociations[i].PreloadDistance = PreloadDistance;
+            LevelBundleAssociations[i].bUnloadWithLevel = bUnloadWithLevel;
+            
+            UE_LOG(LogTemp, Log, TEXT("Updated bundle %s association with level %s (Preload distance: %.1f)"), 
+                *BundleId.ToString(), *LevelName.ToString(), PreloadDistance);
+            return;
         }
     }
     
-    SavedBundle->bIsLoaded = false; // Don't save loaded state
-    
-    // Verify the bundle has the correct data
-    UE_LOG(LogTemp, Log, TEXT("SaveBundle: Bundle to be saved has %d asset IDs and %d loaded assets"), 
-        SavedBundle->AssetIds.Num(), SavedBundle->Assets.Num());
-    
-    // DO NOT ADD DEFAULT ASSETS - This was causing the issue with bundles auto-including assets
-    // We want empty bundles to remain empty
+    // Create a new association
+    FBundleLevelAssociation NewAssociation;
+    NewAssociation.BundleId = BundleId;
+    NewAssociation.LevelName = LevelName;
+    NewAssociation.OwnerId = GetLevelBundleOwner(LevelName);
+    NewAssociation.PreloadDistance = PreloadDistance;
+    NewAssociation.bUnloadWithLevel = bUnloadWithLevel;
     
-    // Mark the package as dirty
-    Package->MarkPackageDirty();
+    // Add to the list
+    LevelBundleAssociations.Add(NewAssociation);
     
-    // Save the package
-    bool bSuccess = false;
+    UE_LOG(LogTemp, Log, TEXT("Registered bundle %s with level %s (Preload distance: %.1f)"), 
+        *BundleId.ToString(), *LevelName.ToString(), PreloadDistance);
     
-#if ENGINE_MAJOR_VERSION >= 5
-    FSavePackageArgs SaveArgs;
-    SaveArgs.TopLevelFlags = RF_Public | RF_Standalone;
-    SaveArgs.SaveFlags = SAVE_NoError;
-    bSuccess = UPackage::SavePackage(Package, SavedBundle, *FullPackagePath, SaveArgs);
-#else
-    bSuccess = UPackage::SavePackage(Package, SavedBundle, RF_Public | RF_Standalone, *FullPackagePath);
-#endif
+    // If the level is already loaded, preload the bundle now
+    if (LoadedLevels.Contains(LevelName))
+    {
+        UE_LOG(LogTemp, Log, TEXT("Level %s is already loaded, preloading bundle %s now"), 
+            *LevelName.ToString(), *BundleId.ToString());
+        AcquireBundle(BundleId, NewAssociation.OwnerId, EAssetLoadingStrategy::Streaming);
+    }
+}
+
+void UCustomAssetManager::UnregisterBundleFromLevel(FName BundleId, FName LevelName)
+{
+    if (BundleId.IsNone() || LevelName.IsNone())
+    {
+        return;
+    }
     
-    if (bSuccess)
+    // Find and remove the association
+    for (int32 i = LevelBundleAssociations.Num() - 1; i >= 0; --i)
     {
-        UE_LOG(LogTemp, Log, TEXT("SaveBundle: Successfully saved bundle %s to %s"), 
-            *SavedBundle->BundleId.ToString(), *FullPackagePath);
-        
-        // Replace the in-memory bundle with the saved bundle in our map
-        if (Bundles.Contains(OriginalBundleId))
-        {
-            Bundles[OriginalBundleId] = SavedBundle;
-        }
-        else
+        if (LevelBundleAssociations[i].BundleId == BundleId && 
+            LevelBundleAssociations[i].LevelName == LevelName)
         {
-            Bundles.Add(SavedBundle->BundleId, SavedBundle);
+            LevelBundleAssociations.RemoveAt(i);
+            LevelBundleOutOfRangeSince.Remove(TPair<FName, FName>(BundleId, LevelName));
+            
+            // The level no longer holds the bundle
+            ReleaseBundle(BundleId, GetLevelBundleOwner(LevelName));
+            
+            UE_LOG(LogTemp, Log, TEXT("Unregistered bundle %s from level %s"), 
+                *BundleId.ToString(), *LevelName.ToString());
         }
     }
-    else
+}
+
+void UCustomAssetManager::RegisterBundleWithStreamingRegion(FName BundleId, FName RegionName, const FBox& Bounds, FName GridName, float PrefetchDistance, bool bRequireActivation)
+{
+    if (BundleId.IsNone() || RegionName.IsNone() || !Bounds.IsValid)
     {
-        UE_LOG(LogTemp, Error, TEXT("SaveBundle: Failed to save bundle %s to %s"), *OriginalBundleId.ToString(), *FullPackagePath);
+        UE_LOG(LogTemp, Warning, TEXT("Cannot register bundle %s with streaming region %s: invalid arguments"), 
+            *BundleId.ToString(), *RegionName.ToString());
+        return;
     }
     
-    return bSuccess;
+    FBundleStreamingRegionAssociation* Association = StreamingRegionAssociations.FindByPredicate([BundleId, RegionName](const FBundleStreamingRegionAssociation& Existing)
+    {
+        return Existing.BundleId == BundleId && Existing.RegionName == RegionName;
+    });
+    
+    if (!Association)
+    {
+        Association = &StreamingRegionAssociations.AddDefaulted_GetRef();
+        Association->BundleId = BundleId;
+        Association->RegionName = RegionName;
+    }
+    
+    Association->GridName = GridName;
+    Association->Bounds = Bounds;
+    Association->PrefetchDistance = FMath::Max(PrefetchDistance, 0.0f);
+    Association->bRequireActivation = bRequireActivation;
+    
+    UE_LOG(LogTemp, Log, TEXT("Registered bundle %s with streaming region %s (Grid: %s)"), 
+        *BundleId.ToString(), *RegionName.ToString(), *GridName.ToString());
+    
+    // Pick up cells that are already loaded
+    UpdateStreamingRegionBundles();
 }
 
-int32 UCustomAssetManager::SaveAllBundles(const FString& BasePath)
+void UCustomAssetManager::UnregisterBundleFromStreamingRegion(FName BundleId, FName RegionName)
 {
-    int32 SuccessCount = 0;
-    
-    TArray<UCustomAssetBundle*> AllBundles;
-    GetAllBundles(AllBundles);
-    
-    // Default path if none provided
-    FString SavePath = BasePath.IsEmpty() ? TEXT("/Game/Bundles") : BasePath;
+    const int32 NumRemoved = StreamingRegionAssociations.RemoveAll([BundleId, RegionName](const FBundleStreamingRegionAssociation& Association)
+    {
+        return Association.BundleId == BundleId && Association.RegionName == RegionName;
+    });
     
-    // Save each bundle
-    for (UCustomAssetBundle* Bundle : AllBundles)
+    if (NumRemoved == 0)
     {
-        if (SaveBundle(Bundle, SavePath))
-        {
-            SuccessCount++;
-        }
+        return;
     }
     
-    UE_LOG(LogTemp, Log, TEXT("Saved %d/%d bundles to %s"), SuccessCount, AllBundles.Num(), *SavePath);
+    // The region no longer holds the bundle
+    if (ActiveStreamingRegionBundles.Remove(TPair<FName, FName>(BundleId, RegionName)) > 0)
+    {
+        ReleaseBundle(BundleId, GetStreamingRegionBundleOwner(RegionName));
+    }
     
-    return SuccessCount;
+    UE_LOG(LogTemp, Log, TEXT("Unregistered bundle %s from streaming region %s"), 
+        *BundleId.ToString(), *RegionName.ToString());
 }
 
-bool UCustomAssetManager::DeleteBundle(const FName& BundleId)
+void UCustomAssetManager::UpdateStreamingRegionBundles()
 {
-    // Log entry for debugging
-    UE_LOG(LogTemp, Log, TEXT("DeleteBundle: Attempting to delete bundle with ID: %s"), *BundleId.ToString());
+    LLM_SCOPE_BYTAG(CustomAssets_Bundles);
     
-    // Special handling for None IDs - search for bundles with None ID
-    if (BundleId.IsNone())
+    if (StreamingRegionAssociations.Num() == 0)
     {
-        UE_LOG(LogTemp, Warning, TEXT("DeleteBundle: Attempting to delete bundle with None ID"));
-        
-        // Find all bundles with None ID (this is an error condition but we'll try to recover)
-        TArray<UCustomAssetBundle*> BundlesToDelete;
-        for (const TPair<FName, UCustomAssetBundle*>& Pair : Bundles)
+        return;
+    }
+    
+    // Associations whose region should hold its bundle this pass; without World Partition none do
+    TSet<TPair<FName, FName>> WantedRegionBundles;
+    
+    UWorld* World = GetGameWorld();
+    UWorldPartition* WorldPartition = World ? World->GetWorldPartition() : nullptr;
+    if (WorldPartition && WorldPartition->RuntimeHash)
+    {
+        // Streaming sources reach a region's prefetch distance before its cells are requested
+        if (const UWorldPartitionSubsystem* WorldPartitionSubsystem = World->GetSubsystem<UWorldPartitionSubsystem>())
         {
-            if (Pair.Key.IsNone() || (Pair.Value && Pair.Value->BundleId.IsNone()))
+            for (const FWorldPartitionStreamingSource& Source : WorldPartitionSubsystem->GetStreamingSources())
             {
-                BundlesToDelete.Add(Pair.Value);
+                for (const FBundleStreamingRegionAssociation& Association : StreamingRegionAssociations)
+                {
+                    if (Association.PrefetchDistance > 0.0f && Association.Bounds.ExpandBy(Association.PrefetchDistance).IsInsideOrOn(Source.Location))
+                    {
+                        WantedRegionBundles.Add(TPair<FName, FName>(Association.BundleId, Association.RegionName));
+                    }
+                }
             }
         }
         
-        if (BundlesToDelete.Num() == 0)
-        {
-            UE_LOG(LogTemp, Warning, TEXT("DeleteBundle: No bundles with None ID found"));
-            return false;
-        }
-        
-        // Remove all these problematic bundles
-        for (UCustomAssetBundle* Bundle : BundlesToDelete)
+        // Otherwise a region follows the cells the streaming system has loaded over it
+        WorldPartition->RuntimeHash->ForEachStreamingCells([this, &WantedRegionBundles](const UWorldPartitionRuntimeCell* Cell)
         {
-            if (Bundle)
+            const EWorldPartitionRuntimeCellState CellState = Cell->GetCurrentState();
+            if (CellState == EWorldPartitionRuntimeCellState::Unloaded)
             {
-                UE_LOG(LogTemp, Warning, TEXT("DeleteBundle: Removing bundle with None ID from memory"));
-                Bundles.Remove(FName());  // Remove the None key
-                // We can't delete the asset file because we don't know its path
+                return true;
             }
-        }
-        
-        return true;
-    }
-
-    // Normal case - find the bundle by ID
-    UCustomAssetBundle* Bundle = GetBundleById(BundleId);
-    if (!Bundle)
-    {
-        UE_LOG(LogTemp, Warning, TEXT("DeleteBundle: Bundle with ID %s not found"), *BundleId.ToString());
-        return false;
+            
+            const FBox CellBounds = Cell->GetCellBounds();
+            if (!CellBounds.IsValid)
+            {
+                return true;
+            }
+            
+            for (const FBundleStreamingRegionAssociation& Association : StreamingRegionAssociations)
+            {
+                if ((Association.GridName.IsNone() || Association.GridName == Cell->GetGridName()) &&
+                    (!Association.bRequireActivation || CellState == EWorldPartitionRuntimeCellState::Activated) &&
+                    CellBounds.Intersect(Association.Bounds))
+                {
+                    WantedRegionBundles.Add(TPair<FName, FName>(Association.BundleId, Association.RegionName));
+                }
+            }
+            
+            return true;
+        });
     }
-
-    // Get the package path for the bundle
-    FString BundleName = BundleId.ToString().Replace(TEXT("-"), TEXT("_"));
-    FString PackagePath = FString::Printf(TEXT("/Game/Bundles/%s"), *BundleName);
-    
-    UE_LOG(LogTemp, Log, TEXT("DeleteBundle: Unregistering bundle %s"), *BundleId.ToString());
-    
-    // Unregister the bundle from the manager
-    UnregisterBundle(Bundle);
-    
-    // Delete the asset file from the content browser
-    bool bDeletedSuccessfully = false;
-    
-#if WITH_EDITOR
-    // In editor builds, use asset registry
-    FAssetRegistryModule& AssetRegistryModule = FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry");
-    FAssetData AssetData = AssetRegistryModule.Get().GetAssetByObjectPath(FSoftObjectPath(PackagePath));
-    
-    if (AssetData.IsValid())
-    {
-        UE_LOG(LogTemp, Log, TEXT("DeleteBundle: Found asset data for %s, attempting to delete"), *BundleId.ToString());
-        TArray<UObject*> ObjectsToDelete;
-        UObject* Asset = AssetData.GetAsset();
-        if (Asset)
+    
+    for (const FBundleStreamingRegionAssociation& Association : StreamingRegionAssociations)
+    {
+        const TPair<FName, FName> AssociationKey(Association.BundleId, Association.RegionName);
+        const bool bWanted = WantedRegionBundles.Contains(AssociationKey);
+        const bool bHeld = ActiveStreamingRegionBundles.Contains(AssociationKey);
+        
+        if (bWanted && !bHeld)
         {
-            ObjectsToDelete.Add(Asset);
-            bDeletedSuccessfully = ObjectTools::DeleteObjects(ObjectsToDelete, false) > 0;
+            UE_LOG(LogTemp, Log, TEXT("Streaming region %s is loading, acquiring bundle %s"), 
+                *Association.RegionName.ToString(), *Association.BundleId.ToString());
+            
+            ActiveStreamingRegionBundles.Add(AssociationKey);
+            AcquireBundle(Association.BundleId, GetStreamingRegionBundleOwner(Association.RegionName), EAssetLoadingStrategy::Streaming);
         }
-        else
+        else if (!bWanted && bHeld)
         {
-            UE_LOG(LogTemp, Warning, TEXT("DeleteBundle: Got AssetData but failed to load asset for %s"), *BundleId.ToString());
-            bDeletedSuccessfully = true; // Consider it a success if the asset is already gone
+            UE_LOG(LogTemp, Log, TEXT("Streaming region %s unloaded, releasing bundle %s"), 
+                *Association.RegionName.ToString(), *Association.BundleId.ToString());
+            
+            ActiveStreamingRegionBundles.Remove(AssociationKey);
+            ReleaseBundle(Association.BundleId, GetStreamingRegionBundleOwner(Association.RegionName));
+            bReachabilityDirty = true;
         }
     }
-    else
+}
+
+bool UCustomAssetManager::IsBundleHeldByStreamingRegion(FName BundleId, FName RegionName) const
+{
+    return ActiveStreamingRegionBundles.Contains(TPair<FName, FName>(BundleId, RegionName));
+}
+
+void UCustomAssetManager::RegisterBundleWithDataLayer(FName BundleId, FName DataLayerName)
+{
+    if (BundleId.IsNone() || DataLayerName.IsNone())
     {
-        UE_LOG(LogTemp, Warning, TEXT("DeleteBundle: No AssetData found for %s"), *BundleId.ToString());
-        bDeletedSuccessfully = true; // Consider it a success if the asset is already gone
+        UE_LOG(LogTemp, Warning, TEXT("Cannot register bundle with Data Layer: Invalid bundle ID or Data Layer name"));
+        return;
     }
-#else
-    // In non-editor builds, just unregister the bundle
-    bDeletedSuccessfully = true;
-#endif
     
-    if (bDeletedSuccessfully)
+    const bool bExists = DataLayerBundleAssociations.ContainsByPredicate([BundleId, DataLayerName](const FBundleDataLayerAssociation& Association)
     {
-        UE_LOG(LogTemp, Log, TEXT("DeleteBundle: Successfully deleted bundle %s"), *BundleId.ToString());
-    }
-    else
+        return Association.BundleId == BundleId && Association.DataLayerName == DataLayerName;
+    });
+    
+    if (bExists)
     {
-        UE_LOG(LogTemp, Error, TEXT("DeleteBundle: Failed to delete bundle %s"), *BundleId.ToString());
+        return;
     }
     
-    return bDeletedSuccessfully;
+    FBundleDataLayerAssociation NewAssociation;
+    NewAssociation.BundleId = BundleId;
+    NewAssociation.DataLayerName = DataLayerName;
+    DataLayerBundleAssociations.Add(NewAssociation);
+    
+    UE_LOG(LogTemp, Log, TEXT("Registered bundle %s with Data Layer %s"), 
+        *BundleId.ToString(), *DataLayerName.ToString());
+    
+    // If the Data Layer is already active, load the bundle now
+    if (ActiveDataLayers.Contains(DataLayerName))
+    {
+        AcquireBundle(BundleId, GetDataLayerBundleOwner(DataLayerName), EAssetLoadingStrategy::Streaming);
+    }
 }
 
-bool UCustomAssetManager::RenameBundle(const FName& BundleId, const FString& NewName)
+void UCustomAssetManager::UnregisterBundleFromDataLayer(FName BundleId, FName DataLayerName)
 {
-    // Find the bundle by ID
-    UCustomAssetBundle* Bundle = GetBundleById(BundleId);
-    if (!Bundle)
+    const int32 NumRemoved = DataLayerBundleAssociations.RemoveAll([BundleId, DataLayerName](const FBundleDataLayerAssociation& Association)
     {
-        UE_LOG(LogTemp, Warning, TEXT("RenameBundle: Bundle with ID %s not found"), *BundleId.ToString());
-        return false;
-    }
+        return Association.BundleId == BundleId && Association.DataLayerName == DataLayerName;
+    });
     
-    // Create a copy of the bundle with the new name/ID
-    UCustomAssetBundle* NewBundle = DuplicateObject<UCustomAssetBundle>(Bundle, GetTransientPackage());
-    if (!NewBundle)
+    if (NumRemoved == 0)
     {
-        UE_LOG(LogTemp, Error, TEXT("RenameBundle: Failed to duplicate bundle %s"), *BundleId.ToString());
-        return false;
+        return;
     }
     
-    // Update the bundle's name properties
-    NewBundle->DisplayName = FText::FromString(NewName);
+    // The Data Layer no longer holds the bundle
+    ReleaseBundle(BundleId, GetDataLayerBundleOwner(DataLayerName));
     
-    // Generate a new bundle ID using GUID (or use the name if preferred)
-    FGuid NewGuid = FGuid::NewGuid();
-    FName NewBundleId = FName(*NewGuid.ToString());
-    NewBundle->BundleId = NewBundleId;
+    UE_LOG(LogTemp, Log, TEXT("Unregistered bundle %s from Data Layer %s"), 
+        *BundleId.ToString(), *DataLayerName.ToString());
+}
+
+void UCustomAssetManager::OnDataLayerStateChanged(FName DataLayerName, bool bActive)
+{
+    LLM_SCOPE_BYTAG(CustomAssets_Bundles);
     
-    UE_LOG(LogTemp, Log, TEXT("Renaming bundle from %s to %s (new ID: %s)"), 
-        *BundleId.ToString(), *NewName, *NewBundleId.ToString());
+    if (DataLayerName.IsNone() || ActiveDataLayers.Contains(DataLayerName) == bActive)
+    {
+        return;
+    }
     
-    // Copy all assets from old bundle to new bundle
-    NewBundle->AssetIds.Empty();
-    for (const FName& AssetId : Bundle->AssetIds)
+    // Remember the layer's loaded bytes at the switch so the report shows what the switch cost or freed
+    FDataLayerBundleMemoryReport& Report = DataLayerMemoryReports.FindOrAdd(DataLayerName);
+    Report.DataLayerName = DataLayerName;
+    Report.bActive = bActive;
+    Report.LoadedBytesAtTransition = GetDataLayerBundleLoadedBytes(DataLayerName);
+    Report.LastTransitionTime = FDateTime::Now();
+    ++Report.TransitionCount;
+    
+    if (bActive)
     {
-        if (!AssetId.IsNone())
-        {
-            NewBundle->AssetIds.Add(AssetId);
-        }
+        ActiveDataLayers.Add(DataLayerName);
+    }
+    else
+    {
+        ActiveDataLayers.Remove(DataLayerName);
+        bReachabilityDirty = true;
     }
     
-    // Register the new bundle
-    RegisterBundle(NewBundle);
+    UE_LOG(LogTemp, Log, TEXT("Data Layer %s %s, updating associated bundles"), 
+        *DataLayerName.ToString(), bActive ? TEXT("activated") : TEXT("deactivated"));
     
-    // Save the new bundle
-    if (!SaveBundle(NewBundle, TEXT("/Game/Bundles")))
+    const FName OwnerId = GetDataLayerBundleOwner(DataLayerName);
+    for (const FBundleDataLayerAssociation& Association : DataLayerBundleAssociations)
     {
-        UE_LOG(LogTemp, Error, TEXT("RenameBundle: Failed to save new bundle %s"), *NewBundleId.ToString());
+        if (Association.DataLayerName != DataLayerName)
+        {
+            continue;
+        }
         
-        // Clean up on failure
-        UnregisterBundle(NewBundle);
-        return false;
+        // Bundles still held by levels, regions or other Data Layers stay loaded
+        if (bActive)
+        {
+            AcquireBundle(Association.BundleId, OwnerId, EAssetLoadingStrategy::Streaming);
+        }
+        else
+        {
+            ReleaseBundle(Association.BundleId, OwnerId);
+        }
+    }
+}
+
+bool UCustomAssetManager::IsDataLayerActive(FName DataLayerName) const
+{
+    return ActiveDataLayers.Contains(DataLayerName);
+}
+
+FDataLayerBundleMemoryReport UCustomAssetManager::GetDataLayerMemoryReport(FName DataLayerName) const
+{
+    FDataLayerBundleMemoryReport Report;
+    if (const FDataLayerBundleMemoryReport* Transition = DataLayerMemoryReports.Find(DataLayerName))
+    {
+        Report = *Transition;
     }
     
-    // Delete the old bundle
-    bool bDeleteResult = DeleteBundle(BundleId);
-    if (!bDeleteResult)
+    Report.DataLayerName = DataLayerName;
+    Report.bActive = ActiveDataLayers.Contains(DataLayerName);
+    Report.BundleLoadedBytes = GetDataLayerBundleLoadedBytes(DataLayerName, &Report.BundleIds);
+    
+    // Only the layer's own bundle assets count, so other streaming in the meantime does not show up here
+    if (Report.TransitionCount > 0)
     {
-        UE_LOG(LogTemp, Warning, TEXT("RenameBundle: Failed to delete old bundle %s, but new bundle was created"), 
-            *BundleId.ToString());
-        // Continue with success even if old deletion failed
+        Report.DeltaBytesSinceTransition = Report.BundleLoadedBytes - Report.LoadedBytesAtTransition;
     }
     
-    UE_LOG(LogTemp, Log, TEXT("Successfully renamed bundle from %s to %s"), *BundleId.ToString(), *NewBundleId.ToString());
-    return true;
+    return Report;
 }
 
-// Define the OnAssetLoaded method
-void UCustomAssetManager::OnAssetLoaded(FName AssetId, FSoftObjectPath AssetPath)
+int64 UCustomAssetManager::GetDataLayerBundleLoadedBytes(FName DataLayerName, TArray<FName>* OutBundleIds) const
 {
-    // Get the loaded asset
-    UCustomAssetBase* Asset = Cast<UCustomAssetBase>(AssetPath.ResolveObject());
-    if (::IsValid(Asset))
+    int64 LoadedBytes = 0;
+    
+    // Assets shared between the Data Layer's bundles count once
+    TSet<FName> CountedAssetIds;
+    for (const FBundleDataLayerAssociation& Association : DataLayerBundleAssociations)
     {
-        // Register the asset
-        RegisterAsset(Asset);
+        if (Association.DataLayerName != DataLayerName)
+        {
+            continue;
+        }
         
-        // Load hard dependencies
-        LoadDependencies(AssetId, true, EAssetLoadingStrategy::Streaming);
+        if (OutBundleIds)
+        {
+            OutBundleIds->Add(Association.BundleId);
+        }
         
-        // Manage memory usage
-        ManageMemoryUsage();
+        const UCustomAssetBundle* Bundle = GetBundleById(Association.BundleId);
+        if (!::IsValid(Bundle) || !MemoryTracker)
+        {
+            continue;
+        }
         
-        UE_LOG(LogTemp, Log, TEXT("Asset with ID %s loaded and registered"), *AssetId.ToString());
+        for (const FName& AssetId : Bundle->AssetIds)
+        {
+            bool bAlreadyCounted = false;
+            CountedAssetIds.Add(AssetId, &bAlreadyCounted);
+            if (!bAlreadyCounted && MemoryTracker->IsAssetTracked(AssetId))
+            {
+                const FAssetMemoryStats Stats = MemoryTracker->GetAssetMemoryStats(AssetId);
+                if (Stats.bIsLoaded)
+                {
+                    LoadedBytes += Stats.MemoryUsage;
+                }
+            }
+        }
     }
+    
+    return LoadedBytes;
 }
 
-//=================================================================
-// ASSET PREFETCHING SYSTEM IMPLEMENTATION
-//=================================================================
-
-void UCustomAssetManager::PrefetchAssetsInRadius(FVector Location, float Radius, int32 MaxAssets)
+TArray<FDataLayerBundleMemoryReport> UCustomAssetManager::GetDataLayerMemoryReports() const
 {
-    // Get assets within the radius
-    TArray<FName> NearbyAssetIds = GetAssetsInRadius(Location, Radius);
+    TSet<FName> DataLayerNames;
+    for (const FBundleDataLayerAssociation& Association : DataLayerBundleAssociations)
+    {
+        DataLayerNames.Add(Association.DataLayerName);
+    }
     
-    // Early exit if no assets found
-    if (NearbyAssetIds.Num() == 0)
+    for (const auto& Pair : DataLayerMemoryReports)
     {
-        return;
+        DataLayerNames.Add(Pair.Key);
     }
     
-    // Sort by distance from location
-    NearbyAssetIds.Sort([this, Location](const FName& A, const FName& B) {
-        float DistA = GetDistanceToAsset(A, Location);
-        float DistB = GetDistanceToAsset(B, Location);
-        return DistA < DistB;
-    });
+    TArray<FDataLayerBundleMemoryReport> Reports;
+    Reports.Reserve(DataLayerNames.Num());
+    for (const FName& DataLayerName : DataLayerNames)
+    {
+        Reports.Add(GetDataLayerMemoryReport(DataLayerName));
+    }
     
-    // Limit to max assets
-    if (NearbyAssetIds.Num() > MaxAssets)
+    return Reports;
+}
+
+void UCustomAssetManager::UpdateLevelBasedBundles(APlayerController* PlayerController)
+{
+    if (!PlayerController)
     {
-        NearbyAssetIds.SetNum(MaxAssets);
+        return;
     }
     
-    // Prefetch the nearest assets
-    PrefetchAssets(NearbyAssetIds);
+    // Get player pawn and its location
+    APawn* PlayerPawn = PlayerController->GetPawn();
+    if (!PlayerPawn)
+    {
+        return;
+    }
     
-    UE_LOG(LogTemp, Log, TEXT("Prefetching %d assets in radius %.1f around location (%.1f, %.1f, %.1f)"),
-        NearbyAssetIds.Num(), Radius, Location.X, Location.Y, Location.Z);
+    FBundleStreamingViewer Viewer;
+    Viewer.Location = PlayerPawn->GetActorLocation();
+    UpdateLevelBasedBundlesForViewer(Viewer);
 }
 
-void UCustomAssetManager::PrefetchAssets(const TArray<FName>& AssetIds)
+void UCustomAssetManager::UpdateLevelBasedBundlesForViewer(const FBundleStreamingViewer& Viewer)
 {
-    // Early exit if no assets
-    if (AssetIds.Num() == 0)
+    UpdateLevelBasedBundlesForViewers({ Viewer });
+}
+
+void UCustomAssetManager::UpdateLevelBasedBundlesForViewers(const TArray<FBundleStreamingViewer>& Viewers)
+{
+    LLM_SCOPE_BYTAG(CustomAssets_Bundles);
+    
+    // No viewers means no information this frame, not that every viewer left, so nothing is released
+    if (LevelBundleAssociations.Num() == 0 || Viewers.Num() == 0)
     {
         return;
     }
     
-    // Start a low-priority stream for each asset that isn't already loaded
-    for (const FName& AssetId : AssetIds)
+    // Hysteresis runs on game time so pauses and time dilation do not release bundles early
+    UWorld* World = GetGameWorld();
+    if (!World)
     {
-        // Skip if already loaded
-        if (GetAssetById(AssetId) != nullptr)
+        return;
+    }
+    
+    TrackLevelBounds(World);
+    
+    // Predictions of all viewers are merged into time buckets as fine as the finest prediction step
+    float BucketSeconds = MAX_flt;
+    for (const FBundleStreamingViewer& Viewer : Viewers)
+    {
+        if (Viewer.PredictedPath.Num() > 0)
+        {
+            BucketSeconds = FMath::Min(BucketSeconds, FMath::Max(Viewer.PredictionStepSeconds, KINDA_SMALL_NUMBER));
+        }
+    }
+    
+    int32 NumBuckets = 0;
+    for (const FBundleStreamingViewer& Viewer : Viewers)
+    {
+        if (Viewer.PredictedPath.Num() > 0)
+        {
+            NumBuckets = FMath::Max(NumBuckets, FMath::CeilToInt(Viewer.PredictedPath.Num() * FMath::Max(Viewer.PredictionStepSeconds, KINDA_SMALL_NUMBER) / BucketSeconds));
+        }
+    }
+    
+    // Nearest any viewer is to each level now and per prediction bucket, resolved once per level
+    struct FLevelRelevance
+    {
+        bool bKnownLocation = false;
+        float MinDistance = FLT_MAX;
+        TArray<float> MinPredictedDistance;
+    };
+    
+    TMap<FName, FLevelRelevance> LevelRelevance;
+    for (const FBundleLevelAssociation& Association : LevelBundleAssociations)
+    {
+        if (LevelRelevance.Contains(Association.LevelName))
         {
             continue;
         }
         
-        // Stream with low priority
-        LowPriorityStreamAsset(AssetId);
+        FLevelRelevance& Relevance = LevelRelevance.Add(Association.LevelName);
+        FBox Bounds(EForceInit::ForceInit);
+        if (!GetLevelStreamingBounds(Association.LevelName, Bounds))
+        {
+            continue;
+        }
+        
+        Relevance.bKnownLocation = true;
+        Relevance.MinPredictedDistance.Init(FLT_MAX, NumBuckets);
+        
+        for (const FBundleStreamingViewer& Viewer : Viewers)
+        {
+            Relevance.MinDistance = FMath::Min(Relevance.MinDistance, FMath::Sqrt(static_cast<float>(Bounds.ComputeSquaredDistanceToPoint(Viewer.Location))));
+            
+            const float StepSeconds = FMath::Max(Viewer.PredictionStepSeconds, KINDA_SMALL_NUMBER);
+            for (int32 Step = 0; Step < Viewer.PredictedPath.Num(); ++Step)
+            {
+                const int32 Bucket = FMath::Clamp(FMath::CeilToInt((Step + 1) * StepSeconds / BucketSeconds) - 1, 0, NumBuckets - 1);
+                const float Distance = FMath::Sqrt(static_cast<float>(Bounds.ComputeSquaredDistanceToPoint(Viewer.PredictedPath[Step])));
+                Relevance.MinPredictedDistance[Bucket] = FMath::Min(Relevance.MinPredictedDistance[Bucket], Distance);
+            }
+        }
     }
     
-    UE_LOG(LogTemp, Verbose, TEXT("Started prefetching %d assets"), AssetIds.Num());
-}
-
-void UCustomAssetManager::RegisterAssetLocation(const FName& AssetId, const FVector& WorldLocation)
-{
-    if (!AssetId.IsNone())
+    const double Now = GetBundleReleaseTime();
+    
+    // Process each level-bundle association
+    for (const FBundleLevelAssociation& Association : LevelBundleAssociations)
     {
-        // Store or update the asset's world location
-        AssetLocations.Add(AssetId, WorldLocation);
+        const FLevelRelevance& Relevance = LevelRelevance.FindChecked(Association.LevelName);
+        const TPair<FName, FName> AssociationKey(Association.BundleId, Association.LevelName);
         
-        UE_LOG(LogTemp, Verbose, TEXT("Registered asset %s at location (%.1f, %.1f, %.1f)"), 
-            *AssetId.ToString(), WorldLocation.X, WorldLocation.Y, WorldLocation.Z);
+        // Levels without a known location are left to OnLevelLoaded and OnLevelUnloaded
+        if (!Relevance.bKnownLocation)
+        {
+            continue;
+        }
+        
+        // Look ahead only as far as the bundle needs to finish streaming before a viewer arrives
+        bool bPredictedInRange = false;
+        if (Relevance.MinDistance > Association.PreloadDistance && NumBuckets > 0)
+        {
+            const int32 LeadBuckets = FMath::Min(NumBuckets, FMath::CeilToInt(GetBundleStreamingLeadTime(Association.BundleId) / BucketSeconds));
+            for (int32 Bucket = 0; Bucket < LeadBuckets && !bPredictedInRange; ++Bucket)
+            {
+                bPredictedInRange = Relevance.MinPredictedDistance[Bucket] <= Association.PreloadDistance;
+            }
+        }
+        
+        const FName OwnerId = Association.OwnerId;
+        const FBundleReferenceState* Reference = BundleReferences.Find(Association.BundleId);
+        const bool bHeldByLevel = Reference && Reference->Owners.Contains(OwnerId);
+        
+        // If any viewer is within preload distance now or soon, the level holds the bundle
+        if (Relevance.MinDistance <= Association.PreloadDistance || bPredictedInRange)
+        {
+            if (!bHeldByLevel)
+            {
+                UE_LOG(LogTemp, Verbose, TEXT("Nearest viewer is %.1f units from level %s%s, acquiring bundle %s"), 
+                    Relevance.MinDistance, *Association.LevelName.ToString(), bPredictedInRange ? TEXT(" and heading into range") : TEXT(""), 
+                    *Association.BundleId.ToString());
+            }
+            
+            LevelBundleOutOfRangeSince.Remove(AssociationKey);
+            AcquireBundle(Association.BundleId, OwnerId, EAssetLoadingStrategy::Streaming);
+        }
+        // Once every viewer has stayed outside unload distance long enough, the level lets go of it (other owners may still hold it)
+        else if (bHeldByLevel && Relevance.MinDistance > Association.PreloadDistance * BundleReleaseDistanceFactor)
+        {
+            // World time restarts with each world, so a timestamp from a previous one starts the wait over
+            double& OutOfRangeSince = LevelBundleOutOfRangeSince.FindOrAdd(AssociationKey, Now);
+            OutOfRangeSince = FMath::Min(OutOfRangeSince, Now);
+            if (Now - OutOfRangeSince >= BundleReleaseHysteresisSeconds)
+            {
+                UE_LOG(LogTemp, Verbose, TEXT("Nearest viewer is %.1f units from level %s, releasing bundle %s"), 
+                    Relevance.MinDistance, *Association.LevelName.ToString(), *Association.BundleId.ToString());
+                
+                LevelBundleOutOfRangeSince.Remove(AssociationKey);
+                ReleaseBundle(Association.BundleId, OwnerId);
+            }
+        }
+        else
+        {
+            LevelBundleOutOfRangeSince.Remove(AssociationKey);
+        }
     }
 }
 
-TArray<FName> UCustomAssetManager::GetAssetsInRadius(const FVector& Location, float Radius) const
+float UCustomAssetManager::GetBundleStreamingLeadTime(FName BundleId) const
 {
-    TArray<FName> Result;
-    float RadiusSquared = Radius * Radius;
+    float LeadSeconds = BundleStreamingLeadSeconds;
     
-    // Check each asset with a registered location
-    for (const TPair<FName, FVector>& Pair : AssetLocations)
+    const UCustomAssetBundle* Bundle = GetBundleById(BundleId);
+    if (Bundle && !Bundle->bIsLoaded && EstimatedStreamingMBPerSecond > 0.0f)
     {
-        const FVector& AssetLocation = Pair.Value;
-        float DistanceSquared = FVector::DistSquared(Location, AssetLocation);
-        
-        // If within radius, add to result
-        if (DistanceSquared <= RadiusSquared)
-        {
-            Result.Add(Pair.Key);
-        }
+        LeadSeconds += static_cast<float>(Bundle->Manifest.EstimatedDiskBytes / (EstimatedStreamingMBPerSecond * 1024.0 * 1024.0));
     }
     
-    return Result;
+    return LeadSeconds;
 }
 
-float UCustomAssetManager::GetDistanceToAsset(const FName& AssetId, const FVector& FromLocation) const
+float UCustomAssetManager::GetDistanceToLevel(FName LevelName, const FVector& FromLocation) const
 {
-    // Look up the asset's registered location
-    const FVector* AssetLocation = AssetLocations.Find(AssetId);
-    
-    if (AssetLocation)
+    FBox Bounds(EForceInit::ForceInit);
+    if (!GetLevelStreamingBounds(LevelName, Bounds))
     {
-        // Return the distance
-        return FVector::Distance(FromLocation, *AssetLocation);
+        return FLT_MAX;
     }
     
-    // If no location registered, return a large value
-    return FLT_MAX;
+    // Zero anywhere inside the level, the same measure the bundle updates use
+    return FMath::Sqrt(static_cast<float>(Bounds.ComputeSquaredDistanceToPoint(FromLocation)));
 }
 
-void UCustomAssetManager::LowPriorityStreamAsset(const FName& AssetId)
+bool UCustomAssetManager::GetLevelStreamingBounds(FName LevelName, FBox& OutBounds) const
 {
-    // Skip if already loaded
-    if (GetAssetById(AssetId) != nullptr)
+    UWorld* World = GetGameWorld();
+    if (!World)
     {
-        return;
+        return false;
     }
     
-    // Check if we have a path for this asset ID
-    FSoftObjectPath* AssetPath = AssetPathMap.Find(AssetId);
-    if (!AssetPath)
+    // The cache only holds bounds for the world whose actors are being tracked
+    const bool bUseCache = World == LevelBoundsWorld.Get();
+    if (bUseCache)
     {
-        UE_LOG(LogTemp, Warning, TEXT("Asset with ID %s not found for prefetching"), *AssetId.ToString());
-        return;
+        if (const FBox* CachedBounds = LevelBoundsCache.Find(LevelName))
+        {
+            OutBounds = *CachedBounds;
+            return true;
+        }
     }
     
-    // Create a low-priority streamable request
-    FStreamableManager& StreamableMgr = UAssetManager::GetStreamableManager();
-    
-    // Request async load without explicit priority (UE5.4 compatibility)
-    StreamableMgr.RequestAsyncLoad(
-        *AssetPath,
-        FStreamableDelegate::CreateUObject(this, &UCustomAssetManager::OnAssetLoaded, AssetId, *AssetPath)
-    );
+    for (const ULevelStreaming* StreamingLevel : World->GetStreamingLevels())
+    {
+        if (!StreamingLevel || GetLevelStreamingName(StreamingLevel->GetWorldAssetPackageName()) != LevelName)
+        {
+            continue;
+        }
+        
+        // A loaded level is as large as its actors, otherwise all that is known is where the level is placed
+        const FVector LevelLocation = StreamingLevel->LevelTransform.GetLocation();
+        const FBox ActorBounds = ComputeLevelActorBounds(StreamingLevel->GetLoadedLevel());
+        OutBounds = ActorBounds.IsValid ? ActorBounds : FBox(LevelLocation, LevelLocation);
+        
+        if (bUseCache)
+        {
+            LevelBoundsCache.Add(LevelName, OutBounds);
+        }
+        return true;
+    }
     
-    UE_LOG(LogTemp, Verbose, TEXT("Started low-priority prefetch for asset %s"), *AssetId.ToString());
+    return false;
 }
 
-//=================================================================
-// ASSET COMPRESSION TIERS IMPLEMENTATION
-//=================================================================
-
-void UCustomAssetManager::SetAssetCompressionTier(const FName& AssetId, EAssetCompressionTier Tier)
+FName UCustomAssetManager::GetLevelStreamingName(const FString& PackageName)
 {
-    if (!AssetId.IsNone())
-    {
-        // Store or update the asset's compression tier
-        AssetCompressionTiers.Add(AssetId, Tier);
-        
-        UE_LOG(LogTemp, Log, TEXT("Set compression tier for asset %s to %d"), 
-            *AssetId.ToString(), static_cast<int32>(Tier));
-    }
+    // Associations name levels without the PIE prefix
+    return FName(*FPaths::GetBaseFilename(UWorld::RemovePIEPrefix(PackageName)));
 }
 
-EAssetCompressionTier UCustomAssetManager::GetAssetCompressionTier(const FName& AssetId) const
+FBox UCustomAssetManager::ComputeLevelActorBounds(const ULevel* Level)
 {
-    // Look up the asset's compression tier
-    const EAssetCompressionTier* Tier = AssetCompressionTiers.Find(AssetId);
-    
-    if (Tier)
+    FBox LevelBounds(EForceInit::ForceInit);
+    if (!Level)
     {
-        // Return the registered tier
-        return *Tier;
+        return LevelBounds;
     }
     
-    // If no tier registered, return the default
-    return DefaultCompressionTier;
-}
-
-void UCustomAssetManager::SetDefaultCompressionTier(EAssetCompressionTier Tier)
-{
-    DefaultCompressionTier = Tier;
+    for (const AActor* Actor : Level->Actors)
+    {
+        if (Actor)
+        {
+            LevelBounds += Actor->GetComponentsBoundingBox();
+        }
+    }
     
-    UE_LOG(LogTemp, Log, TEXT("Set default compression tier to %d"), static_cast<int32>(Tier));
+    return LevelBounds;
 }
 
-bool UCustomAssetManager::RecompressAsset(const FName& AssetId, EAssetCompressionTier NewTier)
+void UCustomAssetManager::TrackLevelBounds(UWorld* World)
 {
-#if WITH_EDITOR
-    // In editor builds, we can actually recompress assets
-    
-    // Check if the asset exists
-    FSoftObjectPath* AssetPath = AssetPathMap.Find(AssetId);
-    if (!AssetPath)
+    if (World == LevelBoundsWorld.Get())
     {
-        UE_LOG(LogTemp, Warning, TEXT("Asset with ID %s not found for recompression"), *AssetId.ToString());
-        return false;
+        return;
     }
     
-    // Get the asset data
-    FAssetRegistryModule& AssetRegistryModule = FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry");
-    FAssetData AssetData = AssetRegistryModule.Get().GetAssetByObjectPath(*AssetPath);
-    
-    if (!AssetData.IsValid())
+    if (UWorld* PreviousWorld = LevelBoundsWorld.Get())
     {
-        UE_LOG(LogTemp, Warning, TEXT("Asset data for %s not valid"), *AssetId.ToString());
-        return false;
+        PreviousWorld->RemoveOnActorSpawnedHandler(ActorSpawnedHandle);
+        PreviousWorld->RemoveOnActorDestroyededHandler(ActorDestroyedHandle);
     }
     
-    // Get the package that contains the asset
-    UPackage* Package = AssetData.GetPackage();
-    if (!Package)
+    ActorSpawnedHandle.Reset();
+    ActorDestroyedHandle.Reset();
+    LevelBoundsCache.Empty();
+    LevelBoundsWorld = World;
+    
+    if (World)
     {
-        UE_LOG(LogTemp, Warning, TEXT("Could not get package for asset %s"), *AssetId.ToString());
-        return false;
+        ActorSpawnedHandle = World->AddOnActorSpawnedHandler(FOnActorSpawned::FDelegate::CreateUObject(this, &UCustomAssetManager::HandleActorSpawned));
+        ActorDestroyedHandle = World->AddOnActorDestroyedHandler(FOnActorDestroyed::FDelegate::CreateUObject(this, &UCustomAssetManager::HandleActorDestroyed));
     }
-    
-    // Determine compression settings based on tier
-    int32 CompressionLevel = 0;
-    switch (NewTier)
+}
+
+void UCustomAssetManager::HandleLevelAddedToWorld(ULevel* Level, UWorld* World)
+{
+    if (!Level || !World || World != GetGameWorld())
     {
-        case EAssetCompressionTier::None:
-            CompressionLevel = 0;
-            break;
-        case EAssetCompressionTier::Low:
-            CompressionLevel = 1;
-            break;
-        case EAssetCompressionTier::Medium:
-            CompressionLevel = 5;
-            break;
-        case EAssetCompressionTier::High:
-            CompressionLevel = 9;
-            break;
+        return;
     }
     
-    // Save package with new compression settings
-    FSavePackageArgs SaveArgs;
-    SaveArgs.TopLevelFlags = RF_Public | RF_Standalone;
-    SaveArgs.SaveFlags = SAVE_Async;
-    // CompressionLevel is not directly accessible in UE5.4
-    // Will use default compression for now
-    
-    // Save the package
-    bool bSuccess = UPackage::SavePackage(Package, nullptr, *Package->GetName(), SaveArgs);
+    TrackLevelBounds(World);
     
-    if (bSuccess)
+    // Walk the actors once now instead of on every distance check
+    const FBox ActorBounds = ComputeLevelActorBounds(Level);
+    if (ActorBounds.IsValid)
     {
-        // Update the asset's compression tier
-        SetAssetCompressionTier(AssetId, NewTier);
-        
-        UE_LOG(LogTemp, Log, TEXT("Successfully recompressed asset %s with tier %d"), 
-            *AssetId.ToString(), static_cast<int32>(NewTier));
+        LevelBoundsCache.Add(GetLevelStreamingName(Level->GetOutermost()->GetName()), ActorBounds);
     }
-    else
+}
+
+void UCustomAssetManager::HandleLevelRemovedFromWorld(ULevel* Level, UWorld* World)
+{
+    if (!World || World != LevelBoundsWorld.Get())
     {
-        UE_LOG(LogTemp, Warning, TEXT("Failed to recompress asset %s"), *AssetId.ToString());
+        return;
     }
     
-    return bSuccess;
-#else
-    // In non-editor builds, we can't recompress
-    UE_LOG(LogTemp, Warning, TEXT("Asset recompression is only available in editor builds"));
-    
-    // Still update the tier for future reference
-    SetAssetCompressionTier(AssetId, NewTier);
+    // A null level means every level was removed
+    if (!Level)
+    {
+        LevelBoundsCache.Empty();
+        return;
+    }
     
-    return false;
-#endif
+    LevelBoundsCache.Remove(GetLevelStreamingName(Level->GetOutermost()->GetName()));
 }
 
-int64 UCustomAssetManager::EstimateAssetSizeFromMetadata(const FName& AssetId) const
+void UCustomAssetManager::HandleActorSpawned(AActor* Actor)
 {
-    // This is a basic implementation - in a real system, you would store and retrieve
-    // actual size metadata for each asset
-    
-    // Look up the asset's compression tier
-    EAssetCompressionTier Tier = GetAssetCompressionTier(AssetId);
+    if (!Actor || LevelBoundsCache.Num() == 0)
+    {
+        return;
+    }
     
-    // Base size estimate
-    int64 BaseSize = 500 * 1024; // 500 KB base size
+    const ULevel* Level = Actor->GetLevel();
+    FBox* CachedBounds = Level ? LevelBoundsCache.Find(GetLevelStreamingName(Level->GetOutermost()->GetName())) : nullptr;
+    if (!CachedBounds)
+    {
+        return;
+    }
     
-    // Adjust based on compression tier
-    switch (Tier)
+    // A new actor can only grow the level
+    const FBox ActorBounds = Actor->GetComponentsBoundingBox();
+    if (ActorBounds.IsValid)
     {
-        case EAssetCompressionTier::None:
-            return BaseSize;
-        case EAssetCompressionTier::Low:
-            return BaseSize * 0.8;
-        case EAssetCompressionTier::Medium:
-            return BaseSize * 0.5;
-        case EAssetCompressionTier::High:
-            return BaseSize * 0.3;
-        default:
-            return BaseSize;
+        *CachedBounds += ActorBounds;
     }
 }
 
-//=================================================================
-// LEVEL STREAMING INTEGRATION IMPLEMENTATION
-//=================================================================
-
-void UCustomAssetManager::RegisterBundleWithLevel(FName BundleId, FName LevelName, float PreloadDistance, bool bUnloadWithLevel)
+void UCustomAssetManager::HandleActorDestroyed(AActor* Actor)
 {
-    if (BundleId.IsNone() || LevelName.IsNone())
+    if (!Actor || LevelBoundsCache.Num() == 0)
     {
-        UE_LOG(LogTemp, Warning, TEXT("Cannot register bundle with level: Invalid bundle ID or level name"));
         return;
     }
     
-    // Check if this association already exists
-    for (int32 i = 0; i < LevelBundleAssociations.Num(); ++i)
+    const ULevel* Level = Actor->GetLevel();
+    if (!Level)
     {
-        if (LevelBundleAssociations[i].BundleId == BundleId && 
-            LevelBundleAssociations[i].LevelName == LevelName)
-        {
-            // Update existing association
-            LevelBundleAssociations[i].PreloadDistance = PreloadDistance;
-            LevelBundleAssociations[i].bUnloadWithLevel = bUnloadWithLevel;
-            
-            UE_LOG(LogTemp, Log, TEXT("Updated bundle %s association with level %s (Preload distance: %.1f)"), 
-                *BundleId.ToString(), *LevelName.ToString(), PreloadDistance);
-            return;
-        }
+        return;
     }
     
-    // Create a new association
-    FBundleLevelAssociation NewAssociation;
-    NewAssociation.BundleId = BundleId;
-    NewAssociation.LevelName = LevelName;
-    NewAssociation.PreloadDistance = PreloadDistance;
-    NewAssociation.bUnloadWithLevel = bUnloadWithLevel;
-    
-    // Add to the list
-    LevelBundleAssociations.Add(NewAssociation);
-    
-    UE_LOG(LogTemp, Log, TEXT("Registered bundle %s with level %s (Preload distance: %.1f)"), 
-        *BundleId.ToString(), *LevelName.ToString(), PreloadDistance);
+    const FName LevelName = GetLevelStreamingName(Level->GetOutermost()->GetName());
+    const FBox* CachedBounds = LevelBoundsCache.Find(LevelName);
+    if (!CachedBounds)
+    {
+        return;
+    }
     
-    // If the level is already loaded, preload the bundle now
-    if (LoadedLevels.Contains(LevelName))
+    // Removing an actor strictly inside the bounds cannot shrink them, anything else is recomputed on the next query
+    const FBox ActorBounds = Actor->GetComponentsBoundingBox();
+    if (!ActorBounds.IsValid || !CachedBounds->IsInside(ActorBounds))
     {
-        UE_LOG(LogTemp, Log, TEXT("Level %s is already loaded, preloading bundle %s now"), 
-            *LevelName.ToString(), *BundleId.ToString());
-        LoadBundle(BundleId, EAssetLoadingStrategy::Streaming);
+        LevelBoundsCache.Remove(LevelName);
     }
 }
 
-void UCustomAssetManager::UnregisterBundleFromLevel(FName BundleId, FName LevelName)
+void UCustomAssetManager::OnLevelLoaded(FName LevelName)
 {
-    if (BundleId.IsNone() || LevelName.IsNone())
+    if (!LevelName.IsNone())
     {
-        return;
+        // Add to loaded levels set
+        LoadedLevels.Add(LevelName);
+        
+        UE_LOG(LogTemp, Log, TEXT("Level %s loaded, checking for associated bundles"), 
+            *LevelName.ToString());
+        
+        RecordLevelTransition(LevelName);
+        
+        // Load any bundles associated with this level
+        for (const FBundleLevelAssociation& Association : LevelBundleAssociations)
+        {
+            if (Association.LevelName == LevelName)
+            {
+                UE_LOG(LogTemp, Log, TEXT("Loading bundle %s for level %s"), 
+                    *Association.BundleId.ToString(), *LevelName.ToString());
+                
+                AcquireBundle(Association.BundleId, Association.OwnerId, EAssetLoadingStrategy::Streaming);
+            }
+        }
+        
+        // The level now holds its own bundles, so a correct prediction carries over without a reload
+        PredictNextLevels(LevelName);
     }
+}
+
+void UCustomAssetManager::RecordLevelTransition(FName LevelName)
+{
+    const double Now = FPlatformTime::Seconds();
     
-    // Find and remove the association
-    for (int32 i = LevelBundleAssociations.Num() - 1; i >= 0; --i)
+    if (bPredictLevelTransitions && LevelTransitionModel && !LastLoadedLevelName.IsNone() && LastLoadedLevelName != LevelName)
     {
-        if (LevelBundleAssociations[i].BundleId == BundleId && 
-            LevelBundleAssociations[i].LevelName == LevelName)
+        LevelTransitionModel->RecordTransition(LastLoadedLevelName, LevelName, Now - LastLevelLoadTime);
+        
+        // Score the prediction made when the previous level loaded
+        if (PredictedNextLevels.Num() > 0)
         {
-            LevelBundleAssociations.RemoveAt(i);
+            const bool bHit = PredictedNextLevels.Contains(LevelName);
+            LevelTransitionModel->RecordPredictionOutcome(bHit);
             
-            UE_LOG(LogTemp, Log, TEXT("Unregistered bundle %s from level %s"), 
-                *BundleId.ToString(), *LevelName.ToString());
+            UE_LOG(LogTemp, Log, TEXT("Level transition %s -> %s was %s (hit rate %.1f%% over %d predictions)"), 
+                *LastLoadedLevelName.ToString(), *LevelName.ToString(), bHit ? TEXT("predicted") : TEXT("not predicted"),
+                LevelTransitionModel->GetPredictionHitRate() * 100.0f, LevelTransitionModel->GetPredictionCount());
         }
     }
+    
+    LastLoadedLevelName = LevelName;
+    LastLevelLoadTime = Now;
 }
 
-void UCustomAssetManager::UpdateLevelBasedBundles(APlayerController* PlayerController)
+void UCustomAssetManager::PredictNextLevels(FName LevelName)
 {
-    if (!PlayerController)
-    {
-        return;
-    }
+    // Whatever was held for the previous prediction goes back to normal reference counting
+    ReleaseAllBundlesForOwner(GetPredictionBundleOwner());
+    PredictedNextLevels.Reset();
+    PendingPredictiveBundles.Reset();
+    PredictivePrefetchResidentBytes = 0;
+    PredictivePrefetchDiskBytes = 0;
     
-    // Get player pawn and its location
-    APawn* PlayerPawn = PlayerController->GetPawn();
-    if (!PlayerPawn)
+    if (!bPredictLevelTransitions || !LevelTransitionModel)
     {
         return;
     }
     
-    FVector PlayerLocation = PlayerPawn->GetActorLocation();
-    
-    // Process each level-bundle association
-    for (const FBundleLevelAssociation& Association : LevelBundleAssociations)
+    for (const TPair<FName, float>& Prediction : LevelTransitionModel->PredictNextLevels(LevelName, MaxPredictedLevels, LevelTransitionMinProbability))
     {
-        // Skip if level not loaded
-        if (!LoadedLevels.Contains(Association.LevelName))
-        {
-            continue;
-        }
+        PredictedNextLevels.Add(Prediction.Key);
         
-        // Get distance to level
-        float Distance = GetDistanceToLevel(Association.LevelName, PlayerLocation);
-        
-        // If within preload distance, load the bundle
-        if (Distance <= Association.PreloadDistance)
-        {
-            UCustomAssetBundle* Bundle = GetBundleById(Association.BundleId);
-            
-            // Check if bundle exists and isn't already loaded
-            if (Bundle && !Bundle->bIsLoaded)
-            {
-                UE_LOG(LogTemp, Verbose, TEXT("Player is within %.1f units of level %s, loading bundle %s"), 
-                    Distance, *Association.LevelName.ToString(), *Association.BundleId.ToString());
-                
-                LoadBundle(Association.BundleId, EAssetLoadingStrategy::Streaming);
-            }
-        }
-        // If outside unload distance, unload the bundle
-        else if (Distance > Association.PreloadDistance * 2.0f)
+        for (const FBundleLevelAssociation& Association : LevelBundleAssociations)
         {
-            UCustomAssetBundle* Bundle = GetBundleById(Association.BundleId);
-            
-            // Check if bundle exists and is loaded
-            if (Bundle && Bundle->bIsLoaded && !Bundle->bKeepInMemory)
+            if (Association.LevelName == Prediction.Key)
             {
-                UE_LOG(LogTemp, Verbose, TEXT("Player is %.1f units from level %s, unloading bundle %s"), 
-                    Distance, *Association.LevelName.ToString(), *Association.BundleId.ToString());
-                
-                UnloadBundle(Association.BundleId);
+                PendingPredictiveBundles.AddUnique(Association.BundleId);
             }
         }
+        
+        UE_LOG(LogTemp, Log, TEXT("Predicted level %s after %s (%.0f%%, usually after %.1f s)"), 
+            *Prediction.Key.ToString(), *LevelName.ToString(), Prediction.Value * 100.0f,
+            LevelTransitionModel->GetExpectedTransitionSeconds(LevelName, Prediction.Key));
     }
 }
 
-float UCustomAssetManager::GetDistanceToLevel(FName LevelName, const FVector& FromLocation) const
+void UCustomAssetManager::ProcessPredictivePrefetches()
 {
-    // In a real implementation, you would use the level bounds or streaming volumes
-    // For this example, we'll use a simple approach
+    if (PendingPredictiveBundles.Num() == 0)
+    {
+        return;
+    }
     
-    // Get the world
-    UWorld* World = GEngine->GetWorldFromContextObject(this, EGetWorldErrorMode::ReturnNull);
-    if (!World)
+    // Guesses only use idle I/O and never delay a bundle or level that is actually needed
+    if (ActiveBundleLoads.Num() > 0 || DeferredBundleLoads.Num() > 0 || IsAsyncLoading())
     {
-        return FLT_MAX;
+        return;
     }
     
-    // Look for the level
-    for (const ULevelStreaming* StreamingLevel : World->GetStreamingLevels())
+    LLM_SCOPE_BYTAG(CustomAssets_Bundles);
+    
+    const int64 ResidentBudget = static_cast<int64>(PredictivePrefetchMemoryBudgetMB) * 1024 * 1024;
+    const int64 DiskBudget = static_cast<int64>(PredictivePrefetchIOBudgetMB) * 1024 * 1024;
+    const int64 LoadedBytes = MemoryTracker ? MemoryTracker->GetLoadedMemoryUsage() : 0;
+    
+    while (PendingPredictiveBundles.Num() > 0)
     {
-        // UE5.4 compatible way to get level name
-        FString StreamingLevelName = StreamingLevel->GetWorldAssetPackageName();
-        FName StreamingLevelFName = FName(*FPaths::GetBaseFilename(StreamingLevelName));
+        const FName BundleId = PendingPredictiveBundles[0];
+        PendingPredictiveBundles.RemoveAt(0);
         
-        if (StreamingLevel && StreamingLevelFName == LevelName)
+        const UCustomAssetBundle* Bundle = GetBundleById(BundleId);
+        if (!::IsValid(Bundle))
         {
-            // If level is loaded, use its bounds
-            if (StreamingLevel->IsLevelLoaded())
-            {
-                ULevel* Level = StreamingLevel->GetLoadedLevel();
-                if (Level)
-                {
-                    // UE5.4 compatible way to get level bounds - more generic approach
-                    FBox LevelBounds(EForceInit::ForceInit);
-                    for (AActor* Actor : Level->Actors)
-                    {
-                        if (Actor)
-                        {
-                            LevelBounds += Actor->GetComponentsBoundingBox();
-                        }
-                    }
-                    
-                    if (LevelBounds.IsValid == 0)
-                    {
-                        // Fallback to level transform if bounds are invalid
-                        return FVector::Distance(FromLocation, StreamingLevel->LevelTransform.GetLocation());
-                    }
-                    
-                    // Fix for UE5.4 - use FVector::DistSquared for squared distance calculation
-                    return FVector::DistSquared(FromLocation, LevelBounds.GetCenter());
-                }
-            }
-            
-            // If level is not loaded, use its transform
-            FTransform LevelTransform = StreamingLevel->LevelTransform;
-            // Fix for UE5.4 - use FVector::Distance for regular distance calculation
-            return FVector::Distance(FromLocation, LevelTransform.GetLocation());
+            continue;
         }
-    }
-    
-    // Level not found
-    return FLT_MAX;
-}
-
-void UCustomAssetManager::OnLevelLoaded(FName LevelName)
-{
-    if (!LevelName.IsNone())
-    {
-        // Add to loaded levels set
-        LoadedLevels.Add(LevelName);
         
-        UE_LOG(LogTemp, Log, TEXT("Level %s loaded, checking for associated bundles"), 
-            *LevelName.ToString());
+        // A loaded bundle costs nothing to hold and is kept from lingering out
+        if (Bundle->bIsLoaded)
+        {
+            AcquireBundle(BundleId, GetPredictionBundleOwner(), EAssetLoadingStrategy::Streaming);
+            continue;
+        }
         
-        // Load any bundles associated with this level
-        for (const FBundleLevelAssociation& Association : LevelBundleAssociations)
+        const int64 ResidentBytes = GetBundleLoadCost(Bundle);
+        const int64 DiskBytes = Bundle->Manifest.EstimatedDiskBytes;
+        if (PredictivePrefetchResidentBytes + ResidentBytes > ResidentBudget || PredictivePrefetchDiskBytes + DiskBytes > DiskBudget
+            || (MemoryThreshold > 0 && LoadedBytes + ResidentBytes > MemoryThreshold))
         {
-            if (Association.LevelName == LevelName)
-            {
-                UE_LOG(LogTemp, Log, TEXT("Loading bundle %s for level %s"), 
-                    *Association.BundleId.ToString(), *LevelName.ToString());
-                
-                LoadBundle(Association.BundleId, EAssetLoadingStrategy::Streaming);
-            }
+            UE_LOG(LogTemp, Verbose, TEXT("Skipping predictive prefetch of bundle %s: over budget"), *BundleId.ToString());
+            continue;
         }
+        
+        PredictivePrefetchResidentBytes += ResidentBytes;
+        PredictivePrefetchDiskBytes += DiskBytes;
+        AcquireBundle(BundleId, GetPredictionBundleOwner(), EAssetLoadingStrategy::Streaming);
+        
+        // One load at a time, the next waits until the disk is idle again
+        break;
     }
 }
 
@@ -2287,6 +5350,7 @@ void UCustomAssetManager::OnLevelUnloaded(FName LevelName)
     {
         // Remove from loaded levels set
         LoadedLevels.Remove(LevelName);
+        bReachabilityDirty = true;
         
         UE_LOG(LogTemp, Log, TEXT("Level %s unloaded, checking for associated bundles"), 
             *LevelName.ToString());
@@ -2296,10 +5360,11 @@ void UCustomAssetManager::OnLevelUnloaded(FName LevelName)
         {
             if (Association.LevelName == LevelName && Association.bUnloadWithLevel)
             {
-                UE_LOG(LogTemp, Log, TEXT("Unloading bundle %s for level %s"), 
+                UE_LOG(LogTemp, Log, TEXT("Releasing bundle %s for level %s"), 
                     *Association.BundleId.ToString(), *LevelName.ToString());
                 
-                UnloadBundle(Association.BundleId);
+                // Bundles still held by other levels or systems stay loaded
+                ReleaseBundle(Association.BundleId, Association.OwnerId);
             }
         }
     }
@@ -2477,4 +5542,314 @@ void UCustomAssetManager::NotifyHotswapListeners(const FName& AssetId)
             HotswapListeners.RemoveAt(i);
         }
     }
-} 
\ No newline at end of file
+}
+
+//=================================================================
+// PRESENTATION QUALITY VARIANTS IMPLEMENTATION
+//=================================================================
+
+UObject* UCustomAssetManager::ResolvePresentationMesh(UCustomAssetBase* Asset, float Distance)
+{
+    LLM_SCOPE_BYTAG(CustomAssets_StreamedResources);
+    
+    if (!::IsValid(Asset))
+    {
+        return nullptr;
+    }
+    
+    // Only items and characters carry mesh variants
+    FSoftObjectPath HighDetailPath;
+    FSoftObjectPath LowDetailPath;
+    float SwitchDistance = 0.0f;
+    if (const UCustomItemAsset* ItemAsset = Cast<UCustomItemAsset>(Asset))
+    {
+        HighDetailPath = ItemAsset->ItemMesh.ToSoftObjectPath();
+        LowDetailPath = ItemAsset->bUseLOD ? ItemAsset->LowDetailMesh.ToSoftObjectPath() : FSoftObjectPath();
+        SwitchDistance = ItemAsset->LODSwitchDistance;
+    }
+    else if (const UCustomCharacterAsset* CharacterAsset = Cast<UCustomCharacterAsset>(Asset))
+    {
+        HighDetailPath = CharacterAsset->CharacterMesh.ToSoftObjectPath();
+        LowDetailPath = CharacterAsset->bUseLOD ? CharacterAsset->LowDetailMesh.ToSoftObjectPath() : FSoftObjectPath();
+        SwitchDistance = CharacterAsset->LODSwitchDistance;
+    }
+    else
+    {
+        return nullptr;
+    }
+    
+    // Low detail is served beyond the switch distance, and at any distance while over budget
+    const bool bHasLowDetail = !LowDetailPath.IsNull();
+    const bool bWantLowDetail = bHasLowDetail && (Distance >= SwitchDistance || bPresentationLowDetail);
+    const FSoftObjectPath& WantedPath = bWantLowDetail ? LowDetailPath : HighDetailPath;
+    const FSoftObjectPath& OtherPath = bWantLowDetail ? HighDetailPath : LowDetailPath;
+    
+    if (WantedPath.IsNull())
+    {
+        return nullptr;
+    }
+    
+    // Without a budget there is nothing to track, so nothing is held beyond what the caller keeps
+    if (PresentationBudgetMB <= 0)
+    {
+        return WantedPath.TryLoad();
+    }
+    
+    FPresentationVariantState& State = PresentationVariants.FindOrAdd(Asset->AssetId);
+    State.HighDetailPath = HighDetailPath;
+    State.LowDetailPath = LowDetailPath;
+    
+    // Make sure the wanted variant is (or becomes) held by a handle
+    RequestPresentationVariant(Asset->AssetId, bWantLowDetail);
+    
+    if (UObject* Mesh = WantedPath.ResolveObject())
+    {
+        return Mesh;
+    }
+    
+    // Serve the other variant while the wanted one streams in
+    if (UObject* Fallback = OtherPath.ResolveObject())
+    {
+        return Fallback;
+    }
+    
+    // Nothing resident yet, load the wanted variant synchronously like the distance-only path did
+    return WantedPath.TryLoad();
+}
+
+void UCustomAssetManager::SetPresentationBudget(int32 BudgetMB)
+{
+    PresentationBudgetMB = FMath::Max(0, BudgetMB);
+    UpdatePresentationQuality();
+}
+
+int64 UCustomAssetManager::GetPresentationMemoryUsage() const
+{
+    int64 Usage = 0;
+    for (const TPair<FName, FPresentationVariantState>& Pair : PresentationVariants)
+    {
+        const FPresentationVariantState& State = Pair.Value;
+        if (State.HighDetailHandle.IsValid() && State.HighDetailHandle->HasLoadCompleted())
+        {
+            Usage += State.HighDetailBytes;
+        }
+        if (State.LowDetailHandle.IsValid() && State.LowDetailHandle->HasLoadCompleted())
+        {
+            Usage += State.LowDetailBytes;
+        }
+    }
+    return Usage;
+}
+
+bool UCustomAssetManager::IsPresentationLowDetail() const
+{
+    return bPresentationLowDetail;
+}
+
+void UCustomAssetManager::RequestPresentationVariant(const FName& AssetId, bool bLowDetail)
+{
+    FPresentationVariantState* State = PresentationVariants.Find(AssetId);
+    if (!State)
+    {
+        return;
+    }
+    
+    (bLowDetail ? State->LowDetailRequestTime : State->HighDetailRequestTime) = FPlatformTime::Seconds();
+    
+    TSharedPtr<FStreamableHandle>& Handle = bLowDetail ? State->LowDetailHandle : State->HighDetailHandle;
+    const FSoftObjectPath& Path = bLowDetail ? State->LowDetailPath : State->HighDetailPath;
+    if (Handle.IsValid() || Path.IsNull())
+    {
+        return;
+    }
+    
+    if (!bLowDetail)
+    {
+        State->bDowngraded = false;
+    }
+    
+    Handle = UAssetManager::GetStreamableManager().RequestAsyncLoad(
+        Path,
+        FStreamableDelegate::CreateUObject(this, &UCustomAssetManager::OnPresentationVariantLoaded, AssetId, bLowDetail)
+    );
+    
+    // An already resident variant completes inside RequestAsyncLoad, before the handle is stored
+    if (Handle.IsValid() && Handle->HasLoadCompleted())
+    {
+        OnPresentationVariantLoaded(AssetId, bLowDetail);
+    }
+}
+
+void UCustomAssetManager::OnPresentationVariantLoaded(FName AssetId, bool bLowDetail)
+{
+    FPresentationVariantState* State = PresentationVariants.Find(AssetId);
+    if (!State)
+    {
+        return;
+    }
+    
+    TSharedPtr<FStreamableHandle>& Handle = bLowDetail ? State->LowDetailHandle : State->HighDetailHandle;
+    UObject* Mesh = Handle.IsValid() ? Handle->GetLoadedAsset() : nullptr;
+    if (Mesh)
+    {
+        (bLowDetail ? State->LowDetailBytes : State->HighDetailBytes) = Mesh->GetResourceSizeBytes(EResourceSizeMode::EstimatedTotal);
+    }
+    
+    // A downgrade only releases the high detail variant once its replacement is resident
+    if (bLowDetail && State->bDowngraded && State->HighDetailHandle.IsValid())
+    {
+        State->HighDetailHandle->ReleaseHandle();
+        State->HighDetailHandle.Reset();
+    }
+}
+
+void UCustomAssetManager::ReleasePresentationVariants(const FName& AssetId)
+{
+    FPresentationVariantState* State = PresentationVariants.Find(AssetId);
+    if (!State)
+    {
+        return;
+    }
+    
+    if (State->HighDetailHandle.IsValid())
+    {
+        State->HighDetailHandle->ReleaseHandle();
+    }
+    if (State->LowDetailHandle.IsValid())
+    {
+        State->LowDetailHandle->ReleaseHandle();
+    }
+    
+    PresentationVariants.Remove(AssetId);
+}
+
+void UCustomAssetManager::ReleaseIdlePresentationVariants()
+{
+    const double IdleBefore = FPlatformTime::Seconds() - PresentationVariantIdleSeconds;
+    
+    for (auto It = PresentationVariants.CreateIterator(); It; ++It)
+    {
+        FPresentationVariantState& State = It.Value();
+        
+        // Keep a variant while it is the only one resident, it is still served as the fallback
+        const bool bHighResident = State.HighDetailHandle.IsValid() && State.HighDetailHandle->HasLoadCompleted();
+        const bool bLowResident = State.LowDetailHandle.IsValid() && State.LowDetailHandle->HasLoadCompleted();
+        
+        if (State.HighDetailHandle.IsValid() && State.HighDetailRequestTime < IdleBefore && (bLowResident || State.LowDetailRequestTime < IdleBefore))
+        {
+            State.HighDetailHandle->ReleaseHandle();
+            State.HighDetailHandle.Reset();
+        }
+        
+        if (State.LowDetailHandle.IsValid() && State.LowDetailRequestTime < IdleBefore && (bHighResident || State.HighDetailRequestTime < IdleBefore))
+        {
+            State.LowDetailHandle->ReleaseHandle();
+            State.LowDetailHandle.Reset();
+        }
+        
+        if (!State.HighDetailHandle.IsValid() && !State.LowDetailHandle.IsValid())
+        {
+            It.RemoveCurrent();
+        }
+    }
+}
+
+void UCustomAssetManager::UpdatePresentationQuality()
+{
+    if (PresentationBudgetMB <= 0)
+    {
+        if (bPresentationLowDetail)
+        {
+            SetPresentationLowDetail(false);
+        }
+        
+        // Handles are only held while a budget is enforced
+        TArray<FName> AssetIds;
+        PresentationVariants.GetKeys(AssetIds);
+        for (const FName& AssetId : AssetIds)
+        {
+            ReleasePresentationVariants(AssetId);
+        }
+        return;
+    }
+    
+    ReleaseIdlePresentationVariants();
+    
+    const int64 Budget = static_cast<int64>(PresentationBudgetMB) * 1024 * 1024;
+    const int64 Usage = GetPresentationMemoryUsage();
+    
+    if (!bPresentationLowDetail)
+    {
+        if (Usage > Budget)
+        {
+            UE_LOG(LogTemp, Log, TEXT("Presentation memory %lld bytes exceeds budget of %d MB, switching to low detail variants"), Usage, PresentationBudgetMB);
+            SetPresentationLowDetail(true);
+        }
+        return;
+    }
+    
+    // Upgrade only when the high detail variants would fit comfortably again
+    int64 ProjectedUsage = Usage;
+    for (const TPair<FName, FPresentationVariantState>& Pair : PresentationVariants)
+    {
+        if (Pair.Value.bDowngraded)
+        {
+            ProjectedUsage += Pair.Value.HighDetailBytes;
+        }
+    }
+    
+    if (ProjectedUsage <= static_cast<int64>(Budget * PresentationRecoveryFraction))
+    {
+        UE_LOG(LogTemp, Log, TEXT("Presentation memory pressure cleared (projected %lld bytes), switching back to high detail variants"), ProjectedUsage);
+        SetPresentationLowDetail(false);
+    }
+}
+
+void UCustomAssetManager::SetPresentationLowDetail(bool bLowDetail)
+{
+    if (bPresentationLowDetail == bLowDetail)
+    {
+        return;
+    }
+    
+    bPresentationLowDetail = bLowDetail;
+    
+    for (TPair<FName, FPresentationVariantState>& Pair : PresentationVariants)
+    {
+        FPresentationVariantState& State = Pair.Value;
+        if (State.LowDetailPath.IsNull())
+        {
+            // Nothing to switch to
+            continue;
+        }
+        
+        if (bLowDetail)
+        {
+            // Stream the low detail variant, the high detail one is released once it is resident
+            if (State.HighDetailHandle.IsValid())
+            {
+                State.bDowngraded = true;
+                
+                if (State.LowDetailHandle.IsValid())
+                {
+                    // Already held, release the high detail variant right away if it is resident
+                    if (State.LowDetailHandle->HasLoadCompleted())
+                    {
+                        OnPresentationVariantLoaded(Pair.Key, true);
+                    }
+                }
+                else
+                {
+                    RequestPresentationVariant(Pair.Key, true);
+                }
+            }
+        }
+        else if (State.bDowngraded)
+        {
+            // Bring back what was released under pressure
+            RequestPresentationVariant(Pair.Key, false);
+        }
+    }
+    
+    OnPresentationQualityChanged.Broadcast(bLowDetail);
+}
@@ -1,5 +1,7 @@
 #include "Assets/CustomAssetMemoryTracker.h"
+#include "Assets/CustomAssetLLM.h"
 #include "Misc/FileHelper.h"
+#include "Serialization/MemoryWriter.h"
 
 // Initialize the singleton instance
 UCustomAssetMemoryTracker* UCustomAssetMemoryTracker::Instance = nullptr;
@@ -15,6 +17,8 @@ UCustomAssetMemoryTracker::UCustomAssetMemoryTracker()
 
 UCustomAssetMemoryTracker& UCustomAssetMemoryTracker::Get()
 {
+    LLM_SCOPE_BYTAG(CustomAssets_MemoryTracker);
+    
     if (!Instance)
     {
         // Create a new instance if one doesn't exist
@@ -27,6 +31,8 @@ UCustomAssetMemoryTracker& UCustomAssetMemoryTracker::Get()
 
 void UCustomAssetMemoryTracker::TrackAsset(const FName& AssetId, int64 MemoryUsage)
 {
+    LLM_SCOPE_BYTAG(CustomAssets_MemoryTracker);
+    
     // Create new memory stats for the asset
     FAssetMemoryStats Stats;
     Stats.AssetId = AssetId;
@@ -36,8 +42,21 @@ void UCustomAssetMemoryTracker::TrackAsset(const FName& AssetId, int64 MemoryUsa
     Stats.AccessCount = 1;
     Stats.bIsLoaded = true;
 
+    // Replace any previous entry in the loaded totals, keeping how often the asset was evicted before
+    const FAssetMemoryStats* PreviousStats = MemoryStats.Find(AssetId);
+    if (PreviousStats && PreviousStats->bIsLoaded)
+    {
+        LoadedMemoryUsage -= PreviousStats->MemoryUsage;
+        --LoadedAssetCount;
+    }
+    Stats.EvictionCount = PreviousStats ? PreviousStats->EvictionCount : 0;
+    LoadedMemoryUsage += MemoryUsage;
+    ++LoadedAssetCount;
+
     // Add to the map
     MemoryStats.Add(AssetId, Stats);
+
+    UpdateHighWaterMarks(AssetId);
 }
 
 void UCustomAssetMemoryTracker::UpdateAssetMemoryUsage(const FName& AssetId, int64 MemoryUsage)
@@ -52,6 +71,10 @@ void UCustomAssetMemoryTracker::UpdateAssetMemoryUsage(const FName& AssetId, int
     }
 
     // Update memory usage
+    if (Stats->bIsLoaded)
+    {
+        LoadedMemoryUsage += MemoryUsage - Stats->MemoryUsage;
+    }
     Stats->MemoryUsage = MemoryUsage;
 
     // Update peak memory usage if needed
@@ -59,6 +82,8 @@ void UCustomAssetMemoryTracker::UpdateAssetMemoryUsage(const FName& AssetId, int
     {
         Stats->PeakMemoryUsage = MemoryUsage;
     }
+
+    UpdateHighWaterMarks(AssetId);
 }
 
 void UCustomAssetMemoryTracker::RecordAssetAccess(const FName& AssetId)
@@ -84,6 +109,13 @@ void UCustomAssetMemoryTracker::SetAssetLoadedState(const FName& AssetId, bool b
         return;
     }
 
+    // Keep the loaded totals in sync
+    if (Stats->bIsLoaded != bIsLoaded)
+    {
+        LoadedMemoryUsage += bIsLoaded ? Stats->MemoryUsage : -Stats->MemoryUsage;
+        LoadedAssetCount += bIsLoaded ? 1 : -1;
+    }
+
     // Update loaded state
     Stats->bIsLoaded = bIsLoaded;
 
@@ -92,6 +124,10 @@ void UCustomAssetMemoryTracker::SetAssetLoadedState(const FName& AssetId, bool b
     {
         Stats->MemoryUsage = 0;
     }
+    else
+    {
+        UpdateHighWaterMarks(AssetId);
+    }
 }
 
 FAssetMemoryStats UCustomAssetMemoryTracker::GetAssetMemoryStats(const FName& AssetId) const
@@ -109,6 +145,11 @@ FAssetMemoryStats UCustomAssetMemoryTracker::GetAssetMemoryStats(const FName& As
     return *Stats;
 }
 
+bool UCustomAssetMemoryTracker::IsAssetTracked(const FName& AssetId) const
+{
+    return MemoryStats.Contains(AssetId);
+}
+
 int64 UCustomAssetMemoryTracker::GetTotalMemoryUsage() const
 {
     int64 TotalMemory = 0;
@@ -124,18 +165,8 @@ int64 UCustomAssetMemoryTracker::GetTotalMemoryUsage() const
 
 int64 UCustomAssetMemoryTracker::GetLoadedMemoryUsage() const
 {
-    int64 LoadedMemory = 0;
-
-    // Sum up memory usage for loaded assets
-    for (const auto& Pair : MemoryStats)
-    {
-        if (Pair.Value.bIsLoaded)
-        {
-            LoadedMemory += Pair.Value.MemoryUsage;
-        }
-    }
-
-    return LoadedMemory;
+    // Maintained incrementally by TrackAsset, UpdateAssetMemoryUsage and SetAssetLoadedState
+    return LoadedMemoryUsage;
 }
 
 TArray<FAssetMemoryStats> UCustomAssetMemoryTracker::GetAllMemoryStats() const
@@ -193,7 +224,7 @@ TArray<FName> UCustomAssetMemoryTracker::GetMostFrequentlyUsedAssets(int32 Count
 
 bool UCustomAssetMemoryTracker::ExportMemoryStatsToCSV(const FString& FilePath) const
 {
-    FString CSVContent = "AssetId,MemoryUsage,PeakMemoryUsage,LastAccessTime,AccessCount,IsLoaded\n";
+    FString CSVContent = "AssetId,MemoryUsage,PeakMemoryUsage,LastAccessTime,AccessCount,IsLoaded,EvictionCount\n";
 
     // Get all memory stats
     TArray<FAssetMemoryStats> AllStats = GetAllMemoryStats();
@@ -206,15 +237,199 @@ bool UCustomAssetMemoryTracker::ExportMemoryStatsToCSV(const FString& FilePath)
     // Add each asset's stats to the CSV
     for (const FAssetMemoryStats& Stats : AllStats)
     {
-        CSVContent += FString::Printf(TEXT("%s,%lld,%lld,%s,%d,%s\n"),
+        CSVContent += FString::Printf(TEXT("%s,%lld,%lld,%s,%d,%s,%d\n"),
             *Stats.AssetId.ToString(),
             Stats.MemoryUsage,
             Stats.PeakMemoryUsage,
             *Stats.LastAccessTime.ToString(),
             Stats.AccessCount,
-            Stats.bIsLoaded ? TEXT("True") : TEXT("False"));
+            Stats.bIsLoaded ? TEXT("True") : TEXT("False"),
+            Stats.EvictionCount);
     }
 
     // Write the CSV file
     return FFileHelper::SaveStringToFile(CSVContent, *FilePath);
-} 
\ No newline at end of file
+}
+
+// MEMORY TIMELINE
+
+void UCustomAssetMemoryTracker::SetTimelineCapacity(int32 Capacity)
+{
+    LLM_SCOPE_BYTAG(CustomAssets_MemoryTracker);
+    
+    TimelineCapacity = FMath::Max(1, Capacity);
+    TimelineSamples.Empty(TimelineCapacity);
+    TimelineHead = 0;
+}
+
+void UCustomAssetMemoryTracker::RecordTimelineSample(int64 PrefetchBytes, int64 PinnedBytes)
+{
+    LLM_SCOPE_BYTAG(CustomAssets_MemoryTracker);
+    
+    FAssetMemorySample Sample;
+    Sample.Timestamp = FDateTime::Now();
+    Sample.LoadedBytes = LoadedMemoryUsage;
+    Sample.LoadedCount = LoadedAssetCount;
+    Sample.Evictions = EvictionsSinceLastSample;
+    Sample.PrefetchBytes = PrefetchBytes;
+    Sample.PinnedBytes = PinnedBytes;
+
+    EvictionsSinceLastSample = 0;
+
+    // Grow until the capacity is reached, then overwrite the oldest sample
+    if (TimelineSamples.Num() < TimelineCapacity)
+    {
+        TimelineSamples.Add(Sample);
+    }
+    else
+    {
+        TimelineSamples[TimelineHead] = Sample;
+        TimelineHead = (TimelineHead + 1) % TimelineCapacity;
+    }
+}
+
+void UCustomAssetMemoryTracker::RecordEviction(const FName& AssetId)
+{
+    ++EvictionsSinceLastSample;
+
+    // Assets that keep getting evicted and reloaded show up in the per-asset stats
+    if (FAssetMemoryStats* Stats = MemoryStats.Find(AssetId))
+    {
+        ++Stats->EvictionCount;
+    }
+}
+
+TArray<FAssetMemorySample> UCustomAssetMemoryTracker::GetTimelineSamples() const
+{
+    TArray<FAssetMemorySample> OrderedSamples;
+    OrderedSamples.Reserve(TimelineSamples.Num());
+
+    // The oldest sample sits at the head once the ring buffer has wrapped
+    for (int32 i = 0; i < TimelineSamples.Num(); ++i)
+    {
+        OrderedSamples.Add(TimelineSamples[(TimelineHead + i) % TimelineSamples.Num()]);
+    }
+
+    return OrderedSamples;
+}
+
+FAssetMemoryHighWaterMark UCustomAssetMemoryTracker::GetLoadedBytesHighWaterMark() const
+{
+    return LoadedBytesHighWaterMark;
+}
+
+FAssetMemoryHighWaterMark UCustomAssetMemoryTracker::GetLoadedCountHighWaterMark() const
+{
+    return LoadedCountHighWaterMark;
+}
+
+bool UCustomAssetMemoryTracker::PushLoadContext(const FName& AssetId, const FName& BundleId, const TCHAR* CallSite)
+{
+    // Nested loads (dependencies, bundle members) are attributed to the outermost request
+    if (bHasLoadContext)
+    {
+        return false;
+    }
+
+    ContextAssetId = AssetId;
+    ContextBundleId = BundleId;
+    ContextCallSite = CallSite;
+    bHasLoadContext = true;
+    return true;
+}
+
+void UCustomAssetMemoryTracker::PopLoadContext()
+{
+    ContextAssetId = NAME_None;
+    ContextBundleId = NAME_None;
+    ContextCallSite.Reset();
+    bHasLoadContext = false;
+}
+
+void UCustomAssetMemoryTracker::UpdateHighWaterMarks(const FName& AssetId)
+{
+    auto UpdateMark = [this, &AssetId](FAssetMemoryHighWaterMark& Mark, int64 Value)
+    {
+        if (Value <= Mark.Value)
+        {
+            return;
+        }
+
+        Mark.Value = Value;
+        // Attribute to the outermost load request, or to the asset itself if none is active
+        Mark.AssetId = bHasLoadContext && !ContextAssetId.IsNone() ? ContextAssetId : AssetId;
+        Mark.BundleId = ContextBundleId;
+        Mark.CallSite = bHasLoadContext ? ContextCallSite : TEXT("Unknown");
+        Mark.Timestamp = FDateTime::Now();
+    };
+
+    UpdateMark(LoadedBytesHighWaterMark, LoadedMemoryUsage);
+    UpdateMark(LoadedCountHighWaterMark, LoadedAssetCount);
+}
+
+bool UCustomAssetMemoryTracker::ExportTimelineToBinary(const FString& FilePath) const
+{
+    TArray<uint8> Data;
+    FMemoryWriter Writer(Data);
+
+    // Header: magic, format version and record counts
+    uint32 Magic = 0x4341544C; // 'CATL'
+    uint32 FormatVersion = 1;
+    TArray<FAssetMemorySample> Samples = GetTimelineSamples();
+    int32 SampleCount = Samples.Num();
+    Writer << Magic << FormatVersion << SampleCount;
+
+    // Fixed-size sample records
+    for (FAssetMemorySample& Sample : Samples)
+    {
+        int64 Ticks = Sample.Timestamp.GetTicks();
+        Writer << Ticks << Sample.LoadedBytes << Sample.LoadedCount << Sample.Evictions << Sample.PrefetchBytes << Sample.PinnedBytes;
+    }
+
+    // High-water marks with their attribution
+    FAssetMemoryHighWaterMark Marks[] = { LoadedBytesHighWaterMark, LoadedCountHighWaterMark };
+    for (FAssetMemoryHighWaterMark& Mark : Marks)
+    {
+        int64 Ticks = Mark.Timestamp.GetTicks();
+        FString AssetIdString = Mark.AssetId.ToString();
+        FString BundleIdString = Mark.BundleId.ToString();
+        Writer << Mark.Value << AssetIdString << BundleIdString << Mark.CallSite << Ticks;
+    }
+
+    return FFileHelper::SaveArrayToFile(Data, *FilePath);
+}
+
+bool UCustomAssetMemoryTracker::ExportTimelineToCSV(const FString& FilePath) const
+{
+    FString CSVContent = "Timestamp,LoadedBytes,LoadedCount,Evictions,PrefetchBytes,PinnedBytes\n";
+
+    // Add each sample, oldest first
+    for (const FAssetMemorySample& Sample : GetTimelineSamples())
+    {
+        CSVContent += FString::Printf(TEXT("%s,%lld,%d,%d,%lld,%lld\n"),
+            *Sample.Timestamp.ToString(),
+            Sample.LoadedBytes,
+            Sample.LoadedCount,
+            Sample.Evictions,
+            Sample.PrefetchBytes,
+            Sample.PinnedBytes);
+    }
+
+    // Append the high-water marks as a second table
+    CSVContent += "\nHighWaterMark,Value,AssetId,BundleId,CallSite,Timestamp\n";
+    CSVContent += FString::Printf(TEXT("LoadedBytes,%lld,%s,%s,%s,%s\n"),
+        LoadedBytesHighWaterMark.Value,
+        *LoadedBytesHighWaterMark.AssetId.ToString(),
+        *LoadedBytesHighWaterMark.BundleId.ToString(),
+        *LoadedBytesHighWaterMark.CallSite,
+        *LoadedBytesHighWaterMark.Timestamp.ToString());
+    CSVContent += FString::Printf(TEXT("LoadedCount,%lld,%s,%s,%s,%s\n"),
+        LoadedCountHighWaterMark.Value,
+        *LoadedCountHighWaterMark.AssetId.ToString(),
+        *LoadedCountHighWaterMark.BundleId.ToString(),
+        *LoadedCountHighWaterMark.CallSite,
+        *LoadedCountHighWaterMark.Timestamp.ToString());
+
+    // Write the CSV file
+    return FFileHelper::SaveStringToFile(CSVContent, *FilePath);
+}
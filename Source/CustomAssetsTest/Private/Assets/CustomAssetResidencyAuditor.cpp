@@ -0,0 +1,272 @@
+#include "Assets/CustomAssetResidencyAuditor.h"
+#include "Assets/CustomAssetManager.h"
+#include "Assets/CustomAssetMemoryTracker.h"
+#include "Assets/CustomAssetBase.h"
+#include "Engine/Engine.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/AutomationTest.h"
+#include "Serialization/ArchiveCountMem.h"
+#include "UObject/ReferenceChainSearch.h"
+#include "UObject/UObjectHash.h"
+#include "UObject/UObjectIterator.h"
+
+int32 FAssetResidencyReport::CountIssues(EAssetResidencyIssueType IssueType) const
+{
+    int32 Count = 0;
+    for (const FAssetResidencyIssue& Issue : Issues)
+    {
+        if (Issue.IssueType == IssueType)
+        {
+            ++Count;
+        }
+    }
+    return Count;
+}
+
+UCustomAssetResidencyAuditor::UCustomAssetResidencyAuditor()
+{
+    // Only live instances need to know about garbage collections
+    if (!HasAnyFlags(RF_ClassDefaultObject | RF_ArchetypeObject))
+    {
+        PostGarbageCollectHandle = FCoreUObjectDelegates::GetPostGarbageCollect().AddUObject(this, &UCustomAssetResidencyAuditor::OnPostGarbageCollect);
+    }
+}
+
+void UCustomAssetResidencyAuditor::BeginDestroy()
+{
+    FCoreUObjectDelegates::GetPostGarbageCollect().Remove(PostGarbageCollectHandle);
+
+    Super::BeginDestroy();
+}
+
+void UCustomAssetResidencyAuditor::OnPostGarbageCollect()
+{
+    bGarbageCollectedSinceAudit = true;
+    UnregisteredSinceGarbageCollect.Reset();
+}
+
+void UCustomAssetResidencyAuditor::NotifyAssetUnregistered(const FName& AssetId)
+{
+    UnregisteredSinceGarbageCollect.Add(AssetId);
+}
+
+FAssetResidencyReport UCustomAssetResidencyAuditor::GetLastReport() const
+{
+    return LastReport;
+}
+
+FAssetResidencyReport UCustomAssetResidencyAuditor::RunAudit(const UCustomAssetManager* Manager, bool bFindReferencerChains)
+{
+    FAssetResidencyReport Report;
+
+    if (!Manager)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("Residency audit skipped: no custom asset manager"));
+        return Report;
+    }
+
+    const TMap<FName, UCustomAssetBase*>& LoadedAssets = Manager->GetLoadedAssetMap();
+    const UCustomAssetMemoryTracker* MemoryTracker = Manager->GetMemoryTracker();
+    Report.LoadedCount = LoadedAssets.Num();
+
+    // Walk the UObject array for every live custom asset (class defaults and archetypes are not assets)
+    TSet<FName> ResidentAssetIds;
+    TArray<UCustomAssetBase*> ChainSearchCandidates;
+    for (TObjectIterator<UCustomAssetBase> It(RF_ClassDefaultObject | RF_ArchetypeObject, true, EInternalObjectFlags::Garbage); It; ++It)
+    {
+        UCustomAssetBase* Asset = *It;
+        if (Asset->AssetId.IsNone())
+        {
+            continue;
+        }
+
+        ++Report.ResidentCount;
+        ResidentAssetIds.Add(Asset->AssetId);
+
+        // Resident and registered as this very object is the expected state
+        UCustomAssetBase* const* LoadedAsset = LoadedAssets.Find(Asset->AssetId);
+        if (LoadedAsset && *LoadedAsset == Asset)
+        {
+            continue;
+        }
+
+        // No collection has run since it was unregistered, so it is not retained yet
+        if (!LoadedAsset && UnregisteredSinceGarbageCollect.Contains(Asset->AssetId))
+        {
+            continue;
+        }
+
+        FAssetResidencyIssue Issue;
+        Issue.AssetId = Asset->AssetId;
+        Issue.ObjectPath = Asset->GetPathName();
+        Issue.RetainedBytes = EstimateRetainedBytes(Asset);
+
+        // Assets the tracker has seen were loaded through the manager at some point
+        const bool bWasLoadedByManager = MemoryTracker && MemoryTracker->IsAssetTracked(Asset->AssetId);
+        Issue.IssueType = bWasLoadedByManager ? EAssetResidencyIssueType::ResidentAfterUnload : EAssetResidencyIssueType::ResidentUntracked;
+
+        // The editor keeps every loaded asset RF_Standalone, which GARBAGE_COLLECTION_KEEPFLAGS spares from collection
+        if (bWasLoadedByManager && GIsEditor && Asset->HasAnyFlags(RF_Standalone))
+        {
+            Issue.IssueType = EAssetResidencyIssueType::ResidentStandalone;
+        }
+
+        if (Issue.IssueType == EAssetResidencyIssueType::ResidentAfterUnload)
+        {
+            Report.LeakedBytes += Issue.RetainedBytes;
+            ChainSearchCandidates.Add(Asset);
+        }
+
+        Report.Issues.Add(Issue);
+    }
+
+    // Registered assets whose object is gone or pending destruction
+    for (const auto& Pair : LoadedAssets)
+    {
+        if (!::IsValid(Pair.Value) || !ResidentAssetIds.Contains(Pair.Key))
+        {
+            FAssetResidencyIssue Issue;
+            Issue.AssetId = Pair.Key;
+            Issue.IssueType = EAssetResidencyIssueType::LoadedNotResident;
+            Report.Issues.Add(Issue);
+        }
+    }
+
+    // Referencer chains explain leaks; each search walks the whole object graph, so cap them
+    if (bFindReferencerChains)
+    {
+        const int32 NumSearches = FMath::Min(ChainSearchCandidates.Num(), MaxReferencerChainSearches);
+        for (int32 i = 0; i < NumSearches; ++i)
+        {
+            UCustomAssetBase* Asset = ChainSearchCandidates[i];
+            FReferenceChainSearch ChainSearch(Asset, EReferenceChainSearchMode::Shortest | EReferenceChainSearchMode::ExternalOnly);
+
+            for (FAssetResidencyIssue& Issue : Report.Issues)
+            {
+                if (Issue.AssetId == Asset->AssetId && Issue.IssueType == EAssetResidencyIssueType::ResidentAfterUnload)
+                {
+                    ChainSearch.GetRootPath().ParseIntoArrayLines(Issue.ReferencerChain);
+                    break;
+                }
+            }
+        }
+    }
+
+    bGarbageCollectedSinceAudit = false;
+    LastReport = Report;
+    return Report;
+}
+
+int64 UCustomAssetResidencyAuditor::EstimateRetainedBytes(UObject* Object)
+{
+    TArray<UObject*> Objects;
+    Objects.Add(Object);
+    GetObjectsWithOuter(Object, Objects, true);
+
+    int64 Bytes = 0;
+    for (UObject* Retained : Objects)
+    {
+        // Property memory plus resources the object owns exclusively
+        FArchiveCountMem CountMem(Retained);
+        Bytes += CountMem.GetMax() + Retained->GetResourceSizeBytes(EResourceSizeMode::Exclusive);
+    }
+
+    return Bytes;
+}
+
+void UCustomAssetResidencyAuditor::LogReport(const FAssetResidencyReport& Report)
+{
+    UE_LOG(LogTemp, Log, TEXT("Residency audit: %d resident, %d loaded, %d resident after unload (%lld bytes), %d kept standalone by the editor, %d untracked, %d loaded but not resident"),
+        Report.ResidentCount,
+        Report.LoadedCount,
+        Report.CountIssues(EAssetResidencyIssueType::ResidentAfterUnload),
+        Report.LeakedBytes,
+        Report.CountIssues(EAssetResidencyIssueType::ResidentStandalone),
+        Report.CountIssues(EAssetResidencyIssueType::ResidentUntracked),
+        Report.CountIssues(EAssetResidencyIssueType::LoadedNotResident));
+
+    for (const FAssetResidencyIssue& Issue : Report.Issues)
+    {
+        switch (Issue.IssueType)
+        {
+        case EAssetResidencyIssueType::ResidentAfterUnload:
+            UE_LOG(LogTemp, Warning, TEXT("  Resident after unload: %s (%s), %lld bytes"), *Issue.AssetId.ToString(), *Issue.ObjectPath, Issue.RetainedBytes);
+            for (const FString& Line : Issue.ReferencerChain)
+            {
+                UE_LOG(LogTemp, Warning, TEXT("      %s"), *Line);
+            }
+            break;
+
+        case EAssetResidencyIssueType::ResidentUntracked:
+            UE_LOG(LogTemp, Verbose, TEXT("  Resident but not loaded through the manager: %s (%s), %lld bytes"), *Issue.AssetId.ToString(), *Issue.ObjectPath, Issue.RetainedBytes);
+            break;
+
+        case EAssetResidencyIssueType::LoadedNotResident:
+            UE_LOG(LogTemp, Warning, TEXT("  Loaded but not resident: %s"), *Issue.AssetId.ToString());
+            break;
+
+        case EAssetResidencyIssueType::ResidentStandalone:
+            UE_LOG(LogTemp, Verbose, TEXT("  Kept standalone by the editor after unload: %s (%s), %lld bytes"), *Issue.AssetId.ToString(), *Issue.ObjectPath, Issue.RetainedBytes);
+            break;
+        }
+    }
+}
+
+//=================================================================
+// CONSOLE COMMAND AND AUTOMATION CHECK
+//=================================================================
+
+static UCustomAssetManager* GetCustomAssetManagerForAudit()
+{
+    return GEngine ? Cast<UCustomAssetManager>(GEngine->AssetManager) : nullptr;
+}
+
+static FAutoConsoleCommand GAuditResidencyCommand(
+    TEXT("CustomAssets.AuditResidency"),
+    TEXT("Compare the custom asset manager's loaded assets with the assets resident in memory. Pass 'gc' to collect garbage first for an exact result."),
+    FConsoleCommandWithArgsDelegate::CreateLambda([](const TArray<FString>& Args)
+    {
+        UCustomAssetManager* Manager = GetCustomAssetManagerForAudit();
+        if (!Manager)
+        {
+            UE_LOG(LogTemp, Warning, TEXT("CustomAssets.AuditResidency: custom asset manager is not active"));
+            return;
+        }
+
+        Manager->RunResidencyAudit(Args.Contains(TEXT("gc")));
+    }));
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FCustomAssetResidencyAuditTest, "CustomAssets.Residency.Audit",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::ServerContext | EAutomationTestFlags::EngineFilter)
+
+bool FCustomAssetResidencyAuditTest::RunTest(const FString& Parameters)
+{
+    UCustomAssetManager* Manager = GetCustomAssetManagerForAudit();
+    if (!Manager)
+    {
+        AddInfo(TEXT("Custom asset manager is not active, nothing to audit"));
+        return true;
+    }
+
+    // Collect garbage first so only genuinely retained assets are reported
+    const FAssetResidencyReport Report = Manager->RunResidencyAudit(true);
+
+    for (const FAssetResidencyIssue& Issue : Report.Issues)
+    {
+        if (Issue.IssueType == EAssetResidencyIssueType::ResidentAfterUnload)
+        {
+            AddError(FString::Printf(TEXT("%s is resident after being unloaded (%lld bytes): %s"),
+                *Issue.AssetId.ToString(), Issue.RetainedBytes, *FString::Join(Issue.ReferencerChain, TEXT(" <- "))));
+        }
+        else if (Issue.IssueType == EAssetResidencyIssueType::LoadedNotResident)
+        {
+            AddError(FString::Printf(TEXT("%s is registered as loaded but is not resident"), *Issue.AssetId.ToString()));
+        }
+    }
+
+    return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
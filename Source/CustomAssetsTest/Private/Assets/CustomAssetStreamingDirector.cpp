@@ -0,0 +1,248 @@
+#include "Assets/CustomAssetStreamingDirector.h"
+#include "Assets/CustomAssetManager.h"
+#include "Assets/CustomAssetLLM.h"
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+#include "GameFramework/Pawn.h"
+#include "GameFramework/PlayerController.h"
+#include "Navigation/PathFollowingComponent.h"
+#include "WorldPartition/DataLayer/DataLayerManager.h"
+#include "WorldPartition/DataLayer/DataLayerInstance.h"
+#include "WorldPartition/DataLayer/DataLayerAsset.h"
+#include "HAL/IConsoleManager.h"
+
+bool UCustomAssetStreamingDirector::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+    return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UCustomAssetStreamingDirector::OnWorldBeginPlay(UWorld& InWorld)
+{
+    Super::OnWorldBeginPlay(InWorld);
+
+    UDataLayerManager* DataLayerManager = UDataLayerManager::GetDataLayerManager(&InWorld);
+    if (!DataLayerManager)
+    {
+        return;
+    }
+
+    DataLayerManager->OnDataLayerInstanceRuntimeStateChanged.AddDynamic(this, &UCustomAssetStreamingDirector::HandleDataLayerRuntimeStateChanged);
+    BoundDataLayerManager = DataLayerManager;
+
+    // Layers that start loaded or active never report a change
+    DataLayerManager->ForEachDataLayerInstance([this](UDataLayerInstance* DataLayer)
+    {
+        HandleDataLayerRuntimeStateChanged(DataLayer, DataLayer->GetRuntimeState());
+        return true;
+    });
+}
+
+void UCustomAssetStreamingDirector::Deinitialize()
+{
+    if (UDataLayerManager* DataLayerManager = BoundDataLayerManager.Get())
+    {
+        DataLayerManager->OnDataLayerInstanceRuntimeStateChanged.RemoveAll(this);
+    }
+    BoundDataLayerManager.Reset();
+
+    // Torn down worlds never report their layers unloading, so give their bundles back here
+    if (UCustomAssetManager* AssetManager = GEngine ? Cast<UCustomAssetManager>(GEngine->AssetManager) : nullptr)
+    {
+        for (const FName& DataLayerName : HeldDataLayers)
+        {
+            AssetManager->OnDataLayerStateChanged(DataLayerName, false);
+        }
+    }
+    HeldDataLayers.Empty();
+
+    Super::Deinitialize();
+}
+
+void UCustomAssetStreamingDirector::Tick(float DeltaTime)
+{
+    Super::Tick(DeltaTime);
+
+    if (!bDirectorEnabled)
+    {
+        return;
+    }
+
+    TimeSinceUpdate += DeltaTime;
+    if (TimeSinceUpdate < UpdateInterval)
+    {
+        return;
+    }
+
+    TimeSinceUpdate = 0.0f;
+    UpdateNow();
+}
+
+TStatId UCustomAssetStreamingDirector::GetStatId() const
+{
+    RETURN_QUICK_DECLARE_CYCLE_STAT(UCustomAssetStreamingDirector, STATGROUP_Tickables);
+}
+
+void UCustomAssetStreamingDirector::SetDirectorEnabled(bool bEnabled)
+{
+    bDirectorEnabled = bEnabled;
+    TimeSinceUpdate = 0.0f;
+}
+
+void UCustomAssetStreamingDirector::UpdateNow()
+{
+    LLM_SCOPE_BYTAG(CustomAssets_Bundles);
+
+    UCustomAssetManager* AssetManager = GEngine ? Cast<UCustomAssetManager>(GEngine->AssetManager) : nullptr;
+    if (!AssetManager)
+    {
+        return;
+    }
+
+    // World Partition regions follow the cells the engine streams, whatever the players do
+    AssetManager->UpdateStreamingRegionBundles();
+
+    // Every player counts, so one player moving away never unloads what another still needs
+    TArray<FBundleStreamingViewer> Viewers;
+    for (FConstPlayerControllerIterator It = GetWorld()->GetPlayerControllerIterator(); It; ++It)
+    {
+        const APlayerController* PlayerController = It->Get();
+        if (!PlayerController)
+        {
+            continue;
+        }
+
+        if (APawn* Pawn = PlayerController->GetPawn())
+        {
+            Viewers.Add(PredictViewer(Pawn));
+        }
+        else if (const AActor* ViewTarget = PlayerController->GetViewTarget())
+        {
+            // Spectators only count where they look from
+            FBundleStreamingViewer Viewer;
+            Viewer.Location = ViewTarget->GetActorLocation();
+            Viewers.Add(Viewer);
+        }
+    }
+
+    // Between possessions there may be no viewer for a moment; keep the current bundles rather than releasing them
+    if (Viewers.Num() > 0)
+    {
+        AssetManager->UpdateLevelBasedBundlesForViewers(Viewers);
+    }
+}
+
+void UCustomAssetStreamingDirector::HandleDataLayerRuntimeStateChanged(const UDataLayerInstance* DataLayer, EDataLayerRuntimeState State)
+{
+    UCustomAssetManager* AssetManager = GEngine ? Cast<UCustomAssetManager>(GEngine->AssetManager) : nullptr;
+    if (!AssetManager || !DataLayer)
+    {
+        return;
+    }
+
+    // Associations name the Data Layer asset, which stays the same across worlds
+    const UDataLayerAsset* DataLayerAsset = DataLayer->GetAsset();
+    const FName DataLayerName = DataLayerAsset ? DataLayerAsset->GetFName() : FName(*DataLayer->GetDataLayerShortName());
+
+    // The state changes when it is requested, ahead of the cells that make the switch visible
+    const bool bActive = State == EDataLayerRuntimeState::Activated || (bHoldDataLayerBundlesWhileLoaded && State == EDataLayerRuntimeState::Loaded);
+    if (bActive)
+    {
+        HeldDataLayers.Add(DataLayerName);
+    }
+    else
+    {
+        HeldDataLayers.Remove(DataLayerName);
+    }
+    AssetManager->OnDataLayerStateChanged(DataLayerName, bActive);
+}
+
+FBundleStreamingViewer UCustomAssetStreamingDirector::PredictViewer(APawn* Pawn) const
+{
+    FBundleStreamingViewer Viewer;
+    if (!Pawn)
+    {
+        return Viewer;
+    }
+
+    Viewer.Location = Pawn->GetActorLocation();
+    Viewer.PredictionStepSeconds = FMath::Max(PredictionStepSeconds, 0.05f);
+
+    const int32 NumSteps = FMath::FloorToInt(PredictionHorizonSeconds / Viewer.PredictionStepSeconds);
+    const FVector Velocity = Pawn->GetVelocity();
+    const float Speed = Velocity.Size();
+    if (NumSteps <= 0 || Speed < KINDA_SMALL_NUMBER)
+    {
+        return Viewer;
+    }
+
+    Viewer.PredictedPath.Reserve(NumSteps);
+
+    // While the controller follows a navigation path, the pawn turns with it instead of going straight
+    const AController* Controller = Pawn->GetController();
+    const UPathFollowingComponent* PathFollowing = Controller && bFollowNavigationPath ? Controller->FindComponentByClass<UPathFollowingComponent>() : nullptr;
+    if (PathFollowing && PathFollowing->GetStatus() == EPathFollowingStatus::Moving && PathFollowing->GetPath().IsValid() && PathFollowing->GetPath()->IsValid())
+    {
+        const TArray<FNavPathPoint>& PathPoints = PathFollowing->GetPath()->GetPathPoints();
+        int32 NextPointIndex = static_cast<int32>(PathFollowing->GetNextPathIndex());
+        FVector Cursor = Viewer.Location;
+
+        for (int32 Step = 0; Step < NumSteps && PathPoints.IsValidIndex(NextPointIndex); ++Step)
+        {
+            // Advance along the path by the distance covered in one step
+            float Remaining = Speed * Viewer.PredictionStepSeconds;
+            while (Remaining > 0.0f && PathPoints.IsValidIndex(NextPointIndex))
+            {
+                const FVector Target = PathPoints[NextPointIndex].Location;
+                const float SegmentLength = FVector::Dist(Cursor, Target);
+                if (SegmentLength <= Remaining)
+                {
+                    Cursor = Target;
+                    Remaining -= SegmentLength;
+                    ++NextPointIndex;
+                }
+                else
+                {
+                    Cursor += (Target - Cursor) * (Remaining / SegmentLength);
+                    Remaining = 0.0f;
+                }
+            }
+
+            Viewer.PredictedPath.Add(Cursor);
+        }
+
+        return Viewer;
+    }
+
+    // Otherwise extrapolate the current velocity
+    for (int32 Step = 1; Step <= NumSteps; ++Step)
+    {
+        Viewer.PredictedPath.Add(Viewer.Location + Velocity * (Viewer.PredictionStepSeconds * Step));
+    }
+
+    return Viewer;
+}
+
+//=================================================================
+// CONSOLE COMMAND
+//=================================================================
+
+static FAutoConsoleCommand GDataLayerMemoryCommand(
+    TEXT("CustomAssets.DataLayerMemory"),
+    TEXT("Log the bundles of every Data Layer with their loaded bytes and the memory change since the layer last switched."),
+    FConsoleCommandDelegate::CreateLambda([]()
+    {
+        const UCustomAssetManager* Manager = GEngine ? Cast<UCustomAssetManager>(GEngine->AssetManager) : nullptr;
+        if (!Manager)
+        {
+            UE_LOG(LogTemp, Warning, TEXT("CustomAssets.DataLayerMemory: custom asset manager is not active"));
+            return;
+        }
+
+        for (const FDataLayerBundleMemoryReport& Report : Manager->GetDataLayerMemoryReports())
+        {
+            UE_LOG(LogTemp, Log, TEXT("Data Layer %s (%s): %d bundles, %.2f MB loaded, %+.2f MB since last switch (%d switches)"),
+                *Report.DataLayerName.ToString(), Report.bActive ? TEXT("active") : TEXT("inactive"), Report.BundleIds.Num(),
+                Report.BundleLoadedBytes / (1024.0 * 1024.0), Report.DeltaBytesSinceTransition / (1024.0 * 1024.0), Report.TransitionCount);
+        }
+    })
+);
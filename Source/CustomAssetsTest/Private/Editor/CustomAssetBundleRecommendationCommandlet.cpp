@@ -0,0 +1,355 @@
+#include "Editor/CustomAssetBundleRecommendationCommandlet.h"
+#include "Assets/CustomAssetCoAccessRecorder.h"
+#include "Assets/CustomAssetManager.h"
+#include "Assets/CustomAssetBundle.h"
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "Engine/Engine.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Serialization/JsonSerializer.h"
+#include "Dom/JsonObject.h"
+
+namespace CustomAssetBundleRecommendation
+{
+    // One recommended bundle mined from a level's co-access statistics
+    struct FRecommendation
+    {
+        FName LevelName;
+        TArray<FName> AssetIds;
+
+        // Requests recorded for the members, and the requests left if they were loaded as one bundle
+        int32 SeparateRequests = 0;
+        int32 BundledRequests = 0;
+
+        // Size on disk of the member packages
+        int64 DiskBytes = 0;
+
+        // Existing bundle with the largest overlap, and how the recommendation differs from it
+        FName MatchedBundleId;
+        float MatchOverlap = 0.0f;
+        TArray<FName> AddedAssetIds;
+        TArray<FName> RemovedAssetIds;
+    };
+
+    static FName FindRoot(TMap<FName, FName>& Parents, FName AssetId)
+    {
+        FName Root = AssetId;
+        while (Parents[Root] != Root)
+        {
+            Root = Parents[Root];
+        }
+
+        // Path compression keeps later lookups short
+        while (Parents[AssetId] != Root)
+        {
+            const FName Next = Parents[AssetId];
+            Parents[AssetId] = Root;
+            AssetId = Next;
+        }
+        return Root;
+    }
+
+    // Greedy single-linkage clustering over the strongest co-access edges first
+    static TArray<TArray<FName>> ClusterLevel(const FAssetCoAccessLevelStats& Stats, float MinAffinity, int32 MinPairCount, int32 MaxBundleSize)
+    {
+        struct FEdge
+        {
+            FName A;
+            FName B;
+            float Affinity;
+            int32 Count;
+        };
+
+        TArray<FEdge> Edges;
+        for (const auto& Pair : Stats.PairCounts)
+        {
+            if (Pair.Value < MinPairCount)
+            {
+                continue;
+            }
+
+            // Jaccard affinity: how often the two are requested together relative to how often either is requested
+            const int32 CountA = Stats.AccessCounts.FindRef(Pair.Key.Key);
+            const int32 CountB = Stats.AccessCounts.FindRef(Pair.Key.Value);
+            const int32 Union = FMath::Max(CountA + CountB - Pair.Value, Pair.Value);
+            const float Affinity = static_cast<float>(Pair.Value) / static_cast<float>(Union);
+            if (Affinity >= MinAffinity)
+            {
+                Edges.Add({ Pair.Key.Key, Pair.Key.Value, Affinity, Pair.Value });
+            }
+        }
+
+        // Deterministic order so the same trace always gives the same bundles
+        Edges.Sort([](const FEdge& Left, const FEdge& Right)
+        {
+            if (Left.Affinity != Right.Affinity)
+            {
+                return Left.Affinity > Right.Affinity;
+            }
+            if (Left.Count != Right.Count)
+            {
+                return Left.Count > Right.Count;
+            }
+            const int32 CompareA = Left.A.Compare(Right.A);
+            return CompareA != 0 ? CompareA < 0 : Left.B.Compare(Right.B) < 0;
+        });
+
+        TMap<FName, FName> Parents;
+        TMap<FName, int32> Sizes;
+        for (const FEdge& Edge : Edges)
+        {
+            for (const FName& AssetId : { Edge.A, Edge.B })
+            {
+                if (!Parents.Contains(AssetId))
+                {
+                    Parents.Add(AssetId, AssetId);
+                    Sizes.Add(AssetId, 1);
+                }
+            }
+
+            const FName RootA = FindRoot(Parents, Edge.A);
+            const FName RootB = FindRoot(Parents, Edge.B);
+            if (RootA == RootB || Sizes[RootA] + Sizes[RootB] > MaxBundleSize)
+            {
+                continue;
+            }
+
+            Parents[RootB] = RootA;
+            Sizes[RootA] += Sizes[RootB];
+        }
+
+        TMap<FName, TArray<FName>> ClustersByRoot;
+        for (const auto& Pair : Parents)
+        {
+            ClustersByRoot.FindOrAdd(FindRoot(Parents, Pair.Key)).Add(Pair.Key);
+        }
+
+        TArray<TArray<FName>> Clusters;
+        for (auto& Pair : ClustersByRoot)
+        {
+            if (Pair.Value.Num() >= 2)
+            {
+                Pair.Value.Sort(FNameLexicalLess());
+                Clusters.Add(MoveTemp(Pair.Value));
+            }
+        }
+
+        Clusters.Sort([](const TArray<FName>& Left, const TArray<FName>& Right)
+        {
+            return Left.Num() != Right.Num() ? Left.Num() > Right.Num() : Left[0].Compare(Right[0]) < 0;
+        });
+        return Clusters;
+    }
+
+    static void MatchExistingBundle(FRecommendation& Recommendation, const TArray<UCustomAssetBundle*>& ExistingBundles)
+    {
+        const TSet<FName> Members(Recommendation.AssetIds);
+
+        for (const UCustomAssetBundle* Bundle : ExistingBundles)
+        {
+            const TSet<FName> BundleMembers(Bundle->AssetIds);
+            const int32 Shared = Members.Intersect(BundleMembers).Num();
+            const int32 Union = Members.Union(BundleMembers).Num();
+            const float Overlap = Union > 0 ? static_cast<float>(Shared) / static_cast<float>(Union) : 0.0f;
+            if (Shared > 0 && Overlap > Recommendation.MatchOverlap)
+            {
+                Recommendation.MatchOverlap = Overlap;
+                Recommendation.MatchedBundleId = Bundle->BundleId;
+                Recommendation.AddedAssetIds = Members.Difference(BundleMembers).Array();
+                Recommendation.RemovedAssetIds = BundleMembers.Difference(Members).Array();
+            }
+        }
+
+        Recommendation.AddedAssetIds.Sort(FNameLexicalLess());
+        Recommendation.RemovedAssetIds.Sort(FNameLexicalLess());
+    }
+
+    static TArray<TSharedPtr<FJsonValue>> NamesToJson(const TArray<FName>& Names)
+    {
+        TArray<TSharedPtr<FJsonValue>> Values;
+        for (const FName& Name : Names)
+        {
+            Values.Add(MakeShared<FJsonValueString>(Name.ToString()));
+        }
+        return Values;
+    }
+}
+
+UCustomAssetBundleRecommendationCommandlet::UCustomAssetBundleRecommendationCommandlet()
+{
+    IsClient = false;
+    IsEditor = true;
+    IsServer = false;
+    LogToConsole = true;
+    HelpDescription = TEXT("Clusters co-access traces recorded by the custom asset manager into recommended asset bundles");
+}
+
+int32 UCustomAssetBundleRecommendationCommandlet::Main(const FString& Params)
+{
+    using namespace CustomAssetBundleRecommendation;
+
+    TArray<FString> Tokens;
+    TArray<FString> Switches;
+    TMap<FString, FString> ParamValues;
+    ParseCommandLine(*Params, Tokens, Switches, ParamValues);
+
+    const FString TraceList = ParamValues.Contains(TEXT("Trace")) ? ParamValues[TEXT("Trace")] : UCustomAssetCoAccessRecorder::GetDefaultTracePath();
+    const FString OutputPath = ParamValues.Contains(TEXT("Output")) ? ParamValues[TEXT("Output")] : FPaths::ProjectSavedDir() / TEXT("CustomAssets") / TEXT("BundleRecommendations.json");
+    const float MinAffinity = ParamValues.Contains(TEXT("MinAffinity")) ? FCString::Atof(*ParamValues[TEXT("MinAffinity")]) : 0.5f;
+    const int32 MinPairCount = ParamValues.Contains(TEXT("MinPairCount")) ? FCString::Atoi(*ParamValues[TEXT("MinPairCount")]) : 3;
+    const int32 MaxBundleSize = ParamValues.Contains(TEXT("MaxBundleSize")) ? FMath::Max(2, FCString::Atoi(*ParamValues[TEXT("MaxBundleSize")])) : 64;
+    const bool bApply = Switches.Contains(TEXT("Apply")) || Switches.Contains(TEXT("ApplyDiff"));
+    const bool bApplyDiff = Switches.Contains(TEXT("ApplyDiff"));
+
+    // Traces from several sessions are merged before clustering
+    UCustomAssetCoAccessRecorder* Trace = NewObject<UCustomAssetCoAccessRecorder>();
+    TArray<FString> TracePaths;
+    TraceList.ParseIntoArray(TracePaths, TEXT(","));
+    int32 LoadedTraces = 0;
+    for (const FString& TracePath : TracePaths)
+    {
+        LoadedTraces += Trace->LoadTrace(TracePath) ? 1 : 0;
+    }
+
+    if (LoadedTraces == 0)
+    {
+        UE_LOG(LogTemp, Error, TEXT("CustomAssetBundleRecommendation: No co-access trace could be loaded from %s"), *TraceList);
+        return 1;
+    }
+
+    UCustomAssetManager* Manager = GEngine ? Cast<UCustomAssetManager>(GEngine->AssetManager) : nullptr;
+    TArray<UCustomAssetBundle*> ExistingBundles;
+    if (Manager)
+    {
+        Manager->GetAllBundles(ExistingBundles);
+    }
+    else
+    {
+        UE_LOG(LogTemp, Warning, TEXT("CustomAssetBundleRecommendation: Custom asset manager is not active, sizes and diffs are skipped"));
+    }
+
+    IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry").Get();
+
+    TArray<FRecommendation> Recommendations;
+    for (const auto& LevelPair : Trace->GetLevelStats())
+    {
+        for (TArray<FName>& Cluster : ClusterLevel(LevelPair.Value, MinAffinity, MinPairCount, MaxBundleSize))
+        {
+            FRecommendation& Recommendation = Recommendations.AddDefaulted_GetRef();
+            Recommendation.LevelName = LevelPair.Key;
+            Recommendation.AssetIds = MoveTemp(Cluster);
+
+            // Every recorded request is a separate load today, as a bundle the most requested member triggers each load
+            for (const FName& AssetId : Recommendation.AssetIds)
+            {
+                const int32 Count = LevelPair.Value.AccessCounts.FindRef(AssetId);
+                Recommendation.SeparateRequests += Count;
+                Recommendation.BundledRequests = FMath::Max(Recommendation.BundledRequests, Count);
+
+                const FSoftObjectPath* AssetPath = Manager ? Manager->AssetPathMap.Find(AssetId) : nullptr;
+                if (AssetPath && AssetPath->IsValid())
+                {
+                    TOptional<FAssetPackageData> PackageData = AssetRegistry.GetAssetPackageDataCopy(AssetPath->GetLongPackageFName());
+                    if (PackageData.IsSet() && PackageData->DiskSize > 0)
+                    {
+                        Recommendation.DiskBytes += PackageData->DiskSize;
+                    }
+                }
+            }
+
+            MatchExistingBundle(Recommendation, ExistingBundles);
+        }
+    }
+
+    // Write the report, including the diff of each recommendation against its closest existing bundle
+    TSharedRef<FJsonObject> Root = MakeShared<FJsonObject>();
+    Root->SetNumberField(TEXT("MinAffinity"), MinAffinity);
+    Root->SetNumberField(TEXT("MinPairCount"), MinPairCount);
+
+    int32 TotalSavedRequests = 0;
+    TArray<TSharedPtr<FJsonValue>> RecommendationValues;
+    for (int32 Index = 0; Index < Recommendations.Num(); ++Index)
+    {
+        const FRecommendation& Recommendation = Recommendations[Index];
+        const int32 SavedRequests = Recommendation.SeparateRequests - Recommendation.BundledRequests;
+        TotalSavedRequests += SavedRequests;
+
+        TSharedRef<FJsonObject> Object = MakeShared<FJsonObject>();
+        Object->SetStringField(TEXT("Level"), Recommendation.LevelName.ToString());
+        Object->SetArrayField(TEXT("Assets"), NamesToJson(Recommendation.AssetIds));
+        Object->SetNumberField(TEXT("SeparateRequests"), Recommendation.SeparateRequests);
+        Object->SetNumberField(TEXT("BundledRequests"), Recommendation.BundledRequests);
+        Object->SetNumberField(TEXT("SavedRequests"), SavedRequests);
+        Object->SetNumberField(TEXT("DiskBytes"), static_cast<double>(Recommendation.DiskBytes));
+
+        if (!Recommendation.MatchedBundleId.IsNone())
+        {
+            Object->SetStringField(TEXT("MatchedBundle"), Recommendation.MatchedBundleId.ToString());
+            Object->SetNumberField(TEXT("MatchOverlap"), Recommendation.MatchOverlap);
+            Object->SetArrayField(TEXT("Added"), NamesToJson(Recommendation.AddedAssetIds));
+            Object->SetArrayField(TEXT("Removed"), NamesToJson(Recommendation.RemovedAssetIds));
+        }
+
+        RecommendationValues.Add(MakeShared<FJsonValueObject>(Object));
+    }
+    Root->SetArrayField(TEXT("Recommendations"), RecommendationValues);
+    Root->SetNumberField(TEXT("TotalSavedRequests"), TotalSavedRequests);
+
+    FString Output;
+    TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&Output);
+    if (!FJsonSerializer::Serialize(Root, Writer) || !FFileHelper::SaveStringToFile(Output, *OutputPath))
+    {
+        UE_LOG(LogTemp, Error, TEXT("CustomAssetBundleRecommendation: Failed to write %s"), *OutputPath);
+        return 1;
+    }
+
+    UE_LOG(LogTemp, Display, TEXT("CustomAssetBundleRecommendation: %d recommendations from %d levels, %d requests saved, report written to %s"),
+        Recommendations.Num(), Trace->GetLevelStats().Num(), TotalSavedRequests, *OutputPath);
+
+    if (!bApply || !Manager)
+    {
+        return 0;
+    }
+
+    // Import the recommendations as bundle assets
+    for (int32 Index = 0; Index < Recommendations.Num(); ++Index)
+    {
+        const FRecommendation& Recommendation = Recommendations[Index];
+        const bool bUpdatesExisting = !Recommendation.MatchedBundleId.IsNone() && Recommendation.MatchOverlap >= 0.5f;
+
+        if (bUpdatesExisting && Recommendation.AddedAssetIds.Num() == 0 && Recommendation.RemovedAssetIds.Num() == 0)
+        {
+            continue;
+        }
+
+        UCustomAssetBundle* Bundle = nullptr;
+        if (bUpdatesExisting)
+        {
+            if (!bApplyDiff)
+            {
+                continue;
+            }
+            Bundle = Manager->GetBundleById(Recommendation.MatchedBundleId);
+        }
+        else
+        {
+            Bundle = Manager->CreateBundle(FString::Printf(TEXT("Recommended_%s_%d"), *Recommendation.LevelName.ToString(), Index));
+        }
+
+        if (!Bundle)
+        {
+            continue;
+        }
+
+        // SaveBundle re-adds the IDs of loaded assets, so the loaded list has to match the new membership
+        Bundle->AssetIds = Recommendation.AssetIds;
+        Bundle->Assets.Reset();
+        Bundle->RebuildMembershipSet();
+        if (!Manager->SaveBundle(Bundle, TEXT("/Game/Bundles")))
+        {
+            UE_LOG(LogTemp, Error, TEXT("CustomAssetBundleRecommendation: Failed to save bundle %s"), *Bundle->BundleId.ToString());
+        }
+    }
+
+    return 0;
+}
@@ -653,11 +653,17 @@ void SCustomAssetManagerEditorWindow::RefreshAssetList()
     AssetEntries.Empty();
     FilteredAssetEntries.Empty();
     
+    // IDs that already have an entry
+    TSet<FName> AddedAssetIds;
+    AddedAssetIds.Reserve(AssetIds.Num());
+    
     // First add loaded assets
     for (UCustomAssetBase* Asset : LoadedAssets)
     {
         if (Asset)
         {
+            AddedAssetIds.Add(Asset->AssetId);
+            
             TSharedPtr<FAssetEntry> Entry = MakeShared<FAssetEntry>();
             Entry->AssetId = Asset->AssetId;
             Entry->DisplayName = Asset->DisplayName;
@@ -710,17 +716,7 @@ void SCustomAssetManagerEditorWindow::RefreshAssetList()
     for (const FName& AssetId : AssetIds)
     {
         // Skip if already added as a loaded asset
-        bool bAlreadyAdded = false;
-        for (const TSharedPtr<FAssetEntry>& Entry : AssetEntries)
-        {
-            if (Entry->AssetId == AssetId)
-            {
-                bAlreadyAdded = true;
-                break;
-            }
-        }
-        
-        if (bAlreadyAdded)
+        if (AddedAssetIds.Contains(AssetId))
         {
             continue;
         }
@@ -1872,142 +1868,42 @@ FReply SCustomAssetManagerEditorWindow::OnAddAssetToBundleClicked()
                     // Store the bundle's display name before operations
                     FText OriginalBundleName = (*SelectedBundle)->DisplayName;
                     
-                    // Add all selected assets to the bundle
-                    UCustomAssetManager& AssetManager = UCustomAssetManager::Get();
-                    int32 AddedCount = 0;
-                    
-                    // CRITICAL FIX: Make sure we're only adding selected assets 
-                    UE_LOG(LogTemp, Warning, TEXT("[CRITICAL] OnAddAssetToBundleClicked: About to add %d selected assets to bundle"), 
-                        SelectedAssetIds.Num());
+                    // Add all selected assets to the bundle as one batch
+                    UCustomAssetBundle* BundleToSave = *SelectedBundle;
+                    TSet<FName> AssetIdsToAdd;
+                    BundleToSave->BeginBatchEdit();
                     
                     for (const FName& AssetId : SelectedAssetIds)
                     {
-                        if (AssetId.IsNone())
+                        // Skip invalid assets, duplicates and assets already in the bundle
+                        if (AssetId.IsNone() || BundleToSave->ContainsAsset(AssetId) || AssetIdsToAdd.Contains(AssetId))
                         {
-                            UE_LOG(LogTemp, Warning, TEXT("[CRITICAL] OnAddAssetToBundleClicked: Skipping None AssetId"));
-                            continue; // Skip invalid assets
+                            continue;
                         }
                         
-                        UE_LOG(LogTemp, Warning, TEXT("[CRITICAL] OnAddAssetToBundleClicked: Processing asset %s for bundle %s"), 
-                            *AssetId.ToString(), *(*SelectedBundle)->BundleId.ToString());
-                            
-                        // Add the asset to the bundle - the AddAsset method handles both loaded and unloaded assets
-                        if (!(*SelectedBundle)->ContainsAsset(AssetId))
-                        {
-                            UE_LOG(LogTemp, Warning, TEXT("[CRITICAL] OnAddAssetToBundleClicked: Asset %s not in bundle, adding it"), 
-                                *AssetId.ToString());
-                                
-                            (*SelectedBundle)->AddAsset(AssetId);
-                            
-                            // Make sure the asset pointer is also added if it's loaded
-                            UCustomAssetBase* Asset = AssetManager.GetAssetById(AssetId);
-                            if (Asset && !(*SelectedBundle)->Assets.Contains(Asset))
-                            {
-                                UE_LOG(LogTemp, Warning, TEXT("[CRITICAL] OnAddAssetToBundleClicked: Adding loaded asset to Assets array"));
-                                (*SelectedBundle)->Assets.Add(Asset);
-                            }
-                            
-                            AddedCount++;
-                        }
-                        else
-                        {
-                            UE_LOG(LogTemp, Warning, TEXT("[CRITICAL] OnAddAssetToBundleClicked: Asset %s already in bundle, skipping"), 
-                                *AssetId.ToString());
-                        }
+                        AssetIdsToAdd.Add(AssetId);
+                        BundleToSave->AddAsset(AssetId);
                     }
                     
+                    const int32 AddedCount = AssetIdsToAdd.Num();
+                    
                     // Show a message about how many assets were added
                     FText Message = FText::Format(LOCTEXT("AssetsAddedToBundle", "{0} assets added to bundle {1}"), 
                         FText::AsNumber(AddedCount), 
                         OriginalBundleName);
                     
-                    // Save the bundle and refresh the UI
+                    // Commit the batch, saving the bundle once if any assets were added
                     if (AddedCount > 0)
                     {
                         try
                         {
-                            // Save the bundle if any assets were added
-                            // Get a local reference to the bundle before saving
-                            UCustomAssetBundle* BundleToSave = *SelectedBundle;
-                            FName BundleId = BundleToSave->BundleId;
-                            
-                            // CRITICAL DIAGNOSTICS: Print bundle contents before saving
-                            BundleToSave->DebugPrintContents(TEXT("BEFORE_SAVE"));
-                            
-                            // CRITICAL FAILSAFE: Double check if assets are missing
-                            if (BundleToSave->AssetIds.Num() == 0 && AddedCount > 0)
-                            {
-                                UE_LOG(LogTemp, Error, TEXT("[CRITICAL] SaveBundle: CRITICAL ISSUE - Bundle reports %d assets added but AssetIds array is empty!"), AddedCount);
-                                
-                                // Emergency recovery - manually add assets that we know should be in the bundle
-                                for (const FName& AssetId : SelectedAssetIds)
-                                {
-                                    UE_LOG(LogTemp, Error, TEXT("[CRITICAL] SaveBundle: EMERGENCY - Manually adding asset %s to bundle"), *AssetId.ToString());
-                                    BundleToSave->AssetIds.AddUnique(AssetId);
-                                    
-                                    // Also add to loaded assets if possible
-                                    UCustomAssetBase* Asset = AssetManager.GetAssetById(AssetId);
-                                    if (Asset && !BundleToSave->Assets.Contains(Asset))
-                                    {
-                                        BundleToSave->Assets.Add(Asset);
-                                    }
-                                }
-                                
-                                // Print bundle contents after emergency recovery
-                                BundleToSave->DebugPrintContents(TEXT("EMERGENCY_RECOVERY"));
-                            }
-                            
-                            UE_LOG(LogTemp, Warning, TEXT("[CRITICAL] Saving bundle after adding assets: ID=%s, DisplayName=%s, Assets=%d"), 
-                                *BundleId.ToString(), 
-                                *BundleToSave->DisplayName.ToString(),
-                                BundleToSave->AssetIds.Num());
-                            
-                            // Use AssetManager.SaveBundle directly instead of Bundle->Save()
-                            bool bSaved = AssetManager.SaveBundle(BundleToSave, TEXT("/Game/Bundles"));
-                            
-                            if (!bSaved)
+                            if (!BundleToSave->CommitBatchEdit(true))
                             {
-                                UE_LOG(LogTemp, Error, TEXT("Failed to save bundle %s"), *BundleId.ToString());
+                                UE_LOG(LogTemp, Error, TEXT("Failed to save bundle %s"), *BundleToSave->BundleId.ToString());
                                 FMessageDialog::Open(EAppMsgType::Ok, FText::Format(LOCTEXT("FailedToSaveBundle", 
                                     "Failed to save bundle {0}. Check the logs for more information."), OriginalBundleName));
                             }
                             
-                            // Verify that assets were saved in the bundle
-                            UCustomAssetBundle* SavedBundle = AssetManager.GetBundleById(BundleId);
-                            if (SavedBundle)
-                            {
-                                // CRITICAL DIAGNOSTICS: Print saved bundle contents
-                                SavedBundle->DebugPrintContents(TEXT("AFTER_SAVE"));
-                                
-                                UE_LOG(LogTemp, Warning, TEXT("[CRITICAL] After save: Bundle %s has %d assets"), 
-                                    *SavedBundle->BundleId.ToString(), 
-                                    SavedBundle->AssetIds.Num());
-                                    
-                                // CRITICAL FAILSAFE: If bundle still has no assets after saving, try one more time
-                                if (SavedBundle->AssetIds.Num() == 0 && AddedCount > 0)
-                                {
-                                    UE_LOG(LogTemp, Error, TEXT("[CRITICAL] FINAL ATTEMPT: Bundle still has no assets after save! Trying one last emergency save"));
-                                    
-                                    // Emergency recovery - manually add assets again to the saved bundle
-                                    for (const FName& AssetId : SelectedAssetIds)
-                                    {
-                                        UE_LOG(LogTemp, Error, TEXT("[CRITICAL] FINAL ATTEMPT: Manually adding asset %s to saved bundle"), *AssetId.ToString());
-                                        SavedBundle->AssetIds.AddUnique(AssetId);
-                                        
-                                        // Also add to loaded assets if possible
-                                        UCustomAssetBase* Asset = AssetManager.GetAssetById(AssetId);
-                                        if (Asset && !SavedBundle->Assets.Contains(Asset))
-                                        {
-                                            SavedBundle->Assets.Add(Asset);
-                                        }
-                                    }
-                                    
-                                    // Try saving one more time
-                                    SavedBundle->DebugPrintContents(TEXT("FINAL_ATTEMPT"));
-                                    AssetManager.SaveBundle(SavedBundle, TEXT("/Game/Bundles"));
-                                }
-                            }
-                            
                             // Refresh the asset list to update bundle membership
                             RefreshAssetList();
                             
@@ -2020,6 +1916,10 @@ FReply SCustomAssetManagerEditorWindow::OnAddAssetToBundleClicked()
                             FMessageDialog::Open(EAppMsgType::Ok, FText::FromString(FString::Printf(TEXT("Error saving bundle: %s"), UTF8_TO_TCHAR(e.what()))));
                         }
                     }
+                    else
+                    {
+                        BundleToSave->CancelBatchEdit();
+                    }
                     
                     FMessageDialog::Open(EAppMsgType::Ok, Message);
                     
@@ -2171,7 +2071,7 @@ void SCustomAssetManagerEditorWindow::ShowRemoveFromBundleDialog(const FName& As
             [
                 SNew(SButton)
                 .Text(LOCTEXT("RemoveButton", "Remove"))
-                .OnClicked_Lambda([this, DialogWindow, SelectedBundle, AssetId, &AssetManager]() {
+                .OnClicked_Lambda([this, DialogWindow, SelectedBundle, AssetId]() {
                     if (!SelectedBundle || !(*SelectedBundle))
                     {
                         FMessageDialog::Open(EAppMsgType::Ok, LOCTEXT("NoBundleSelected", "No bundle selected for removal. Please select a bundle first."));
@@ -2206,17 +2106,8 @@ void SCustomAssetManagerEditorWindow::ShowRemoveFromBundleDialog(const FName& As
                     // CRITICAL FIX: Explicitly log the bundle contents before removal
                     (*SelectedBundle)->DebugPrintContents(TEXT("BEFORE_ASSET_REMOVAL"));
                     
-                    // Remove the asset from the bundle (both ID and reference)
-                    (*SelectedBundle)->RemoveAsset(AssetId);
-                    
-                    // CRITICAL FIX: Also explicitly remove the asset reference if it's loaded
-                    UCustomAssetBase* Asset = AssetManager.GetAssetById(AssetId);
-                    if (Asset)
-                    {
-                        int32 RemovedCount = (*SelectedBundle)->Assets.Remove(Asset);
-                        UE_LOG(LogTemp, Warning, TEXT("[CRITICAL] RemoveFromBundle: Explicitly removed %d instances of asset from Assets array"), 
-                            RemovedCount);
-                    }
+                    // Remove the asset from the bundle (both ID and reference) without saving yet
+                    (*SelectedBundle)->RemoveAssets({ AssetId }, false);
                     
                     // Verify removal was successful
                     if ((*SelectedBundle)->ContainsAsset(AssetId))
@@ -2236,7 +2127,7 @@ void SCustomAssetManagerEditorWindow::ShowRemoveFromBundleDialog(const FName& As
                     
                     try
                     {
-                        // Save the bundle
+                        // Save the bundle once the removal is verified
                         (*SelectedBundle)->Save();
                         
                         // Refresh the asset list to update bundle membership
@@ -3159,8 +3050,9 @@ void SCustomAssetManagerEditorWindow::ShowRemoveAssetsFromSelectedBundleDialog()
                     
                     if (FMessageDialog::Open(EAppMsgType::YesNo, Message, &Title) == EAppReturnType::Yes)
                     {
-                        // Remove all selected assets from the bundle
+                        // Remove all selected assets from the bundle as one batch
                         int32 RemovedCount = 0;
+                        SelectedBundle->BeginBatchEdit();
                         for (const TSharedPtr<FAssetListItem>& Item : SelectedItems)
                         {
                             // Skip invalid assets
@@ -3169,18 +3061,15 @@ void SCustomAssetManagerEditorWindow::ShowRemoveAssetsFromSelectedBundleDialog()
                                 continue;
                             }
                             
-                            UE_LOG(LogTemp, Log, TEXT("Removing asset %s from bundle %s"), 
-                                *Item->AssetId.ToString(), *SelectedBundle->BundleId.ToString());
-                                
                             // Remove the asset from the bundle
                             SelectedBundle->RemoveAsset(Item->AssetId);
                             RemovedCount++;
                         }
                         
-                        // Save the bundle
+                        // Commit and save the bundle once
                         try
                         {
-                            bool bSaved = SelectedBundle->Save();
+                            bool bSaved = SelectedBundle->CommitBatchEdit(true);
                             
                             if (!bSaved)
                             {
@@ -0,0 +1,65 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Linear arena for derived data that shares a single lifetime (for example a loaded bundle)
+ * Allocations bump a pointer inside large blocks and are only released all at once by Reset or destruction,
+ * so only trivially destructible types may be placed in it
+ */
+class CUSTOMASSETSTEST_API FCustomAssetArena : public FNoncopyable
+{
+public:
+    // Create an arena whose first block holds at least InitialBytes
+    explicit FCustomAssetArena(SIZE_T InitialBytes = 4096);
+    ~FCustomAssetArena();
+
+    // Allocate uninitialized memory
+    void* Alloc(SIZE_T Size, uint32 Alignment);
+
+    // Allocate a default-constructed array
+    template<typename T>
+    TArrayView<T> AllocArray(int32 Num)
+    {
+        static_assert(TIsTriviallyDestructible<T>::Value, "Arena memory is released without running destructors");
+        T* Data = static_cast<T*>(Alloc(sizeof(T) * Num, alignof(T)));
+        DefaultConstructItems<T>(Data, Num);
+        return TArrayView<T>(Data, Num);
+    }
+
+    // Copy an array into the arena
+    template<typename T>
+    TArrayView<T> CopyArray(TArrayView<const T> Source)
+    {
+        static_assert(TIsTriviallyDestructible<T>::Value, "Arena memory is released without running destructors");
+        T* Data = static_cast<T*>(Alloc(sizeof(T) * Source.Num(), alignof(T)));
+        ConstructItems<T>(Data, Source.GetData(), Source.Num());
+        return TArrayView<T>(Data, Source.Num());
+    }
+
+    // Release every block at once
+    void Reset();
+
+    // Bytes reserved from the heap
+    SIZE_T GetReservedBytes() const { return ReservedBytes; }
+
+    // Bytes handed out by Alloc
+    SIZE_T GetUsedBytes() const { return UsedBytes; }
+
+private:
+    // Header at the start of every block
+    struct FBlock
+    {
+        FBlock* Next;
+    };
+
+    // Allocate a new block with room for at least MinBytes
+    void AddBlock(SIZE_T MinBytes);
+
+    FBlock* Head = nullptr;
+    uint8* Cursor = nullptr;
+    uint8* End = nullptr;
+    SIZE_T BlockSize;
+    SIZE_T ReservedBytes = 0;
+    SIZE_T UsedBytes = 0;
+};
@@ -373,7 +373,7 @@ public:
     // LOD Functions
 
     /**
-     * Gets the appropriate LOD mesh for an item based on distance.
+     * Gets the appropriate LOD mesh for an item based on distance and the presentation memory budget.
      * @param ItemAsset The item asset to get the LOD mesh for.
      * @param Distance The distance from the camera or viewer.
      * @return The appropriate mesh for the specified distance.
@@ -382,7 +382,7 @@ public:
     static UStaticMesh* GetItemLODMesh(UCustomItemAsset* ItemAsset, float Distance);
 
     /**
-     * Gets the appropriate LOD mesh for a character based on distance.
+     * Gets the appropriate LOD mesh for a character based on distance and the presentation memory budget.
      * @param CharacterAsset The character asset to get the LOD mesh for.
      * @param Distance The distance from the camera or viewer.
      * @return The appropriate mesh for the specified distance.
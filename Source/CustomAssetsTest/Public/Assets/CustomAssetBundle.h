@@ -5,6 +5,56 @@
 #include "Assets/CustomAssetBase.h"
 #include "CustomAssetBundle.generated.h"
 
+/**
+ * Precomputed load manifest for a bundle: its members plus their transitive hard dependencies
+ */
+USTRUCT(BlueprintType)
+struct CUSTOMASSETSTEST_API FCustomAssetBundleManifest
+{
+    GENERATED_BODY()
+
+    // Members and transitive hard dependencies, each dependency ordered before the assets that need it
+    UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Manifest")
+    TArray<FName> LoadOrder;
+
+    // Estimated resident bytes of each entry in LoadOrder
+    UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Manifest")
+    TArray<int64> ResidentBytes;
+
+    // Estimated resident bytes of the whole closure
+    UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Manifest")
+    int64 EstimatedResidentBytes;
+
+    // On-disk size of the packages in the closure
+    UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Manifest")
+    int64 EstimatedDiskBytes;
+
+    // Hash of the bundle's AssetIds when the manifest was built
+    UPROPERTY(VisibleAnywhere, Category = "Manifest")
+    uint32 SourceHash;
+
+    // Whether the manifest has been built at all
+    UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Manifest")
+    bool bIsBuilt;
+
+    FCustomAssetBundleManifest()
+        : EstimatedResidentBytes(0)
+        , EstimatedDiskBytes(0)
+        , SourceHash(0)
+        , bIsBuilt(false)
+    {
+    }
+
+    // Order-sensitive hash of a bundle's asset IDs
+    static uint32 HashAssetIds(const TArray<FName>& AssetIds);
+
+    // Check if the manifest was built from the given asset IDs
+    bool IsUpToDate(const TArray<FName>& AssetIds) const
+    {
+        return bIsBuilt && SourceHash == HashAssetIds(AssetIds);
+    }
+};
+
 /**
  * Asset bundle for grouping related assets together
  */
@@ -32,6 +82,10 @@ public:
     UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Bundle")
     TArray<FName> AssetIds;
 
+    // Assets whose arrival fires the critical subset event before the rest of the bundle finishes loading
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Bundle")
+    TArray<FName> CriticalAssetIds;
+
     // Tags for categorizing and filtering bundles
     UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Bundle")
     TArray<FName> Tags;
@@ -48,31 +102,124 @@ public:
     UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Bundle")
     bool bKeepInMemory;
     
+    // Whether to group this bundle's assets into a GC cluster rooted at the bundle when loaded through the manager
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Bundle")
+    bool bCreateGCCluster;
+    
     // Whether all assets in this bundle are currently loaded
     UPROPERTY(BlueprintReadOnly, Category = "Bundle")
     bool bIsLoaded;
     
+    // Load manifest, refreshed by the manager when the bundle is saved or cooked
+    UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Bundle")
+    FCustomAssetBundleManifest Manifest;
+    
+    // Content hash of the bundle when its package was last written
+    UPROPERTY()
+    uint32 SavedContentHash = 0;
+    
     // Assets in this bundle (references to the actual asset objects)
     UPROPERTY(Transient)
     TArray<UCustomAssetBase*> Assets;
 
-    // Add an asset to the bundle
+    // Add an asset to the bundle (recorded until CommitBatchEdit while a batch edit is open)
     UFUNCTION(BlueprintCallable, Category = "Bundle")
     void AddAsset(const FName& AssetId);
 
-    // Remove an asset from the bundle
+    // Remove an asset from the bundle and save it (recorded until CommitBatchEdit while a batch edit is open)
     UFUNCTION(BlueprintCallable, Category = "Bundle")
     void RemoveAsset(const FName& AssetId);
 
+    // Add several assets as one batch edit
+    UFUNCTION(BlueprintCallable, Category = "Bundle")
+    bool AddAssets(const TArray<FName>& AssetIdsToAdd, bool bSave = false);
+
+    // Remove several assets as one batch edit
+    UFUNCTION(BlueprintCallable, Category = "Bundle")
+    bool RemoveAssets(const TArray<FName>& AssetIdsToRemove, bool bSave = true);
+
+    // Open a batch edit; batch edits nest and only the outermost commit applies them
+    UFUNCTION(BlueprintCallable, Category = "Bundle")
+    void BeginBatchEdit();
+
+    // Apply the recorded edits with one validation, index update and dirty mark, then save once if requested and anything changed
+    UFUNCTION(BlueprintCallable, Category = "Bundle")
+    bool CommitBatchEdit(bool bSave = true);
+
+    // Drop the recorded edits and close every open batch edit
+    UFUNCTION(BlueprintCallable, Category = "Bundle")
+    void CancelBatchEdit();
+
+    // Check if a batch edit is open
+    UFUNCTION(BlueprintCallable, Category = "Bundle")
+    bool IsBatchEditing() const { return BatchEditDepth > 0; }
+
     // Check if the bundle contains an asset
     UFUNCTION(BlueprintCallable, Category = "Bundle")
     bool ContainsAsset(const FName& AssetId) const;
+
+    // Rebuild the membership set from AssetIds, first adding the IDs of loaded assets missing from it
+    void RebuildMembershipSet();
     
     // Save the bundle 
     UFUNCTION(BlueprintCallable, Category = "Bundle")
     bool Save();
     
+    // Hash of the serialized properties that make up the bundle's content
+    uint32 ComputeContentHash() const;
+    
+    // Check if the bundle changed since its package was last written
+    UFUNCTION(BlueprintCallable, Category = "Bundle")
+    bool HasUnsavedChanges() const;
+    
     // Debug function to print the bundle's contents
     UFUNCTION(BlueprintCallable, Category = "Bundle")
     void DebugPrintContents(const FString& Context = TEXT("")) const;
+
+    // Form a GC cluster from the given loaded member assets (no-op unless bCreateGCCluster is set or bForce is true)
+    bool CreateGCCluster(const TArray<UCustomAssetBase*>& LoadedMembers, bool bForce = false);
+
+    // Dissolve the GC cluster rooted at this bundle, if any
+    void DissolveGCCluster();
+
+    // Check if this bundle is currently the root of a GC cluster
+    UFUNCTION(BlueprintCallable, Category = "Bundle")
+    bool IsGCClusterRoot() const;
+
+    //~ Begin UObject Interface
+    virtual bool CanBeClusterRoot() const override;
+    virtual void PreSave(FObjectPreSaveContext SaveContext) override;
+    virtual void PostLoad() override;
+#if WITH_EDITOR
+    virtual void PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent) override;
+    virtual void PostEditUndo() override;
+#endif
+    //~ End UObject Interface
+
+private:
+    // Build the membership set if it was invalidated since it was last built
+    void EnsureMembershipSet() const;
+
+#if WITH_EDITOR
+    // Rebuild the membership set after AssetIds was edited in place and report the difference to the asset manager
+    void SyncMembershipAfterDirectEdit();
+#endif
+
+    // Hashed copy of AssetIds for constant-time membership checks
+    mutable TSet<FName> AssetIdSet;
+
+    // Whether AssetIdSet matches AssetIds; cleared by every path that edits AssetIds
+    mutable bool bAssetIdSetBuilt = false;
+
+    // Number of open batch edits
+    int32 BatchEditDepth = 0;
+
+    // Whether any commit of the open batch edit asked for a save
+    bool bBatchSaveRequested = false;
+
+    // Edits recorded by the open batch edit in call order, true for additions
+    TArray<TPair<FName, bool>> PendingBatchEdits;
+
+    // Set while the manager creates the cluster so the loader never clusters the bundle on its own
+    bool bClusterCreationRequested = false;
 }; 
\ No newline at end of file
@@ -0,0 +1,71 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/NoExportTypes.h"
+#include "CustomAssetCoAccessRecorder.generated.h"
+
+/**
+ * Co-access statistics gathered in one level
+ */
+struct CUSTOMASSETSTEST_API FAssetCoAccessLevelStats
+{
+    // Number of recorded accesses per asset
+    TMap<FName, int32> AccessCounts;
+
+    // Number of times two assets were accessed within the window of each other, keyed by (lower, higher) asset ID
+    TMap<TPair<FName, FName>, int32> PairCounts;
+};
+
+/**
+ * Records which assets are requested within a time window of each other, per level, for offline bundle mining
+ */
+UCLASS(BlueprintType)
+class CUSTOMASSETSTEST_API UCustomAssetCoAccessRecorder : public UObject
+{
+    GENERATED_BODY()
+
+public:
+    // Record that an asset was requested while the given level was active
+    void RecordAccess(const FName& AssetId, const FName& LevelName);
+
+    // Drop everything recorded so far
+    UFUNCTION(BlueprintCallable, Category = "Co-Access")
+    void Reset();
+
+    // Write the statistics to a JSON trace file
+    UFUNCTION(BlueprintCallable, Category = "Co-Access")
+    bool SaveTrace(const FString& FilePath) const;
+
+    // Merge the statistics of a JSON trace file into this recorder
+    UFUNCTION(BlueprintCallable, Category = "Co-Access")
+    bool LoadTrace(const FString& FilePath);
+
+    // Get the number of accesses recorded
+    UFUNCTION(BlueprintCallable, Category = "Co-Access")
+    int32 GetRecordedAccessCount() const { return RecordedAccessCount; }
+
+    // Get the statistics per level
+    const TMap<FName, FAssetCoAccessLevelStats>& GetLevelStats() const { return LevelStats; }
+
+    // Trace file used when no path is given
+    static FString GetDefaultTracePath();
+
+    // Seconds within which two accesses count as co-access
+    float WindowSeconds = 10.0f;
+
+    // Maximum number of recent accesses each new access is paired with
+    int32 MaxWindowEntries = 128;
+
+private:
+    // Statistics per level
+    TMap<FName, FAssetCoAccessLevelStats> LevelStats;
+
+    // Accesses inside the current window, oldest first
+    TArray<TPair<FName, double>> RecentAccesses;
+
+    // Level the recent accesses were recorded in
+    FName RecentLevel;
+
+    // Number of accesses recorded
+    int32 RecordedAccessCount = 0;
+};
@@ -0,0 +1,27 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/LowLevelMemTracker.h"
+
+/**
+ * Low Level Memory tracker tags for the custom asset system.
+ * Underscores map to '/' in -llm captures, so every tag below is nested under CustomAssets.
+ */
+
+// Root tag for all custom asset system memory
+LLM_DECLARE_TAG_API(CustomAssets, CUSTOMASSETSTEST_API);
+
+// Asset manager bookkeeping (path maps, dependency graph, reachability, budget pools)
+LLM_DECLARE_TAG_API(CustomAssets_Manager, CUSTOMASSETSTEST_API);
+
+// Memory tracker statistics and timeline
+LLM_DECLARE_TAG_API(CustomAssets_MemoryTracker, CUSTOMASSETSTEST_API);
+
+// Bundle objects and their asset lists
+LLM_DECLARE_TAG_API(CustomAssets_Bundles, CUSTOMASSETSTEST_API);
+
+// Custom assets loaded through the manager
+LLM_DECLARE_TAG_API(CustomAssets_LoadedAssets, CUSTOMASSETSTEST_API);
+
+// Soft-referenced resources (meshes, textures) streamed in for custom assets
+LLM_DECLARE_TAG_API(CustomAssets_StreamedResources, CUSTOMASSETSTEST_API);
@@ -0,0 +1,87 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/NoExportTypes.h"
+#include "CustomAssetLevelTransitionModel.generated.h"
+
+/**
+ * How often one level followed another and how long the first one lasted
+ */
+struct CUSTOMASSETSTEST_API FLevelTransitionStats
+{
+    // Number of recorded transitions
+    int32 Count = 0;
+
+    // Seconds spent in the source level summed over all recorded transitions
+    double TotalSeconds = 0.0;
+};
+
+/**
+ * First-order Markov model of which level loads after which, persisted across sessions, used to prefetch the bundles of likely next levels
+ */
+UCLASS(BlueprintType)
+class CUSTOMASSETSTEST_API UCustomAssetLevelTransitionModel : public UObject
+{
+    GENERATED_BODY()
+
+public:
+    // Record that a level loaded after another one had been the latest for the given seconds
+    void RecordTransition(const FName& FromLevel, const FName& ToLevel, double SecondsInFromLevel);
+
+    // Get the levels most likely to follow a level, most likely first, with their probabilities
+    TArray<TPair<FName, float>> PredictNextLevels(const FName& FromLevel, int32 MaxLevels, float MinProbability) const;
+
+    // Get the probability that one level follows another
+    UFUNCTION(BlueprintCallable, Category = "Level Transitions")
+    float GetTransitionProbability(FName FromLevel, FName ToLevel) const;
+
+    // Get the average seconds spent in a level before the other one followed (0 if never seen)
+    UFUNCTION(BlueprintCallable, Category = "Level Transitions")
+    float GetExpectedTransitionSeconds(FName FromLevel, FName ToLevel) const;
+
+    // Score a prediction against the level that actually followed
+    void RecordPredictionOutcome(bool bHit);
+
+    // Get the fraction of scored predictions that named the level that followed
+    UFUNCTION(BlueprintCallable, Category = "Level Transitions")
+    float GetPredictionHitRate() const;
+
+    // Get the number of scored predictions
+    UFUNCTION(BlueprintCallable, Category = "Level Transitions")
+    int32 GetPredictionCount() const { return PredictionHits + PredictionMisses; }
+
+    // Get the number of transitions recorded since the model was loaded
+    UFUNCTION(BlueprintCallable, Category = "Level Transitions")
+    int32 GetSessionTransitionCount() const { return SessionTransitionCount; }
+
+    // Drop everything recorded so far
+    UFUNCTION(BlueprintCallable, Category = "Level Transitions")
+    void Reset();
+
+    // Write the model to a JSON file
+    UFUNCTION(BlueprintCallable, Category = "Level Transitions")
+    bool SaveModel(const FString& FilePath) const;
+
+    // Merge the transitions of a JSON file into this model
+    UFUNCTION(BlueprintCallable, Category = "Level Transitions")
+    bool LoadModel(const FString& FilePath);
+
+    // Model file used when no path is given
+    static FString GetDefaultModelPath();
+
+private:
+    // Transition statistics per source level, keyed by destination level
+    TMap<FName, TMap<FName, FLevelTransitionStats>> Transitions;
+
+    // Number of transitions recorded out of each level
+    TMap<FName, int32> DepartureCounts;
+
+    // Number of scored predictions that named the level that followed
+    int32 PredictionHits = 0;
+
+    // Number of scored predictions that did not
+    int32 PredictionMisses = 0;
+
+    // Number of transitions recorded since the model was loaded
+    int32 SessionTransitionCount = 0;
+};
@@ -5,15 +5,24 @@
 #include "Assets/CustomAssetBase.h"
 #include "Containers/Map.h"
 #include "Engine/StreamableManager.h"
+#include "Containers/Ticker.h"
+#include "Assets/CustomAssetResidencyAuditor.h"
+#include "Assets/CustomAssetCoAccessRecorder.h"
+#include "Assets/CustomAssetLevelTransitionModel.h"
+#include "Assets/CustomAssetArena.h"
 #include "CustomAssetManager.generated.h"
 
 // Forward declarations
 class UCustomAssetBundle;
 class UCustomAssetMemoryTracker;
+class ULevel;
 
 // Define a delegate for asset loading completion
 DECLARE_DYNAMIC_DELEGATE(FOnAssetLoaded);
 
+// Delegate broadcast when presentation quality switches between high and low detail variants
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnPresentationQualityChanged, bool, bLowDetail);
+
 /**
  * Enum defining different asset loading strategies
  */
@@ -110,13 +119,444 @@ struct FBundleLevelAssociation
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Level Streaming")
     bool bUnloadWithLevel = true;
     
-    FBundleLevelAssociation() : BundleId(NAME_None), LevelName(NAME_None), PreloadDistance(5000.0f), bUnloadWithLevel(true) {}
+    // Owner under which the level holds the bundle, built once at registration instead of on every streaming update
+    FName OwnerId;
+    
+    FBundleLevelAssociation() : BundleId(NAME_None), LevelName(NAME_None), PreloadDistance(5000.0f), bUnloadWithLevel(true), OwnerId(NAME_None) {}
+};
+
+/**
+ * Structure for associating a bundle with a region of a World Partition streaming grid
+ */
+USTRUCT(BlueprintType)
+struct FBundleStreamingRegionAssociation
+{
+    GENERATED_BODY()
+    
+    // ID of the bundle to load
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Level Streaming")
+    FName BundleId;
+    
+    // Name of the region
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Level Streaming")
+    FName RegionName;
+    
+    // Runtime grid whose cells drive the region (None matches every grid)
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Level Streaming")
+    FName GridName;
+    
+    // World space bounds of the region
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Level Streaming")
+    FBox Bounds;
+    
+    // Distance around the region at which a streaming source requests the bundle before any cell loads (0 waits for the cells)
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Level Streaming")
+    float PrefetchDistance = 0.0f;
+    
+    // Whether the bundle is held only while a cell is activated rather than once it is loaded
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Level Streaming")
+    bool bRequireActivation = false;
+    
+    FBundleStreamingRegionAssociation() : BundleId(NAME_None), RegionName(NAME_None), GridName(NAME_None), Bounds(EForceInit::ForceInit), PrefetchDistance(0.0f), bRequireActivation(false) {}
+};
+
+/**
+ * Structure for associating a bundle with a World Partition Data Layer
+ */
+USTRUCT(BlueprintType)
+struct FBundleDataLayerAssociation
+{
+    GENERATED_BODY()
+    
+    // ID of the bundle to load
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Level Streaming")
+    FName BundleId;
+    
+    // Name of the Data Layer asset
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Level Streaming")
+    FName DataLayerName;
+    
+    FBundleDataLayerAssociation() : BundleId(NAME_None), DataLayerName(NAME_None) {}
+};
+
+/**
+ * Memory attributed to the bundles of a Data Layer since its last state change
+ */
+USTRUCT(BlueprintType)
+struct FDataLayerBundleMemoryReport
+{
+    GENERATED_BODY()
+    
+    // Name of the Data Layer asset
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Level Streaming")
+    FName DataLayerName;
+    
+    // Whether the Data Layer currently holds its bundles
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Level Streaming")
+    bool bActive = false;
+    
+    // Bundles associated with the Data Layer
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Level Streaming")
+    TArray<FName> BundleIds;
+    
+    // Bytes of the Data Layer's bundle assets that are loaded now
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Level Streaming")
+    int64 BundleLoadedBytes = 0;
+    
+    // Bytes of the Data Layer's bundle assets that were loaded when it last changed state
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Level Streaming")
+    int64 LoadedBytesAtTransition = 0;
+    
+    // Change of the Data Layer's bundle loaded bytes since the last state change
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Level Streaming")
+    int64 DeltaBytesSinceTransition = 0;
+    
+    // Number of times the Data Layer changed state
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Level Streaming")
+    int32 TransitionCount = 0;
+    
+    // When the Data Layer last changed state
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Level Streaming")
+    FDateTime LastTransitionTime;
+    
+    FDataLayerBundleMemoryReport() : DataLayerName(NAME_None), bActive(false), BundleLoadedBytes(0), LoadedBytesAtTransition(0), DeltaBytesSinceTransition(0), TransitionCount(0) {}
+};
+
+/**
+ * A viewer whose current and predicted locations drive level-based bundle streaming
+ */
+USTRUCT(BlueprintType)
+struct FBundleStreamingViewer
+{
+    GENERATED_BODY()
+    
+    // Current location of the viewer
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Level Streaming")
+    FVector Location = FVector::ZeroVector;
+    
+    // Predicted locations, one every PredictionStepSeconds, nearest in time first
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Level Streaming")
+    TArray<FVector> PredictedPath;
+    
+    // Seconds between predicted locations
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Level Streaming")
+    float PredictionStepSeconds = 0.5f;
+    
+    FBundleStreamingViewer() : Location(FVector::ZeroVector), PredictionStepSeconds(0.5f) {}
+};
+
+/**
+ * Memory budget pool for a subset of assets
+ * Pools are selected by asset class, tag and bundle, nest through ParentPoolId,
+ * and evict only their own assets when they overflow
+ */
+USTRUCT(BlueprintType)
+struct FAssetBudgetPool
+{
+    GENERATED_BODY()
+    
+    // Unique ID of the pool
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Memory Budgets")
+    FName PoolId;
+    
+    // ID of the enclosing pool (None for a top-level pool)
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Memory Budgets")
+    FName ParentPoolId;
+    
+    // Only assets of this class (or a subclass) belong to the pool, unset matches any class
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Memory Budgets")
+    TSubclassOf<UCustomAssetBase> AssetClass;
+    
+    // Only assets with this tag belong to the pool, None matches any tag
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Memory Budgets")
+    FName Tag;
+    
+    // Only assets in this bundle belong to the pool, None matches any bundle
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Memory Budgets")
+    FName BundleId;
+    
+    // Memory limit of the pool in megabytes (0 for no limit)
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Memory Budgets", meta = (ClampMin = "0"))
+    int32 LimitMB = 0;
+    
+    // Policy used to pick assets to evict when the pool is over its limit
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Memory Budgets")
+    EMemoryManagementPolicy EvictionPolicy = EMemoryManagementPolicy::UnloadLRU;
+    
+    FAssetBudgetPool() : PoolId(NAME_None), ParentPoolId(NAME_None), Tag(NAME_None), BundleId(NAME_None), LimitMB(0), EvictionPolicy(EMemoryManagementPolicy::UnloadLRU) {}
+};
+
+/**
+ * Runtime data the manager derives from a loaded bundle
+ * Everything lives in the bundle's arena and is released in one step when the bundle is unloaded
+ */
+struct CUSTOMASSETSTEST_API FBundleRuntimeData
+{
+    // Arena backing all arrays below
+    FCustomAssetArena Arena;
+    
+    // Member asset IDs, sorted with FNameFastLess for binary search
+    TArrayView<FName> MemberIds;
+    
+    // Estimated memory of each member at load time, parallel to MemberIds
+    TArrayView<int64> MemberMemory;
+    
+    // Hard dependencies of the members that are not members themselves, sorted with FNameFastLess
+    TArrayView<FName> ExternalHardDependencyIds;
+    
+    // Sum of MemberMemory
+    int64 EstimatedMemory = 0;
+    
+    explicit FBundleRuntimeData(SIZE_T InitialArenaBytes) : Arena(InitialArenaBytes) {}
+    
+    // Check if an asset is a member of the bundle
+    bool ContainsMember(const FName& AssetId) const;
+};
+
+/**
+ * Streaming state of the high and low detail mesh variants of one asset
+ */
+struct FPresentationVariantState
+{
+    // Soft references to the variants
+    FSoftObjectPath HighDetailPath;
+    FSoftObjectPath LowDetailPath;
+    
+    // Handles keeping the variants resident (null when released)
+    TSharedPtr<FStreamableHandle> HighDetailHandle;
+    TSharedPtr<FStreamableHandle> LowDetailHandle;
+    
+    // Measured size of each variant in bytes (0 until first loaded)
+    int64 HighDetailBytes = 0;
+    int64 LowDetailBytes = 0;
+    
+    // When each variant was last requested, idle variants are released
+    double HighDetailRequestTime = 0.0;
+    double LowDetailRequestTime = 0.0;
+    
+    // Whether the high detail variant was released because of memory pressure
+    bool bDowngraded = false;
+};
+
+/**
+ * Report of the objects made permanent by startup bundles kept in memory (rooted and clustered, the runtime stand-in for the disregard-for-GC pool)
+ */
+USTRUCT(BlueprintType)
+struct FDisregardForGCReport
+{
+    GENERATED_BODY()
+    
+    // Bundles made permanent
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Asset Bundles")
+    TArray<FName> BundleIds;
+    
+    // Number of objects GC no longer traverses individually
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Asset Bundles")
+    int32 ObjectCount = 0;
+    
+    // Exclusive resource size of those objects, in bytes
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Asset Bundles")
+    int64 Bytes = 0;
+    
+    FDisregardForGCReport() : ObjectCount(0), Bytes(0) {}
+};
+
+/**
+ * Progress of a bundle load, in assets and estimated bytes
+ */
+USTRUCT(BlueprintType)
+struct FBundleLoadProgress
+{
+    GENERATED_BODY()
+    
+    // Bundle being loaded
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Asset Bundles")
+    FName BundleId;
+    
+    // Assets of the manifest closure that are usable
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Asset Bundles")
+    int32 LoadedAssets = 0;
+    
+    // Assets in the manifest closure
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Asset Bundles")
+    int32 TotalAssets = 0;
+    
+    // Estimated resident bytes of the usable assets
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Asset Bundles")
+    int64 LoadedBytes = 0;
+    
+    // Estimated resident bytes of the manifest closure
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Asset Bundles")
+    int64 TotalBytes = 0;
+    
+    // Whether the bundle's critical assets are usable
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Asset Bundles")
+    bool bCriticalSubsetReady = false;
+    
+    // Whether the load has finished
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Asset Bundles")
+    bool bComplete = false;
+    
+    FBundleLoadProgress() : BundleId(NAME_None), LoadedAssets(0), TotalAssets(0), LoadedBytes(0), TotalBytes(0), bCriticalSubsetReady(false), bComplete(false) {}
+    
+    // Fraction of the load done, by bytes when sizes are known and by asset count otherwise
+    float GetFraction() const
+    {
+        if (TotalBytes > 0)
+        {
+            return static_cast<float>(static_cast<double>(LoadedBytes) / static_cast<double>(TotalBytes));
+        }
+        return TotalAssets > 0 ? static_cast<float>(LoadedAssets) / static_cast<float>(TotalAssets) : 1.0f;
+    }
+};
+
+// Delegate broadcast whenever a bundle load makes progress
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnBundleLoadProgress, FName, BundleId, const FBundleLoadProgress&, Progress);
+
+// Delegate broadcast for each asset of a loading bundle as soon as it is usable
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnBundleAssetAvailable, FName, BundleId, FName, AssetId);
+
+// Delegate broadcast once the critical assets of a loading bundle are usable
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnBundleCriticalSubsetReady, FName, BundleId);
+
+/**
+ * Asset-level summary of a bundle set transition
+ */
+USTRUCT(BlueprintType)
+struct FBundleTransitionResult
+{
+    GENERATED_BODY()
+    
+    // Assets of the incoming closure that had to be requested
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Asset Bundles")
+    int32 AssetsLoaded = 0;
+    
+    // Assets of the incoming closure that were already resident
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Asset Bundles")
+    int32 AssetsRetained = 0;
+    
+    // Assets of the outgoing bundles that were unloaded
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Asset Bundles")
+    int32 AssetsReleased = 0;
+    
+    // Estimated bytes requested for the incoming bundles
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Asset Bundles")
+    int64 BytesLoaded = 0;
+    
+    // Tracked bytes of the released assets
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Asset Bundles")
+    int64 BytesReleased = 0;
+    
+    FBundleTransitionResult() : AssetsLoaded(0), AssetsRetained(0), AssetsReleased(0), BytesLoaded(0), BytesReleased(0) {}
+};
+
+/**
+ * Progress of an asynchronous SaveAllBundles
+ */
+USTRUCT(BlueprintType)
+struct FBundleSaveProgress
+{
+    GENERATED_BODY()
+    
+    // Registered bundles queued for saving
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Asset Bundles")
+    int32 TotalBundles = 0;
+    
+    // Queued bundles written so far
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Asset Bundles")
+    int32 SavedBundles = 0;
+    
+    // Bundles that could not be prepared or written
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Asset Bundles")
+    int32 FailedBundles = 0;
+    
+    // Bundles skipped because they match their package on disk
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Asset Bundles")
+    int32 UnchangedBundles = 0;
+    
+    // Whether the save was cancelled before every queued bundle was written
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Asset Bundles")
+    bool bCancelled = false;
+    
+    // Whether the save has finished or was cancelled
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Asset Bundles")
+    bool bComplete = false;
+    
+    FBundleSaveProgress() : TotalBundles(0), SavedBundles(0), FailedBundles(0), UnchangedBundles(0), bCancelled(false), bComplete(false) {}
+    
+    // Fraction of the queued bundles that have been written, skipped or failed
+    float GetFraction() const
+    {
+        return TotalBundles > 0 ? static_cast<float>(SavedBundles + FailedBundles + UnchangedBundles) / static_cast<float>(TotalBundles) : 1.0f;
+    }
+};
+
+// Delegate broadcast as an asynchronous SaveAllBundles makes progress and when it finishes
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnBundleSaveProgress, const FBundleSaveProgress&, Progress);
+
+// Delegate broadcast when a bundle package has been written or failed to be
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnBundleSaved, FName, BundleId, bool, bSuccess);
+
+/**
+ * A bundle package prepared for writing
+ */
+struct FPendingBundleSave
+{
+    // ID of the bundle being saved
+    FName BundleId;
+    
+    // Bundle object living in the target package
+    TWeakObjectPtr<UCustomAssetBundle> SavedBundle;
+    
+    // Long package name to write
+    FString PackagePath;
+    
+    // Content hash to store with the package, only kept once the write succeeds
+    uint32 ContentHash = 0;
+    
+    // Content hash the saved bundle had before, restored if the write fails
+    uint32 PreviousContentHash = 0;
+};
+
+/**
+ * Owners holding a bundle loaded through AcquireBundle
+ */
+struct FBundleReferenceState
+{
+    // Levels, systems or pins holding the bundle
+    TSet<FName> Owners;
+    
+    // Game time at which an unowned bundle is unloaded (0 while owned)
+    double LingerDeadline = 0.0;
+};
+
+/**
+ * Book-keeping of a bundle load in flight
+ */
+struct FBundleLoadState
+{
+    // Handle of the streaming request (null for synchronous loads)
+    TSharedPtr<FStreamableHandle> Handle;
+    
+    // Closure assets that are not usable yet, with their estimated bytes
+    TArray<FName> PendingAssetIds;
+    TArray<int64> PendingAssetBytes;
+    
+    // Critical assets that are not usable yet
+    TSet<FName> PendingCriticalAssetIds;
+    
+    // Whether the bundle configured a critical subset
+    bool bHasCriticalSubset = false;
+    
+    FBundleLoadProgress Progress;
 };
 
 /**
  * Custom asset manager for handling loading, unloading, and tracking custom assets
+ *
+ * Config properties are read from [/Script/CustomAssetsTest.CustomAssetManager] in DefaultGame.ini.
  */
-UCLASS()
+UCLASS(config = Game)
 class CUSTOMASSETSTEST_API UCustomAssetManager : public UAssetManager
 {
     GENERATED_BODY()
@@ -130,6 +570,9 @@ public:
     // Initialize the asset manager
     virtual void StartInitialLoading() override;
 
+    // Stop periodic work before the manager is destroyed
+    virtual void BeginDestroy() override;
+
     // Load an asset by its ID
     UFUNCTION(BlueprintCallable, Category = "Asset Management")
     UCustomAssetBase* LoadAssetById(const FName& AssetId);
@@ -162,6 +605,9 @@ public:
     UFUNCTION(BlueprintCallable, Category = "Asset Management")
     TArray<UCustomAssetBase*> GetAllLoadedAssets() const;
 
+    // Get the map of asset IDs to loaded assets (entries can be stale, see RunResidencyAudit)
+    const TMap<FName, UCustomAssetBase*>& GetLoadedAssetMap() const { return LoadedAssets; }
+
     // Get all asset IDs
     UFUNCTION(BlueprintCallable, Category = "Asset Management")
     TArray<FName> GetAllAssetIds() const;
@@ -207,18 +653,43 @@ public:
     UFUNCTION(BlueprintCallable, Category = "Asset Bundles")
     void LoadBundle(const FName& BundleId, EAssetLoadingStrategy Strategy = EAssetLoadingStrategy::OnDemand);
 
-    // Unload all assets in a bundle
+    // Unload all assets in a bundle; every owner that acquired it loses its hold
     UFUNCTION(BlueprintCallable, Category = "Asset Bundles")
     void UnloadBundle(const FName& BundleId);
 
-    // Save a bundle to the project
+    // Save a bundle to the project; the registered instance is replaced by the bundle object in its package
     UFUNCTION(BlueprintCallable, Category = "Asset Bundles")
     bool SaveBundle(UCustomAssetBundle* Bundle, const FString& PackagePath = TEXT(""));
 
-    // Save all bundles to the project
+    // Save all bundles to the project; registered instances are replaced by the bundle objects in their packages
     UFUNCTION(BlueprintCallable, Category = "Asset Bundles")
     int32 SaveAllBundles(const FString& BasePath = TEXT(""));
 
+    // Queue every registered bundle and prepare and write the changed ones over the next ticks; returns the number of bundles queued.
+    // Each bundle is prepared right before it is written, so edits made while the save runs are included, and the registered instance is replaced by the bundle object in its package
+    UFUNCTION(BlueprintCallable, Category = "Asset Bundles")
+    int32 SaveAllBundlesAsync(const FString& BasePath = TEXT(""));
+
+    // Stop an asynchronous SaveAllBundles after the packages already written
+    UFUNCTION(BlueprintCallable, Category = "Asset Bundles")
+    void CancelSaveAllBundles();
+
+    // Check if an asynchronous SaveAllBundles is running
+    UFUNCTION(BlueprintCallable, Category = "Asset Bundles")
+    bool IsSavingBundles() const { return bBundleSaveInProgress; }
+
+    // Get the progress of the current or last asynchronous SaveAllBundles
+    UFUNCTION(BlueprintCallable, Category = "Asset Bundles")
+    FBundleSaveProgress GetBundleSaveProgress() const { return BundleSaveProgress; }
+
+    // Fired as an asynchronous SaveAllBundles makes progress and once it finishes or is cancelled
+    UPROPERTY(BlueprintAssignable, Category = "Asset Bundles")
+    FOnBundleSaveProgress OnBundleSaveProgress;
+
+    // Fired for every bundle package written, or failed to be, by SaveBundle and SaveAllBundles
+    UPROPERTY(BlueprintAssignable, Category = "Asset Bundles")
+    FOnBundleSaved OnBundleSaved;
+
     // Scan for all available bundles in the content directory
     UFUNCTION(BlueprintCallable, Category = "Asset Bundles")
     void ScanForBundles();
@@ -227,10 +698,48 @@ public:
     UFUNCTION(BlueprintCallable, Category = "Asset Bundles")
     void PreloadBundles();
 
+    // Get the report of startup bundles made permanent
+    UFUNCTION(BlueprintCallable, Category = "Asset Bundles")
+    FDisregardForGCReport GetDisregardForGCReport() const;
+
+    // Get the runtime data derived from a loaded bundle (nullptr if the bundle is not loaded)
+    const FBundleRuntimeData* GetBundleRuntimeData(const FName& BundleId) const;
+
+    // Rebuild a bundle's load manifest (dependency closure, load order and size estimates)
+    UFUNCTION(BlueprintCallable, Category = "Asset Bundles")
+    bool RefreshBundleManifest(UCustomAssetBundle* Bundle, bool bLoadMissingAssets = true);
+
+    // Check if a bundle load is waiting for memory to become available
+    UFUNCTION(BlueprintCallable, Category = "Asset Bundles")
+    bool IsBundleLoadDeferred(const FName& BundleId) const;
+
+    // Drop a bundle load that is waiting for memory to become available
+    UFUNCTION(BlueprintCallable, Category = "Asset Bundles")
+    void CancelDeferredBundleLoad(const FName& BundleId);
+
+    // Get the load progress of a bundle (returns false if the bundle is neither loading nor loaded)
+    UFUNCTION(BlueprintCallable, Category = "Asset Bundles")
+    bool GetBundleLoadProgress(const FName& BundleId, FBundleLoadProgress& OutProgress) const;
+
+    // Fired whenever a bundle load makes progress, and once more when it completes
+    UPROPERTY(BlueprintAssignable, Category = "Asset Bundles")
+    FOnBundleLoadProgress OnBundleLoadProgress;
+
+    // Fired for each asset of a loading bundle as soon as it is usable
+    UPROPERTY(BlueprintAssignable, Category = "Asset Bundles")
+    FOnBundleAssetAvailable OnBundleAssetAvailable;
+
+    // Fired once the bundle's CriticalAssetIds are usable, or on completion if it has none
+    UPROPERTY(BlueprintAssignable, Category = "Asset Bundles")
+    FOnBundleCriticalSubsetReady OnBundleCriticalSubsetReady;
+
     // Get all bundles containing the specified asset
     UFUNCTION(BlueprintCallable, Category = "Asset Bundles")
     TArray<UCustomAssetBundle*> GetAllBundlesContainingAsset(const FName& AssetId) const;
 
+    // Keep the asset-to-bundle index in sync when a registered bundle gains or loses assets
+    void NotifyBundleAssetsChanged(const UCustomAssetBundle* Bundle, const TArray<FName>& AddedAssetIds, const TArray<FName>& RemovedAssetIds);
+
     // Delete a bundle by its ID
     UFUNCTION(BlueprintCallable, Category = "Asset Bundles")
     bool DeleteBundle(const FName& BundleId);
@@ -239,6 +748,45 @@ public:
     UFUNCTION(BlueprintCallable, Category = "Asset Bundles")
     bool RenameBundle(const FName& BundleId, const FString& NewName);
 
+    // Switch from one set of bundles to another, loading and unloading only the assets that differ
+    UFUNCTION(BlueprintCallable, Category = "Asset Bundles")
+    FBundleTransitionResult TransitionBundles(const TArray<FName>& OutgoingBundleIds, const TArray<FName>& IncomingBundleIds, EAssetLoadingStrategy Strategy = EAssetLoadingStrategy::Streaming);
+
+    // BUNDLE REFERENCE COUNTING
+
+    // Hold a bundle loaded on behalf of an owner (a level, system or pin), loading it if needed
+    UFUNCTION(BlueprintCallable, Category = "Asset Bundles|References")
+    void AcquireBundle(FName BundleId, FName OwnerId, EAssetLoadingStrategy Strategy = EAssetLoadingStrategy::Streaming);
+
+    // Drop an owner's hold on a bundle, the bundle unloads once no owner is left and the linger time has passed
+    UFUNCTION(BlueprintCallable, Category = "Asset Bundles|References")
+    void ReleaseBundle(FName BundleId, FName OwnerId, bool bUnloadImmediately = false);
+
+    // Drop every hold an owner has on any bundle
+    UFUNCTION(BlueprintCallable, Category = "Asset Bundles|References")
+    void ReleaseAllBundlesForOwner(FName OwnerId);
+
+    // Get the number of owners holding a bundle
+    UFUNCTION(BlueprintCallable, Category = "Asset Bundles|References")
+    int32 GetBundleReferenceCount(FName BundleId) const;
+
+    // Get the owners holding a bundle
+    UFUNCTION(BlueprintCallable, Category = "Asset Bundles|References")
+    TArray<FName> GetBundleOwners(FName BundleId) const;
+
+    // Set how long an unowned bundle stays loaded before it is unloaded
+    UFUNCTION(BlueprintCallable, Category = "Asset Bundles|References")
+    void SetBundleLingerTime(float Seconds);
+
+    // Owner ID used for bundles held by a level
+    static FName GetLevelBundleOwner(FName LevelName);
+
+    // Owner ID used for bundles held by a World Partition streaming region
+    static FName GetStreamingRegionBundleOwner(FName RegionName);
+
+    // Owner ID used for bundles held by a Data Layer
+    static FName GetDataLayerBundleOwner(FName DataLayerName);
+
     // DEPENDENCY FUNCTIONS
 
     // Load all dependencies for an asset
@@ -261,6 +809,32 @@ public:
     UFUNCTION(BlueprintCallable, Category = "Asset Dependencies")
     bool ExportDependencyGraph(const FString& FilePath) const;
 
+    // REACHABILITY FUNCTIONS
+
+    // Pin an asset so it stays a root and is never collected or evicted
+    UFUNCTION(BlueprintCallable, Category = "Asset Reachability")
+    void PinAsset(const FName& AssetId);
+
+    // Remove the pin from an asset
+    UFUNCTION(BlueprintCallable, Category = "Asset Reachability")
+    void UnpinAsset(const FName& AssetId);
+
+    // Check if an asset is pinned
+    UFUNCTION(BlueprintCallable, Category = "Asset Reachability")
+    bool IsAssetPinned(const FName& AssetId) const;
+
+    // Get all current roots (direct loads, pins, loaded bundles and level-associated bundles)
+    UFUNCTION(BlueprintCallable, Category = "Asset Reachability")
+    TArray<FName> GetReachabilityRoots() const;
+
+    // Run a full reachability pass now and unload every asset not reachable from a root
+    UFUNCTION(BlueprintCallable, Category = "Asset Reachability")
+    int32 CollectUnreachableAssets();
+
+    // Enable or disable the incremental reachability collector that runs on the manager tick
+    UFUNCTION(BlueprintCallable, Category = "Asset Reachability")
+    void SetReachabilityCollectionEnabled(bool bEnabled);
+
     // MEMORY MANAGEMENT FUNCTIONS
 
     // Set the memory management policy
@@ -291,9 +865,75 @@ public:
     UFUNCTION(BlueprintCallable, Category = "Memory Management")
     bool ExportMemoryUsageToCSV(const FString& FilePath) const;
 
+    // Set how often the memory timeline is sampled (0 disables sampling)
+    UFUNCTION(BlueprintCallable, Category = "Memory Management")
+    void SetTimelineSampleInterval(float IntervalSeconds);
+
+    // Export the memory timeline and high-water marks (binary if bBinary, CSV otherwise)
+    UFUNCTION(BlueprintCallable, Category = "Memory Management")
+    bool ExportMemoryTimeline(const FString& FilePath, bool bBinary = false) const;
+
+    // MEMORY BUDGET POOLS
+
+    // Register or update a memory budget pool
+    UFUNCTION(BlueprintCallable, Category = "Memory Budgets")
+    bool RegisterBudgetPool(const FAssetBudgetPool& Pool);
+
+    // Remove a memory budget pool (child pools are re-parented to its parent)
+    UFUNCTION(BlueprintCallable, Category = "Memory Budgets")
+    void UnregisterBudgetPool(FName PoolId);
+
+    // Get all registered memory budget pools
+    UFUNCTION(BlueprintCallable, Category = "Memory Budgets")
+    TArray<FAssetBudgetPool> GetAllBudgetPools() const;
+
+    // Get the pool an asset is charged to (None if it belongs to no pool)
+    UFUNCTION(BlueprintCallable, Category = "Memory Budgets")
+    FName GetBudgetPoolForAsset(const FName& AssetId) const;
+
+    // Get the memory used by a pool and all its nested pools, in bytes
+    UFUNCTION(BlueprintCallable, Category = "Memory Budgets")
+    int64 GetBudgetPoolUsage(FName PoolId) const;
+
     // Get the memory tracker
     UFUNCTION(BlueprintCallable, Category = "Memory Management")
     UCustomAssetMemoryTracker* GetMemoryTracker() const;
+
+    // Compare loaded assets with the custom assets resident in memory and log the mismatches
+    UFUNCTION(BlueprintCallable, Category = "Memory Management")
+    FAssetResidencyReport RunResidencyAudit(bool bCollectGarbageFirst = false);
+
+    // Set how often residency is audited after a garbage collection (0 disables periodic audits)
+    UFUNCTION(BlueprintCallable, Category = "Memory Management")
+    void SetResidencyAuditInterval(float IntervalSeconds);
+
+    // Get the residency auditor
+    UFUNCTION(BlueprintCallable, Category = "Memory Management")
+    UCustomAssetResidencyAuditor* GetResidencyAuditor() const;
+
+    // Record which assets are requested within a time window of each other, per level
+    UFUNCTION(BlueprintCallable, Category = "Memory Management")
+    void SetCoAccessRecordingEnabled(bool bEnabled);
+
+    // Write the recorded co-access statistics to a JSON trace (empty path uses Saved/CustomAssets/CoAccessTrace.json)
+    UFUNCTION(BlueprintCallable, Category = "Memory Management")
+    bool SaveCoAccessTrace(const FString& FilePath = TEXT(""));
+
+    // Get the co-access recorder
+    UFUNCTION(BlueprintCallable, Category = "Memory Management")
+    UCustomAssetCoAccessRecorder* GetCoAccessRecorder() const;
+
+    // Write the learned level transitions to JSON (empty path uses Saved/CustomAssets/LevelTransitions.json)
+    UFUNCTION(BlueprintCallable, Category = "Level Streaming")
+    bool SaveLevelTransitionModel(const FString& FilePath = TEXT(""));
+
+    // Get the level transition model
+    UFUNCTION(BlueprintCallable, Category = "Level Streaming")
+    UCustomAssetLevelTransitionModel* GetLevelTransitionModel() const;
+
+    // Get the levels predicted to follow the latest loaded level
+    UFUNCTION(BlueprintCallable, Category = "Level Streaming")
+    TArray<FName> GetPredictedNextLevels() const { return PredictedNextLevels; }
     
     // Register an asset with the manager
     UFUNCTION(BlueprintCallable, Category = "Asset Management")
@@ -339,6 +979,10 @@ public:
     UFUNCTION(BlueprintCallable, Category = "Asset Prefetching")
     float GetDistanceToAsset(const FName& AssetId, const FVector& FromLocation) const;
     
+    // Prefetch the other members of an asset's bundles when the asset is first requested directly
+    UFUNCTION(BlueprintCallable, Category = "Asset Prefetching")
+    void SetBundleAffinityPrefetchEnabled(bool bEnabled, int32 MaxAssets = 32);
+    
     // ASSET COMPRESSION TIERS
     
     // Set compression tier for a specific asset
@@ -367,10 +1011,62 @@ public:
     UFUNCTION(BlueprintCallable, Category = "Level Streaming")
     void UnregisterBundleFromLevel(FName BundleId, FName LevelName);
     
+    // Register a bundle to be loaded while World Partition cells overlapping a region are loaded
+    UFUNCTION(BlueprintCallable, Category = "Level Streaming")
+    void RegisterBundleWithStreamingRegion(FName BundleId, FName RegionName, const FBox& Bounds, FName GridName = NAME_None, float PrefetchDistance = 0.f, bool bRequireActivation = false);
+    
+    // Unregister a bundle from a streaming region
+    UFUNCTION(BlueprintCallable, Category = "Level Streaming")
+    void UnregisterBundleFromStreamingRegion(FName BundleId, FName RegionName);
+    
+    // Acquire and release region bundles from the World Partition cell states and streaming sources
+    UFUNCTION(BlueprintCallable, Category = "Level Streaming")
+    void UpdateStreamingRegionBundles();
+    
+    // Check if a region currently holds a bundle
+    UFUNCTION(BlueprintCallable, Category = "Level Streaming")
+    bool IsBundleHeldByStreamingRegion(FName BundleId, FName RegionName) const;
+    
+    // Register a bundle to be loaded while a Data Layer is active
+    UFUNCTION(BlueprintCallable, Category = "Level Streaming")
+    void RegisterBundleWithDataLayer(FName BundleId, FName DataLayerName);
+    
+    // Unregister a bundle from a Data Layer
+    UFUNCTION(BlueprintCallable, Category = "Level Streaming")
+    void UnregisterBundleFromDataLayer(FName BundleId, FName DataLayerName);
+    
+    // Notify the asset manager that a Data Layer was activated or deactivated
+    UFUNCTION(BlueprintCallable, Category = "Level Streaming")
+    void OnDataLayerStateChanged(FName DataLayerName, bool bActive);
+    
+    // Check if a Data Layer currently holds its bundles
+    UFUNCTION(BlueprintCallable, Category = "Level Streaming")
+    bool IsDataLayerActive(FName DataLayerName) const;
+    
+    // Get the memory report of a Data Layer
+    UFUNCTION(BlueprintCallable, Category = "Level Streaming")
+    FDataLayerBundleMemoryReport GetDataLayerMemoryReport(FName DataLayerName) const;
+    
+    // Get the memory reports of all Data Layers that have bundles or changed state
+    UFUNCTION(BlueprintCallable, Category = "Level Streaming")
+    TArray<FDataLayerBundleMemoryReport> GetDataLayerMemoryReports() const;
+    
     // Update level-based bundles based on player location
     UFUNCTION(BlueprintCallable, Category = "Level Streaming")
     void UpdateLevelBasedBundles(APlayerController* PlayerController);
     
+    // Update level-based bundles from a viewer's current location and predicted path, requesting bundles early enough to stream before arrival
+    UFUNCTION(BlueprintCallable, Category = "Level Streaming")
+    void UpdateLevelBasedBundlesForViewer(const FBundleStreamingViewer& Viewer);
+    
+    // Update level-based bundles for all viewers in one pass; a bundle stays loaded while any viewer needs it, and an empty list changes nothing
+    UFUNCTION(BlueprintCallable, Category = "Level Streaming")
+    void UpdateLevelBasedBundlesForViewers(const TArray<FBundleStreamingViewer>& Viewers);
+    
+    // Estimate the seconds a bundle needs to stream in, including BundleStreamingLeadSeconds
+    UFUNCTION(BlueprintCallable, Category = "Level Streaming")
+    float GetBundleStreamingLeadTime(FName BundleId) const;
+    
     // Get distance to a specific level from a location
     UFUNCTION(BlueprintCallable, Category = "Level Streaming")
     float GetDistanceToLevel(FName LevelName, const FVector& FromLocation) const;
@@ -404,6 +1100,28 @@ public:
     // Apply all pending hotswaps
     UFUNCTION(BlueprintCallable, Category = "Asset Hotswapping")
     int32 ApplyPendingHotswaps();
+    
+    // PRESENTATION QUALITY VARIANTS
+    
+    // Get the mesh to present for an item or character asset, honoring LOD distance and the presentation budget
+    UFUNCTION(BlueprintCallable, Category = "Presentation Quality")
+    UObject* ResolvePresentationMesh(UCustomAssetBase* Asset, float Distance);
+    
+    // Set the memory budget for presentation meshes in megabytes (0 disables budget-driven variant selection)
+    UFUNCTION(BlueprintCallable, Category = "Presentation Quality")
+    void SetPresentationBudget(int32 BudgetMB);
+    
+    // Get the memory used by presentation meshes held by the manager, in bytes
+    UFUNCTION(BlueprintCallable, Category = "Presentation Quality")
+    int64 GetPresentationMemoryUsage() const;
+    
+    // Whether low detail variants are currently served because of memory pressure
+    UFUNCTION(BlueprintCallable, Category = "Presentation Quality")
+    bool IsPresentationLowDetail() const;
+    
+    // Broadcast when presentation quality changes, so callers can resolve their meshes again
+    UPROPERTY(BlueprintAssignable, Category = "Presentation Quality")
+    FOnPresentationQualityChanged OnPresentationQualityChanged;
 
 private:
     // Map of asset IDs to loaded assets
@@ -414,6 +1132,48 @@ private:
     UPROPERTY()
     TMap<FName, UCustomAssetBundle*> Bundles;
 
+    // Build the package path a bundle is saved to
+    static FString MakeBundlePackagePath(const FName& BundleId, const FString& PackagePath);
+
+    // Validate a bundle and set up the object in its package, without writing it
+    bool PrepareBundleSave(UCustomAssetBundle* Bundle, const FString& PackagePath, FPendingBundleSave& OutSave, bool& bOutUnchanged);
+
+    // Write a prepared bundle package and register the saved bundle in place of the original instance
+    bool WriteBundlePackage(const FPendingBundleSave& PendingSave, bool bAsync);
+
+    // Prepare every registered bundle that changed; returns the number that failed
+    int32 PrepareAllBundleSaves(const FString& SavePath, TArray<FPendingBundleSave>& OutSaves, int32& OutUnchangedCount);
+
+    // Prepare and write queued bundles until the time budget runs out
+    void ProcessPendingBundleSaves(float TimeBudgetMs);
+
+    // Flush the file writes and report the end of an asynchronous SaveAllBundles
+    void FinishBundleSaves(bool bCancelled);
+
+    // Milliseconds per tick spent writing bundle packages during an asynchronous SaveAllBundles
+    UPROPERTY(Config)
+    float BundleSaveTimeBudgetMs = 8.0f;
+
+    // Whether an asynchronous SaveAllBundles is running
+    bool bBundleSaveInProgress = false;
+
+    // Bundles queued by SaveAllBundlesAsync, the next one to save and the path they are saved to
+    TArray<FName> PendingBundleSaveIds;
+    int32 NextPendingBundleSave = 0;
+    FString PendingBundleSavePath;
+
+    // Progress of the current or last asynchronous SaveAllBundles
+    FBundleSaveProgress BundleSaveProgress;
+
+    // Reverse index of asset IDs to the IDs of the registered bundles containing them
+    TMap<FName, TArray<FName>> AssetBundleIndex;
+
+    // Add a registered bundle's assets to the reverse index
+    void IndexBundleAssets(UCustomAssetBundle* Bundle);
+
+    // Remove a bundle's assets from the reverse index
+    void UnindexBundleAssets(const UCustomAssetBundle* Bundle);
+
     // Default loading strategy
     EAssetLoadingStrategy DefaultLoadingStrategy;
 
@@ -427,6 +1187,78 @@ private:
     UPROPERTY()
     UCustomAssetMemoryTracker* MemoryTracker;
 
+    // Residency auditor
+    UPROPERTY()
+    UCustomAssetResidencyAuditor* ResidencyAuditor;
+
+    // Co-access recorder
+    UPROPERTY()
+    UCustomAssetCoAccessRecorder* CoAccessRecorder;
+
+    // Whether direct asset requests are fed to the co-access recorder
+    UPROPERTY(Config)
+    bool bRecordCoAccess = false;
+
+    // Seconds within which two asset requests count as co-access
+    UPROPERTY(Config)
+    float CoAccessWindowSeconds = 10.0f;
+
+    // Level transition model
+    UPROPERTY()
+    UCustomAssetLevelTransitionModel* LevelTransitionModel;
+
+    // Whether level transitions are learned and the bundles of likely next levels prefetched
+    UPROPERTY(Config)
+    bool bPredictLevelTransitions = false;
+
+    // Keep what this session learned for the next one, called before the engine shuts down
+    void HandlePreExit();
+
+    // Maximum number of next levels whose bundles are prefetched
+    UPROPERTY(Config)
+    int32 MaxPredictedLevels = 2;
+
+    // Minimum transition probability for a level to be prefetched
+    UPROPERTY(Config)
+    float LevelTransitionMinProbability = 0.25f;
+
+    // Resident megabytes predicted bundles may take per level load
+    UPROPERTY(Config)
+    int32 PredictivePrefetchMemoryBudgetMB = 128;
+
+    // Disk megabytes predicted bundles may read per level load
+    UPROPERTY(Config)
+    int32 PredictivePrefetchIOBudgetMB = 64;
+
+    // Latest level reported through OnLevelLoaded and when it loaded
+    FName LastLoadedLevelName;
+    double LastLevelLoadTime = 0.0;
+
+    // Levels predicted to follow LastLoadedLevelName, scored when the next level loads
+    TArray<FName> PredictedNextLevels;
+
+    // Bundles of the predicted levels not requested yet, most likely level first
+    TArray<FName> PendingPredictiveBundles;
+
+    // Budget spent on the current predictions
+    int64 PredictivePrefetchResidentBytes = 0;
+    int64 PredictivePrefetchDiskBytes = 0;
+
+    // Learn the transition into a level and score the previous prediction
+    void RecordLevelTransition(FName LevelName);
+
+    // Replace the previous prediction with the bundles of the levels likely to follow a level
+    void PredictNextLevels(FName LevelName);
+
+    // Request the next predicted bundle while no other load is using the disk and the budgets allow
+    void ProcessPredictivePrefetches();
+
+    // Owner ID used for bundles held for predicted levels
+    static FName GetPredictionBundleOwner();
+
+    // Name of the persistent level of the running game world (None outside of a game)
+    FName GetActiveLevelName() const;
+
     // Map to store pending callbacks for streaming assets
     TMap<FName, FOnAssetLoaded> PendingCallbacks;
 
@@ -445,6 +1277,208 @@ private:
     // Helper method to calculate memory used by dependencies recursively
     int64 CalculateDependenciesMemoryUsage(UCustomAssetBase* Asset, TSet<FName>& ProcessedAssets) const;
 
+    // Registered memory budget pools
+    UPROPERTY()
+    TArray<FAssetBudgetPool> BudgetPools;
+    
+    // Map of asset IDs to the pool they are charged to (resolved on registration and when a pool's bundle changes)
+    TMap<FName, FName> AssetBudgetPoolAssignments;
+    
+    // Resolve the most specific pool an asset belongs to
+    FName ResolveBudgetPool(const UCustomAssetBase* Asset) const;
+    
+    // Check whether an asset matches a pool's class, tag and bundle selectors
+    bool DoesAssetMatchBudgetPool(const UCustomAssetBase* Asset, const FAssetBudgetPool& Pool) const;
+    
+    // Get the nesting depth of a pool (0 for top-level pools)
+    int32 GetBudgetPoolDepth(FName PoolId) const;
+    
+    // Check whether a pool is the given pool or nested inside it
+    bool IsBudgetPoolWithin(FName PoolId, FName AncestorPoolId) const;
+    
+    // Check whether a pool or one of its parents enforces its own budget, keeping its assets out of global eviction
+    bool IsBudgetPoolManaged(FName PoolId) const;
+    
+    // Evict assets from pools that are over their limit, deepest pools first
+    void EnforceBudgetPools();
+    
+    // Get loaded assets ordered for eviction by a policy, optionally restricted to a pool
+    TArray<FName> GetEvictionCandidates(EMemoryManagementPolicy Policy, FName PoolId = NAME_None) const;
+    
+    // Unload candidates in order until the requested number of bytes has been freed
+    int64 UnloadCandidatesToFreeMemory(const TArray<FName>& Candidates, int64 MemoryToFree);
+
+    // Periodic update driven by the core ticker
+    bool Tick(float DeltaTime);
+    
+    // Handle of the registered core ticker
+    FTSTicker::FDelegateHandle TickHandle;
+    
+    // Phases of the incremental reachability collector
+    enum class EReachabilityPhase : uint8
+    {
+        Idle,
+        Mark,
+        Sweep
+    };
+    
+    // Assets loaded directly by callers (as opposed to dependencies or bundle members)
+    TSet<FName> DirectLoadRoots;
+    
+    // Assets pinned by callers
+    TSet<FName> PinnedAssets;
+    
+    // Prefetched assets and the time until which they are treated as roots
+    TMap<FName, double> PrefetchedAssets;
+    
+    // Number of internal loads in flight (dependency, bundle and prefetch loads are not direct roots)
+    int32 InternalLoadDepth = 0;
+    
+    // Whether the incremental reachability collector runs from the tick (loaded assets nothing roots are unloaded)
+    UPROPERTY(Config)
+    bool bReachabilityCollectionEnabled = false;
+    
+    // Whether roots changed since the last completed reachability pass
+    bool bReachabilityDirty = false;
+    
+    // Number of assets processed by the collector per tick
+    int32 ReachabilityStepBudget = 64;
+    
+    // Seconds a prefetched asset is kept as a root before it becomes collectable
+    float PrefetchRootGraceSeconds = 30.0f;
+    
+    // Whether a cold direct request prefetches the rest of the asset's bundles
+    UPROPERTY(Config)
+    bool bBundleAffinityPrefetch = false;
+    
+    // Maximum number of bundle siblings prefetched per cold request
+    UPROPERTY(Config)
+    int32 BundleAffinityPrefetchMaxAssets = 32;
+    
+    // Async load priority of bundle sibling prefetches, below the default so the requested asset goes first
+    UPROPERTY(Config)
+    int32 BundleAffinityPrefetchPriority = -10;
+    
+    // Stream the not yet loaded siblings of an asset's bundles in one low priority request
+    void ScheduleBundleAffinityPrefetch(const FName& AssetId);
+    
+    // Register the siblings streamed by a bundle affinity prefetch
+    void OnBundleAffinityPrefetchLoaded(TArray<FName> AssetIds);
+    
+    // Current phase of the collector
+    EReachabilityPhase ReachabilityPhase = EReachabilityPhase::Idle;
+    
+    // Assets still to be traversed in the mark phase
+    TArray<FName> ReachabilityMarkStack;
+    
+    // Assets found reachable in the current pass
+    TSet<FName> ReachableAssets;
+    
+    // Loaded assets still to be checked in the sweep phase
+    TArray<FName> ReachabilitySweepQueue;
+    
+    // Assets requeued because a loaded dependent blocked them, with the sweep's collected count at that time
+    TMap<FName, int32> ReachabilityRequeuedAt;
+    
+    // Number of assets unloaded by the current sweep
+    int32 ReachabilitySweepCollected = 0;
+    
+    // Seconds between memory timeline samples
+    float TimelineSampleInterval = 1.0f;
+    
+    // Time accumulated since the last memory timeline sample
+    float TimelineSampleAccumulator = 0.0f;
+    
+    // Whether development builds audit residency periodically after garbage collections (never in shipping builds)
+    UPROPERTY(Config)
+    bool bPeriodicResidencyAudits = false;
+    
+    // Minimum seconds between periodic residency audits
+    UPROPERTY(Config)
+    float ResidencyAuditInterval = 60.0f;
+    
+    // Time accumulated since the last periodic residency audit
+    float ResidencyAuditAccumulator = 0.0f;
+    
+    // Make startup bundles that are kept in memory (bPreloadAtStartup && bKeepInMemory) permanent: rooted and clustered even without bCreateGCCluster
+    UPROPERTY(Config)
+    bool bPlacePermanentBundlesInDisregardPool = false;
+    
+    // Objects made permanent by PreloadBundles
+    UPROPERTY()
+    FDisregardForGCReport DisregardForGCReport;
+    
+    // Assets of permanent bundles, which are never unloaded
+    TSet<FName> PermanentAssets;
+    
+    // Load permanent bundles, root them and cluster their members, returns the bundles that were loaded
+    TArray<UCustomAssetBundle*> PreloadPermanentBundles(const TArray<UCustomAssetBundle*>& Bundles);
+    
+    // Runtime data derived from loaded bundles, rebuilt when their membership changes and released on UnloadBundle
+    TMap<FName, TUniquePtr<FBundleRuntimeData>> BundleRuntimeData;
+    
+    // Build the runtime data of a freshly loaded bundle
+    void BuildBundleRuntimeData(UCustomAssetBundle* Bundle);
+    
+    // Form the GC cluster of a freshly loaded bundle if it opted in
+    void CreateBundleGCCluster(UCustomAssetBundle* Bundle);
+    
+    // Register the assets of a loaded bundle in manifest order
+    void RegisterLoadedBundleAssets(UCustomAssetBundle* Bundle);
+    
+    // Resident bytes an asset is expected to take, used for bundle manifests
+    int64 EstimateManifestAssetBytes(const FName& AssetId, UCustomAssetBase* Asset) const;
+    
+    // Bytes the bundle's manifest closure would add on top of what is already loaded
+    int64 GetBundleLoadCost(const UCustomAssetBundle* Bundle) const;
+    
+    // Defer bundle loads that would exceed MemoryThreshold instead of refusing them (the check is skipped under KeepAll)
+    UPROPERTY(Config)
+    bool bDeferOverBudgetBundles = true;
+    
+    // Bundle loads waiting for memory to become available, in request order
+    TArray<TPair<FName, EAssetLoadingStrategy>> DeferredBundleLoads;
+    
+    // Start deferred bundle loads that now fit in the memory budget
+    void RetryDeferredBundleLoads();
+    
+    // Drop a deferred or in-flight load of a bundle
+    void CancelBundleLoad(const FName& BundleId);
+    
+    // Stop a bundle from rooting its assets (pending load, GC cluster, runtime data, owners) without unloading them
+    void MarkBundleUnloaded(UCustomAssetBundle* Bundle);
+    
+    // Add a bundle's manifest closure to OutAssetIds, refreshing a stale manifest first
+    void GatherBundleClosure(UCustomAssetBundle* Bundle, TSet<FName>& OutAssetIds);
+    
+    // Game-time seconds an unowned bundle stays loaded, absorbs release/acquire thrash
+    UPROPERTY(Config)
+    float BundleLingerSeconds = 5.0f;
+    
+    // Owners of acquired bundles, by bundle ID
+    TMap<FName, FBundleReferenceState> BundleReferences;
+    
+    // Unload bundles whose linger time has run out
+    void ProcessLingeringBundles();
+    
+    // Bundle loads in flight, by bundle ID
+    TMap<FName, FBundleLoadState> ActiveBundleLoads;
+    
+    // Start tracking the progress of a bundle load
+    void BeginBundleLoadProgress(UCustomAssetBundle* Bundle);
+    
+    // Pick up assets that became usable and broadcast progress, bFinished completes the load
+    void UpdateBundleLoadProgress(const FName& BundleId, bool bFinished = false);
+    
+    // Called by the streamable manager as packages of a bundle arrive
+    void OnBundleLoadUpdated(TSharedRef<FStreamableHandle> Handle, FName BundleId);
+    
+    // Collect all root asset IDs
+    void GatherReachabilityRoots(TSet<FName>& OutRoots) const;
+    
+    // Advance the incremental collector by up to Budget assets, returns the number of assets collected
+    int32 StepReachabilityCollection(int32 Budget);
+
     // Map of asset IDs to their world locations (for prefetching)
     TMap<FName, FVector> AssetLocations;
     
@@ -461,6 +1495,79 @@ private:
     // Set of currently loaded levels
     TSet<FName> LoadedLevels;
     
+    // List of bundle-region associations for World Partition streaming
+    UPROPERTY()
+    TArray<FBundleStreamingRegionAssociation> StreamingRegionAssociations;
+    
+    // (bundle, region) associations whose region currently holds the bundle
+    TSet<TPair<FName, FName>> ActiveStreamingRegionBundles;
+    
+    // List of bundle-Data Layer associations
+    UPROPERTY()
+    TArray<FBundleDataLayerAssociation> DataLayerBundleAssociations;
+    
+    // Set of currently active Data Layers
+    TSet<FName> ActiveDataLayers;
+    
+    // Transition state per Data Layer, completed with current numbers by GetDataLayerMemoryReport
+    TMap<FName, FDataLayerBundleMemoryReport> DataLayerMemoryReports;
+    
+    // Sum the loaded bytes of a Data Layer's bundle assets, counting shared assets once
+    int64 GetDataLayerBundleLoadedBytes(FName DataLayerName, TArray<FName>* OutBundleIds = nullptr) const;
+    
+    // Seconds added to every bundle's estimated streaming time when deciding how far ahead to request it
+    UPROPERTY(Config)
+    float BundleStreamingLeadSeconds = 1.0f;
+    
+    // Disk throughput assumed when estimating how long a bundle takes to stream
+    UPROPERTY(Config)
+    float EstimatedStreamingMBPerSecond = 50.0f;
+    
+    // Multiple of PreloadDistance every viewer must be beyond before a level releases its bundle
+    UPROPERTY(Config)
+    float BundleReleaseDistanceFactor = 2.0f;
+    
+    // Game-time seconds every viewer must stay beyond the release distance before a level releases its bundle
+    UPROPERTY(Config)
+    float BundleReleaseHysteresisSeconds = 2.0f;
+    
+    // Time since which all viewers have been beyond the release distance, per (bundle, level) association
+    TMap<TPair<FName, FName>, double> LevelBundleOutOfRangeSince;
+    
+    // Get the bounds used for distance checks against a level (false if the level has no known location)
+    bool GetLevelStreamingBounds(FName LevelName, FBox& OutBounds) const;
+    
+    // Bounds per streaming level, computed when the level is added to the world and kept current as actors come and go
+    mutable TMap<FName, FBox> LevelBoundsCache;
+    
+    // World whose levels are cached and whose actors are tracked
+    TWeakObjectPtr<UWorld> LevelBoundsWorld;
+    
+    // Actor handlers registered on LevelBoundsWorld
+    FDelegateHandle ActorSpawnedHandle;
+    FDelegateHandle ActorDestroyedHandle;
+    
+    // Track actors of a world for the bounds cache, dropping the cache of the previous world
+    void TrackLevelBounds(UWorld* World);
+    
+    // Level and actor notifications that keep LevelBoundsCache current
+    void HandleLevelAddedToWorld(ULevel* Level, UWorld* World);
+    void HandleLevelRemovedFromWorld(ULevel* Level, UWorld* World);
+    void HandleActorSpawned(AActor* Actor);
+    void HandleActorDestroyed(AActor* Actor);
+    
+    // Get the name level associations use for a level package
+    static FName GetLevelStreamingName(const FString& PackageName);
+    
+    // Union the bounds of all actors in a level (invalid if it has none)
+    static FBox ComputeLevelActorBounds(const ULevel* Level);
+    
+    // Get the game or PIE world the manager serves
+    UWorld* GetGameWorld() const;
+    
+    // Get the game time that bundle lingering and release hysteresis run on, so neither advances while paused (0 without a game world)
+    double GetBundleReleaseTime() const;
+    
     // Map of pending hotswaps (asset ID to new asset version)
     UPROPERTY()
     TMap<FName, UCustomAssetBase*> PendingHotswaps;
@@ -476,4 +1583,40 @@ private:
     
     // Notify all hotswap listeners about an asset change
     void NotifyHotswapListeners(const FName& AssetId);
+    
+    // Memory budget for presentation meshes in megabytes (0 to disable)
+    UPROPERTY(Config)
+    int32 PresentationBudgetMB = 0;
+    
+    // Fraction of the budget the projected high detail usage must fall under before upgrading again
+    UPROPERTY(Config)
+    float PresentationRecoveryFraction = 0.75f;
+    
+    // Seconds a variant is kept resident after it was last requested
+    UPROPERTY(Config)
+    float PresentationVariantIdleSeconds = 10.0f;
+    
+    // Whether low detail variants are served because of memory pressure
+    bool bPresentationLowDetail = false;
+    
+    // Variant streaming state per asset ID
+    TMap<FName, FPresentationVariantState> PresentationVariants;
+    
+    // Start streaming a variant and keep it resident through a handle
+    void RequestPresentationVariant(const FName& AssetId, bool bLowDetail);
+    
+    // Called when a streamed variant finishes loading
+    void OnPresentationVariantLoaded(FName AssetId, bool bLowDetail);
+    
+    // Release the handles of an asset's variants and forget its state
+    void ReleasePresentationVariants(const FName& AssetId);
+    
+    // Release variants nothing requested for PresentationVariantIdleSeconds, such as the one a distance switch moved away from
+    void ReleaseIdlePresentationVariants();
+    
+    // Switch between high and low detail when the budget is exceeded or pressure has cleared
+    void UpdatePresentationQuality();
+    
+    // Apply a presentation quality switch
+    void SetPresentationLowDetail(bool bLowDetail);
 }; 
\ No newline at end of file
@@ -36,6 +36,10 @@ struct CUSTOMASSETSTEST_API FAssetMemoryStats
     UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Memory")
     bool bIsLoaded;
 
+    // Number of times the asset was evicted to free memory
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Memory")
+    int32 EvictionCount;
+
     // Default constructor
     FAssetMemoryStats()
         : AssetId(NAME_None)
@@ -44,6 +48,89 @@ struct CUSTOMASSETSTEST_API FAssetMemoryStats
         , LastAccessTime(FDateTime::Now())
         , AccessCount(0)
         , bIsLoaded(false)
+        , EvictionCount(0)
+    {
+    }
+};
+
+/**
+ * Struct to represent one periodic sample of the memory timeline
+ */
+USTRUCT(BlueprintType)
+struct CUSTOMASSETSTEST_API FAssetMemorySample
+{
+    GENERATED_BODY()
+
+    // Time the sample was taken
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Memory")
+    FDateTime Timestamp;
+
+    // Memory used by loaded assets in bytes
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Memory")
+    int64 LoadedBytes;
+
+    // Number of loaded assets
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Memory")
+    int32 LoadedCount;
+
+    // Number of evictions since the previous sample
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Memory")
+    int32 Evictions;
+
+    // Memory used by prefetched assets in bytes
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Memory")
+    int64 PrefetchBytes;
+
+    // Memory used by pinned assets in bytes
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Memory")
+    int64 PinnedBytes;
+
+    // Default constructor
+    FAssetMemorySample()
+        : Timestamp(FDateTime::Now())
+        , LoadedBytes(0)
+        , LoadedCount(0)
+        , Evictions(0)
+        , PrefetchBytes(0)
+        , PinnedBytes(0)
+    {
+    }
+};
+
+/**
+ * Struct to represent a global high-water mark and the load request that triggered it
+ */
+USTRUCT(BlueprintType)
+struct CUSTOMASSETSTEST_API FAssetMemoryHighWaterMark
+{
+    GENERATED_BODY()
+
+    // Value of the high-water mark (bytes or asset count)
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Memory")
+    int64 Value;
+
+    // ID of the asset whose load request triggered the mark
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Memory")
+    FName AssetId;
+
+    // ID of the bundle being loaded when the mark was reached (None if not a bundle load)
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Memory")
+    FName BundleId;
+
+    // Call site of the load request
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Memory")
+    FString CallSite;
+
+    // Time the mark was reached
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Memory")
+    FDateTime Timestamp;
+
+    // Default constructor
+    FAssetMemoryHighWaterMark()
+        : Value(0)
+        , AssetId(NAME_None)
+        , BundleId(NAME_None)
+        , Timestamp(FDateTime::Now())
     {
     }
 };
@@ -82,6 +169,10 @@ public:
     UFUNCTION(BlueprintCallable, Category = "Memory")
     FAssetMemoryStats GetAssetMemoryStats(const FName& AssetId) const;
 
+    // Check if the asset has ever been tracked
+    UFUNCTION(BlueprintCallable, Category = "Memory")
+    bool IsAssetTracked(const FName& AssetId) const;
+
     // Get total memory usage for all tracked assets
     UFUNCTION(BlueprintCallable, Category = "Memory")
     int64 GetTotalMemoryUsage() const;
@@ -106,10 +197,105 @@ public:
     UFUNCTION(BlueprintCallable, Category = "Memory")
     bool ExportMemoryStatsToCSV(const FString& FilePath) const;
 
+    // MEMORY TIMELINE
+
+    // Set the number of samples kept in the timeline ring buffer (clears the timeline)
+    UFUNCTION(BlueprintCallable, Category = "Memory|Timeline")
+    void SetTimelineCapacity(int32 Capacity);
+
+    // Record a timeline sample from the current tracker state
+    UFUNCTION(BlueprintCallable, Category = "Memory|Timeline")
+    void RecordTimelineSample(int64 PrefetchBytes, int64 PinnedBytes);
+
+    // Record that an asset was evicted to free memory
+    UFUNCTION(BlueprintCallable, Category = "Memory|Timeline")
+    void RecordEviction(const FName& AssetId);
+
+    // Get the timeline samples, oldest first
+    UFUNCTION(BlueprintCallable, Category = "Memory|Timeline")
+    TArray<FAssetMemorySample> GetTimelineSamples() const;
+
+    // Get the high-water mark of loaded bytes
+    UFUNCTION(BlueprintCallable, Category = "Memory|Timeline")
+    FAssetMemoryHighWaterMark GetLoadedBytesHighWaterMark() const;
+
+    // Get the high-water mark of the loaded asset count
+    UFUNCTION(BlueprintCallable, Category = "Memory|Timeline")
+    FAssetMemoryHighWaterMark GetLoadedCountHighWaterMark() const;
+
+    // Set the load request that subsequent tracked assets are attributed to (only the outermost request is kept)
+    bool PushLoadContext(const FName& AssetId, const FName& BundleId, const TCHAR* CallSite);
+
+    // Clear the current load request attribution
+    void PopLoadContext();
+
+    // Export the timeline and high-water marks to a compact binary file
+    UFUNCTION(BlueprintCallable, Category = "Memory|Timeline")
+    bool ExportTimelineToBinary(const FString& FilePath) const;
+
+    // Export the timeline and high-water marks to CSV
+    UFUNCTION(BlueprintCallable, Category = "Memory|Timeline")
+    bool ExportTimelineToCSV(const FString& FilePath) const;
+
 private:
     // Map of asset IDs to memory stats
     TMap<FName, FAssetMemoryStats> MemoryStats;
 
+    // Memory used by loaded assets, maintained incrementally
+    int64 LoadedMemoryUsage = 0;
+
+    // Number of loaded assets, maintained incrementally
+    int32 LoadedAssetCount = 0;
+
+    // Ring buffer of timeline samples
+    TArray<FAssetMemorySample> TimelineSamples;
+
+    // Index the next sample is written to once the ring buffer is full
+    int32 TimelineHead = 0;
+
+    // Maximum number of timeline samples
+    int32 TimelineCapacity = 3600;
+
+    // Evictions recorded since the previous sample
+    int32 EvictionsSinceLastSample = 0;
+
+    // High-water marks with the load requests that reached them
+    FAssetMemoryHighWaterMark LoadedBytesHighWaterMark;
+    FAssetMemoryHighWaterMark LoadedCountHighWaterMark;
+
+    // Load request currently being attributed
+    FName ContextAssetId;
+    FName ContextBundleId;
+    FString ContextCallSite;
+    bool bHasLoadContext = false;
+
+    // Update the high-water marks after the loaded totals changed for the given asset
+    void UpdateHighWaterMarks(const FName& AssetId);
+
     // Singleton instance
     static UCustomAssetMemoryTracker* Instance;
-}; 
\ No newline at end of file
+};
+
+/**
+ * Scope that attributes asset loads to a load request for high-water mark tracking
+ */
+struct CUSTOMASSETSTEST_API FScopedAssetLoadContext
+{
+    FScopedAssetLoadContext(UCustomAssetMemoryTracker* InTracker, const FName& AssetId, const FName& BundleId, const TCHAR* CallSite)
+        : Tracker(InTracker)
+        , bPushed(InTracker && InTracker->PushLoadContext(AssetId, BundleId, CallSite))
+    {
+    }
+
+    ~FScopedAssetLoadContext()
+    {
+        if (bPushed)
+        {
+            Tracker->PopLoadContext();
+        }
+    }
+
+private:
+    UCustomAssetMemoryTracker* Tracker;
+    bool bPushed;
+};
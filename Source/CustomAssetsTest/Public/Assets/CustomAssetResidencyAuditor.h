@@ -0,0 +1,156 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/NoExportTypes.h"
+#include "CustomAssetResidencyAuditor.generated.h"
+
+class UCustomAssetManager;
+
+/**
+ * Kind of mismatch between the manager's loaded state and the objects actually in memory
+ */
+UENUM(BlueprintType)
+enum class EAssetResidencyIssueType : uint8
+{
+    // Unloaded through the manager but still resident (leak)
+    ResidentAfterUnload,
+    // Resident but never loaded through the manager
+    ResidentUntracked,
+    // Registered as loaded but no longer resident
+    LoadedNotResident,
+    // Unloaded through the manager but kept by RF_Standalone, which the editor sets on every loaded asset (not a leak)
+    ResidentStandalone
+};
+
+/**
+ * One asset whose residency does not match the manager's loaded state
+ */
+USTRUCT(BlueprintType)
+struct CUSTOMASSETSTEST_API FAssetResidencyIssue
+{
+    GENERATED_BODY()
+
+    // Asset ID
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Residency")
+    FName AssetId;
+
+    // Kind of mismatch
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Residency")
+    EAssetResidencyIssueType IssueType;
+
+    // Full path of the resident object (empty if not resident)
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Residency")
+    FString ObjectPath;
+
+    // Shortest chain of referencers keeping the object resident, one entry per line
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Residency")
+    TArray<FString> ReferencerChain;
+
+    // Memory retained by the object and its subobjects in bytes
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Residency")
+    int64 RetainedBytes;
+
+    // Default constructor
+    FAssetResidencyIssue()
+        : AssetId(NAME_None)
+        , IssueType(EAssetResidencyIssueType::ResidentAfterUnload)
+        , RetainedBytes(0)
+    {
+    }
+};
+
+/**
+ * Result of a residency audit
+ */
+USTRUCT(BlueprintType)
+struct CUSTOMASSETSTEST_API FAssetResidencyReport
+{
+    GENERATED_BODY()
+
+    // Time the audit was run
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Residency")
+    FDateTime Timestamp;
+
+    // Number of custom asset objects found in memory
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Residency")
+    int32 ResidentCount;
+
+    // Number of assets registered as loaded by the manager
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Residency")
+    int32 LoadedCount;
+
+    // Mismatches found
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Residency")
+    TArray<FAssetResidencyIssue> Issues;
+
+    // Total memory retained by assets that are resident after being unloaded
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Residency")
+    int64 LeakedBytes;
+
+    // Default constructor
+    FAssetResidencyReport()
+        : Timestamp(FDateTime::Now())
+        , ResidentCount(0)
+        , LoadedCount(0)
+        , LeakedBytes(0)
+    {
+    }
+
+    // Number of issues of the given type
+    int32 CountIssues(EAssetResidencyIssueType IssueType) const;
+};
+
+/**
+ * Compares the manager's loaded assets with the custom asset objects actually resident in memory
+ */
+UCLASS(BlueprintType)
+class CUSTOMASSETSTEST_API UCustomAssetResidencyAuditor : public UObject
+{
+    GENERATED_BODY()
+
+public:
+    UCustomAssetResidencyAuditor();
+
+    //~ Begin UObject Interface
+    virtual void BeginDestroy() override;
+    //~ End UObject Interface
+
+    // Walk the UObject array and compare it with the manager's loaded assets
+    UFUNCTION(BlueprintCallable, Category = "Residency")
+    FAssetResidencyReport RunAudit(const UCustomAssetManager* Manager, bool bFindReferencerChains = true);
+
+    // Get the report of the last audit
+    UFUNCTION(BlueprintCallable, Category = "Residency")
+    FAssetResidencyReport GetLastReport() const;
+
+    // Whether a garbage collection ran since the last audit (audits are only exact right after one)
+    bool HasCollectedGarbageSinceLastAudit() const { return bGarbageCollectedSinceAudit; }
+
+    // Note that the manager unregistered an asset, so it is not reported until a collection has had a chance to free it
+    void NotifyAssetUnregistered(const FName& AssetId);
+
+    // Log a report
+    static void LogReport(const FAssetResidencyReport& Report);
+
+    // Maximum number of issues to search referencer chains for per audit (the search walks the whole object graph)
+    int32 MaxReferencerChainSearches = 16;
+
+private:
+    // Called after every garbage collection
+    void OnPostGarbageCollect();
+
+    // Estimate the memory retained by an object and its subobjects
+    static int64 EstimateRetainedBytes(UObject* Object);
+
+    // Last audit report
+    FAssetResidencyReport LastReport;
+
+    // Whether a garbage collection ran since the last audit
+    bool bGarbageCollectedSinceAudit = false;
+
+    // Assets unregistered since the last garbage collection
+    TSet<FName> UnregisteredSinceGarbageCollect;
+
+    // Handle of the post-GC delegate
+    FDelegateHandle PostGarbageCollectHandle;
+};
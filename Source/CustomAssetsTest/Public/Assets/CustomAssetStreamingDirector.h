@@ -0,0 +1,92 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Assets/CustomAssetManager.h"
+#include "WorldPartition/DataLayer/DataLayerType.h"
+#include "CustomAssetStreamingDirector.generated.h"
+
+class UDataLayerInstance;
+class UDataLayerManager;
+
+/**
+ * Drives level-based bundle streaming from the world tick
+ *
+ * Predicts where every player is heading from its velocity and navigation path and hands the
+ * predictions to the custom asset manager in one batch, so bundles are requested before any
+ * player arrives and released only once no player needs them. Bundles bound to World Partition
+ * regions are updated on the same interval from the state of the streaming cells, and bundles bound
+ * to Data Layers follow the runtime state the world's Data Layer manager reports.
+ */
+UCLASS(config = Game)
+class CUSTOMASSETSTEST_API UCustomAssetStreamingDirector : public UTickableWorldSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    //~ Begin UWorldSubsystem Interface
+    virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+    virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+    virtual void Deinitialize() override;
+    //~ End UWorldSubsystem Interface
+
+    //~ Begin FTickableGameObject Interface
+    virtual void Tick(float DeltaTime) override;
+    virtual TStatId GetStatId() const override;
+    //~ End FTickableGameObject Interface
+
+    // Enable or disable the director
+    UFUNCTION(BlueprintCallable, Category = "Level Streaming")
+    void SetDirectorEnabled(bool bEnabled);
+
+    // Check if the director is updating bundles
+    UFUNCTION(BlueprintCallable, Category = "Level Streaming")
+    bool IsDirectorEnabled() const { return bDirectorEnabled; }
+
+    // Evaluate the viewers and update bundles right away
+    UFUNCTION(BlueprintCallable, Category = "Level Streaming")
+    void UpdateNow();
+
+    // Predict the path of a pawn over the prediction horizon
+    UFUNCTION(BlueprintCallable, Category = "Level Streaming")
+    FBundleStreamingViewer PredictViewer(APawn* Pawn) const;
+
+protected:
+    // Whether the director updates bundles
+    UPROPERTY(Config)
+    bool bDirectorEnabled = true;
+
+    // Seconds between updates
+    UPROPERTY(Config)
+    float UpdateInterval = 0.25f;
+
+    // Seconds ahead the player's position is predicted
+    UPROPERTY(Config)
+    float PredictionHorizonSeconds = 4.0f;
+
+    // Seconds between predicted positions
+    UPROPERTY(Config)
+    float PredictionStepSeconds = 0.5f;
+
+    // Whether to follow the controller's navigation path instead of extrapolating velocity while it moves along one
+    UPROPERTY(Config)
+    bool bFollowNavigationPath = true;
+
+    // Whether a Data Layer holds its bundles while merely loaded, so they arrive before the layer is activated
+    UPROPERTY(Config)
+    bool bHoldDataLayerBundlesWhileLoaded = true;
+
+private:
+    // Forward a Data Layer state change to the custom asset manager
+    UFUNCTION()
+    void HandleDataLayerRuntimeStateChanged(const UDataLayerInstance* DataLayer, EDataLayerRuntimeState State);
+
+    // Data Layer manager whose state changes are forwarded
+    TWeakObjectPtr<UDataLayerManager> BoundDataLayerManager;
+
+    // Data Layers this world reported as holding their bundles, released when the world goes away
+    TSet<FName> HeldDataLayers;
+
+    // Time accumulated since the last update
+    float TimeSinceUpdate = 0.0f;
+};
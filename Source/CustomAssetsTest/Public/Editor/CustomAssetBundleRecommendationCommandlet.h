@@ -0,0 +1,26 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "CustomAssetBundleRecommendationCommandlet.generated.h"
+
+/**
+ * Clusters recorded co-access traces into recommended asset bundles
+ *
+ * Usage: -run=CustomAssetBundleRecommendation [-Trace=a.json,b.json] [-Output=path.json]
+ *        [-MinAffinity=0.5] [-MinPairCount=3] [-MaxBundleSize=64] [-Apply] [-ApplyDiff]
+ *
+ * -Apply saves new recommendations as bundle assets, -ApplyDiff also rewrites the existing bundles they match.
+ */
+UCLASS()
+class CUSTOMASSETSTEST_API UCustomAssetBundleRecommendationCommandlet : public UCommandlet
+{
+    GENERATED_BODY()
+
+public:
+    UCustomAssetBundleRecommendationCommandlet();
+
+    //~ Begin UCommandlet Interface
+    virtual int32 Main(const FString& Params) override;
+    //~ End UCommandlet Interface
+};